@@ -27,7 +27,12 @@ ze_result_t zeCommandListCreateImmediate(ze_context_handle_t hContext,
                                          ze_device_handle_t hDevice,
                                          const ze_command_queue_desc_t *altdesc,
                                          ze_command_list_handle_t *phCommandList) {
-    return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    if (hContext == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+    return L0::Context::fromHandle(hContext)->createCommandListImmediate(hDevice,
+                                                                         altdesc,
+                                                                         phCommandList);
 }
 
 ze_result_t zeCommandListDestroy(ze_command_list_handle_t hCommandList) {
@@ -71,7 +76,17 @@ ze_result_t zeCommandListAppendQueryKernelTimestamps(ze_command_list_handle_t hC
                                                      ze_event_handle_t hSignalEvent,
                                                      uint32_t numWaitEvents,
                                                      ze_event_handle_t *phWaitEvents) {
-    return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    if (hCommandList == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+    return L0::CommandList::fromHandle(hCommandList)
+        ->appendQueryKernelTimestamps(numEvents,
+                                      phEvents,
+                                      dstptr,
+                                      pOffsets,
+                                      hSignalEvent,
+                                      numWaitEvents,
+                                      phWaitEvents);
 }
 } // namespace L0
 
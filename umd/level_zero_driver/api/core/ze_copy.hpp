@@ -52,7 +52,21 @@ ze_result_t zeCommandListAppendMemoryCopyRegion(ze_command_list_handle_t hComman
                                                 ze_event_handle_t hEvent,
                                                 uint32_t numWaitEvents,
                                                 ze_event_handle_t *phWaitEvents) {
-    return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    if (hCommandList == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+    return L0::CommandList::fromHandle(hCommandList)
+        ->appendMemoryCopyRegion(dstptr,
+                                 dstRegion,
+                                 dstPitch,
+                                 dstSlicePitch,
+                                 srcptr,
+                                 srcRegion,
+                                 srcPitch,
+                                 srcSlicePitch,
+                                 hEvent,
+                                 numWaitEvents,
+                                 phWaitEvents);
 }
 
 ze_result_t zeCommandListAppendImageCopy(ze_command_list_handle_t hCommandList,
@@ -119,7 +119,10 @@ ze_result_t zeEventHostReset(ze_event_handle_t hEvent) {
 
 ze_result_t zeEventQueryKernelTimestamp(ze_event_handle_t hEvent,
                                         ze_kernel_timestamp_result_t *timestampType) {
-    return ZE_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    if (hEvent == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+    return L0::Event::fromHandle(hEvent)->queryKernelTimestamp(timestampType);
 }
 } // namespace L0
 
@@ -71,6 +71,87 @@ ze_result_t ZE_APICALL zeGraphCreate(ze_context_handle_t hContext,
     return L0::Graph::create(hContext, hDevice, pDesc, phGraph);
 }
 
+ze_result_t ZE_APICALL zeGraphCreateFromFile(ze_context_handle_t hContext,
+                                             ze_device_handle_t hDevice,
+                                             const ze_graph_desc_t *pDesc,
+                                             const char *pPath,
+                                             ze_graph_handle_t *phGraph) {
+    if (hDevice == nullptr || hContext == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    auto result = translateHandle(ZEL_HANDLE_CONTEXT, hContext);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    result = translateHandle(ZEL_HANDLE_DEVICE, hDevice);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    return L0::Graph::createFromFile(hContext, hDevice, pDesc, pPath, phGraph);
+}
+
+ze_result_t ZE_APICALL zeGraphCreateFromFd(ze_context_handle_t hContext,
+                                           ze_device_handle_t hDevice,
+                                           const ze_graph_desc_t *pDesc,
+                                           int fd,
+                                           ze_graph_handle_t *phGraph) {
+    if (hDevice == nullptr || hContext == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    auto result = translateHandle(ZEL_HANDLE_CONTEXT, hContext);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    result = translateHandle(ZEL_HANDLE_DEVICE, hDevice);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    return L0::Graph::createFromFd(hContext, hDevice, pDesc, fd, phGraph);
+}
+
+ze_result_t ZE_APICALL zeGraphCreateAsync(ze_context_handle_t hContext,
+                                          ze_device_handle_t hDevice,
+                                          const ze_graph_desc_t *pDesc,
+                                          ze_graph_handle_t *phGraph) {
+    if (hDevice == nullptr || hContext == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    auto result = translateHandle(ZEL_HANDLE_CONTEXT, hContext);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    result = translateHandle(ZEL_HANDLE_DEVICE, hDevice);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    return L0::Graph::createAsync(hContext, hDevice, pDesc, phGraph);
+}
+
+ze_result_t ZE_APICALL zeGraphCreationSynchronize(ze_graph_handle_t hGraph, uint64_t timeout) {
+    if (hGraph == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    return L0::Graph::fromHandle(hGraph)->synchronizeCreation(timeout);
+}
+
+ze_result_t ZE_APICALL zeGraphCreationQueryStatus(ze_graph_handle_t hGraph) {
+    if (hGraph == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    return L0::Graph::fromHandle(hGraph)->synchronizeCreation(0);
+}
+
 ze_result_t ZE_APICALL zeGraphDestroy(ze_graph_handle_t hGraph) {
     if (hGraph == nullptr) {
         return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
@@ -202,6 +283,55 @@ ze_result_t ZE_APICALL zeAppendGraphExecute(ze_command_list_handle_t hCommandLis
                              phWaitEventsTranslated.get());
 }
 
+ze_result_t ZE_APICALL
+zeAppendGraphExecuteBatch(ze_command_list_handle_t hCommandList,
+                          ze_graph_handle_t hGraph,
+                          uint32_t batchSize,
+                          const void **ppArgValues,
+                          ze_graph_profiling_query_handle_t *phProfilingQueries,
+                          ze_event_handle_t hSignalEvent,
+                          uint32_t numWaitEvents,
+                          ze_event_handle_t *phWaitEvents) {
+    if (hCommandList == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    auto result = translateHandle(ZEL_HANDLE_COMMAND_LIST, hCommandList);
+    if (result != ZE_RESULT_SUCCESS) {
+        return result;
+    }
+
+    if (hSignalEvent != nullptr) {
+        auto result = translateHandle(ZEL_HANDLE_EVENT, hSignalEvent);
+        if (result != ZE_RESULT_SUCCESS)
+            return result;
+    }
+
+    std::unique_ptr<ze_event_handle_t[]> phWaitEventsTranslated = nullptr;
+    if (numWaitEvents > 0) {
+        if (phWaitEvents == nullptr)
+            return ZE_RESULT_ERROR_INVALID_SIZE;
+
+        phWaitEventsTranslated =
+            std::unique_ptr<ze_event_handle_t[]>(new ze_event_handle_t[numWaitEvents]);
+        for (uint32_t i = 0; i < numWaitEvents; i++) {
+            auto result =
+                translateHandle(ZEL_HANDLE_EVENT, phWaitEvents[i], &phWaitEventsTranslated[i]);
+            if (result != ZE_RESULT_SUCCESS)
+                return result;
+        }
+    }
+
+    return L0::CommandList::fromHandle(hCommandList)
+        ->appendGraphExecuteBatch(hGraph,
+                                  batchSize,
+                                  ppArgValues,
+                                  phProfilingQueries,
+                                  hSignalEvent,
+                                  numWaitEvents,
+                                  phWaitEventsTranslated.get());
+}
+
 ze_result_t ZE_APICALL
 zeDeviceGetGraphProperties(ze_device_handle_t hDevice,
                            ze_device_graph_properties_t *pDeviceGraphProperties) {
@@ -294,6 +424,38 @@ ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreate(ze_context_handle_t hContext,
     return L0::zeGraphCreate(hContext, hDevice, pDesc, phGraph);
 }
 
+ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreateFromFile(ze_context_handle_t hContext,
+                                                          ze_device_handle_t hDevice,
+                                                          const ze_graph_desc_t *pDesc,
+                                                          const char *pPath,
+                                                          ze_graph_handle_t *phGraph) {
+    return L0::zeGraphCreateFromFile(hContext, hDevice, pDesc, pPath, phGraph);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreateFromFd(ze_context_handle_t hContext,
+                                                        ze_device_handle_t hDevice,
+                                                        const ze_graph_desc_t *pDesc,
+                                                        int fd,
+                                                        ze_graph_handle_t *phGraph) {
+    return L0::zeGraphCreateFromFd(hContext, hDevice, pDesc, fd, phGraph);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreateAsync(ze_context_handle_t hContext,
+                                                       ze_device_handle_t hDevice,
+                                                       const ze_graph_desc_t *pDesc,
+                                                       ze_graph_handle_t *phGraph) {
+    return L0::zeGraphCreateAsync(hContext, hDevice, pDesc, phGraph);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreationSynchronize(ze_graph_handle_t hGraph,
+                                                               uint64_t timeout) {
+    return L0::zeGraphCreationSynchronize(hGraph, timeout);
+}
+
+ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphCreationQueryStatus(ze_graph_handle_t hGraph) {
+    return L0::zeGraphCreationQueryStatus(hGraph);
+}
+
 ZE_APIEXPORT ze_result_t ZE_APICALL zeGraphDestroy(ze_graph_handle_t hGraph) {
     return L0::zeGraphDestroy(hGraph);
 }
@@ -349,6 +511,25 @@ zeAppendGraphExecute(ze_command_list_handle_t hCommandList,
                                     phWaitEvents);
 }
 
+ZE_APIEXPORT ze_result_t ZE_APICALL
+zeAppendGraphExecuteBatch(ze_command_list_handle_t hCommandList,
+                          ze_graph_handle_t hGraph,
+                          uint32_t batchSize,
+                          const void **ppArgValues,
+                          ze_graph_profiling_query_handle_t *phProfilingQueries,
+                          ze_event_handle_t hSignalEvent,
+                          uint32_t numWaitEvents,
+                          ze_event_handle_t *phWaitEvents) {
+    return L0::zeAppendGraphExecuteBatch(hCommandList,
+                                         hGraph,
+                                         batchSize,
+                                         ppArgValues,
+                                         phProfilingQueries,
+                                         hSignalEvent,
+                                         numWaitEvents,
+                                         phWaitEvents);
+}
+
 ZE_APIEXPORT ze_result_t ZE_APICALL
 zeDeviceGetGraphProperties(ze_device_handle_t hDevice,
                            ze_device_graph_properties_t *pDeviceGraphProperties) {
@@ -7,7 +7,7 @@
 
 #pragma once
 
-#include "level_zero/ze_graph_ext.h"
+#include "level_zero/ze_vpu_graph_ext.h"
 
 namespace L0 {
 
@@ -16,6 +16,27 @@ ze_result_t ZE_APICALL zeGraphCreate(ze_context_handle_t hContext,
                                      const ze_graph_desc_t *pDesc,
                                      ze_graph_handle_t *phGraph);
 
+ze_result_t ZE_APICALL zeGraphCreateFromFile(ze_context_handle_t hContext,
+                                             ze_device_handle_t hDevice,
+                                             const ze_graph_desc_t *pDesc,
+                                             const char *pPath,
+                                             ze_graph_handle_t *phGraph);
+
+ze_result_t ZE_APICALL zeGraphCreateFromFd(ze_context_handle_t hContext,
+                                           ze_device_handle_t hDevice,
+                                           const ze_graph_desc_t *pDesc,
+                                           int fd,
+                                           ze_graph_handle_t *phGraph);
+
+ze_result_t ZE_APICALL zeGraphCreateAsync(ze_context_handle_t hContext,
+                                          ze_device_handle_t hDevice,
+                                          const ze_graph_desc_t *pDesc,
+                                          ze_graph_handle_t *phGraph);
+
+ze_result_t ZE_APICALL zeGraphCreationSynchronize(ze_graph_handle_t hGraph, uint64_t timeout);
+
+ze_result_t ZE_APICALL zeGraphCreationQueryStatus(ze_graph_handle_t hGraph);
+
 ze_result_t ZE_APICALL zeGraphDestroy(ze_graph_handle_t hGraph);
 
 ze_result_t ZE_APICALL zeGraphGetNativeBinary(ze_graph_handle_t hGraph,
@@ -47,6 +68,16 @@ ze_result_t ZE_APICALL zeAppendGraphExecute(ze_command_list_handle_t hCommandLis
                                             uint32_t numWaitEvents,
                                             ze_event_handle_t *phWaitEvents);
 
+ze_result_t ZE_APICALL
+zeAppendGraphExecuteBatch(ze_command_list_handle_t hCommandList,
+                          ze_graph_handle_t hGraph,
+                          uint32_t batchSize,
+                          const void **ppArgValues,
+                          ze_graph_profiling_query_handle_t *phProfilingQueries,
+                          ze_event_handle_t hSignalEvent,
+                          uint32_t numWaitEvents,
+                          ze_event_handle_t *phWaitEvents);
+
 ze_result_t ZE_APICALL
 zeDeviceGetGraphProperties(ze_device_handle_t hDevice,
                            ze_device_graph_properties_t *pDeviceGraphProperties);
@@ -11,11 +11,14 @@
 #include "level_zero_driver/tools/source/metrics/metric_query.hpp"
 #include "vpu_driver/source/command/vpu_barrier_command.hpp"
 #include "vpu_driver/source/command/vpu_copy_command.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
 #include "vpu_driver/source/command/vpu_memory_fill_command.hpp"
 #include "vpu_driver/source/command/vpu_query_command.hpp"
 #include "vpu_driver/source/command/vpu_ts_command.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
 
+#include <limits>
+
 namespace L0 {
 
 CommandList::CommandList(bool isCopyOnly, VPU::VPUDeviceContext *ctx)
@@ -31,13 +34,36 @@ CommandList::create(bool isCopyOnly, VPU::VPUDeviceContext *ctx, ze_result_t &re
     return commandList;
 }
 
+CommandList *CommandList::createImmediate(bool isCopyOnly,
+                                          bool isSynchronous,
+                                          VPU::VPUDeviceContext *ctx,
+                                          ze_result_t &returnValue) {
+    CommandList *commandList = new CommandList(isCopyOnly, ctx);
+    commandList->isImmediateCmdList = true;
+    commandList->isSynchronousCmdList = isSynchronous;
+    commandList->lastImmediateTarget =
+        isCopyOnly ? VPU::VPUCommandBuffer::Target::COPY : VPU::VPUCommandBuffer::Target::COMPUTE;
+
+    returnValue = ZE_RESULT_SUCCESS;
+    return commandList;
+}
+
 ze_result_t CommandList::destroy() {
+    // Buffers of immediate submissions are released with the jobs, make sure VPU is done with them
+    for (const auto &job : immediateJobs)
+        job->waitForCompletion(std::numeric_limits<int64_t>::max());
+
     delete this;
     LOG_I("CommandList destroyed.");
     return ZE_RESULT_SUCCESS;
 }
 
 ze_result_t CommandList::close() {
+    if (isImmediateCmdList) {
+        LOG_W("Immediate CommandList does not need to be closed");
+        return ZE_RESULT_SUCCESS;
+    }
+
     if (isCmdListClosed()) {
         LOG_W("CommandList already closed");
         return ZE_RESULT_SUCCESS;
@@ -53,6 +79,7 @@ ze_result_t CommandList::close() {
 
 ze_result_t CommandList::reset() {
     vpuJob = std::make_shared<VPU::VPUJob>(ctx, isCopyOnlyCmdList);
+    immediateCmds.clear();
 
     return ZE_RESULT_SUCCESS;
 }
@@ -67,6 +94,85 @@ ze_result_t CommandList::checkCommandAppendCondition() {
         return ZE_RESULT_ERROR_NOT_AVAILABLE;
     }
 
+    if (immediateCmds.size()) {
+        LOG_W("Dropping %zu commands left by failed append to immediate CommandList",
+              immediateCmds.size());
+        immediateCmds.clear();
+    }
+
+    return ZE_RESULT_SUCCESS;
+}
+
+bool CommandList::appendCommand(std::shared_ptr<VPU::VPUCommand> cmd) {
+    if (!isImmediateCmdList)
+        return vpuJob->appendCommand(cmd);
+
+    if (isCopyOnlyCmdList && cmd->isComputeCommand()) {
+        LOG_E("Command(%#x) is of compute type and cannot be appended to copy-only list!",
+              cmd->getCommandType());
+        return false;
+    }
+
+    immediateCmds.push_back(cmd);
+    return true;
+}
+
+ze_result_t CommandList::submitImmediateCommands() {
+    if (!isImmediateCmdList || immediateCmds.empty())
+        return ZE_RESULT_SUCCESS;
+
+    // Commands without engine preference follow the engine of previous submission
+    auto target = lastImmediateTarget;
+    for (const auto &cmd : immediateCmds) {
+        if (cmd->isComputeCommand())
+            target = VPU::VPUCommandBuffer::Target::COMPUTE;
+        else if (cmd->isCopyCommand())
+            target = VPU::VPUCommandBuffer::Target::COPY;
+    }
+
+    auto job = std::move(vpuJob);
+    auto cmds = std::move(immediateCmds);
+    vpuJob = std::make_shared<VPU::VPUJob>(ctx, isCopyOnlyCmdList);
+    immediateCmds.clear();
+
+    // Jobs of one engine complete in order and the engines are synchronized on switch, so the
+    // oldest job is the first one to complete. Its buffers are reused by this submission.
+    std::shared_ptr<VPU::VPUJob> recycled;
+    if (!immediateJobs.empty() && immediateJobs.front()->waitForCompletion(0)) {
+        recycled = std::move(immediateJobs.front());
+        immediateJobs.pop_front();
+    }
+
+    if (!job->closeCommands(cmds, target, recycled.get())) {
+        LOG_E("Failed to close immediate VPUJob");
+        return ZE_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+    recycled.reset();
+
+    // Engines do not synchronize each other, preserve the order of appends
+    if (target != lastImmediateTarget) {
+        for (const auto &inFlightJob : immediateJobs)
+            inFlightJob->waitForCompletion(std::numeric_limits<int64_t>::max());
+    }
+    lastImmediateTarget = target;
+
+    while (immediateJobs.size() >= immediateRingSize && immediateJobs.front()->waitForCompletion(0))
+        immediateJobs.pop_front();
+
+    if (!ctx->submitJob(job.get(), this)) {
+        LOG_E("Immediate VPUJob submission failed");
+        return ZE_RESULT_ERROR_UNKNOWN;
+    }
+    ctx->getCompletionNotifier().trackJob(job);
+
+    immediateJobs.emplace_back(job);
+
+    if (isSynchronousCmdList) {
+        if (!job->waitForCompletion(std::numeric_limits<int64_t>::max()) || !job->isSuccess()) {
+            LOG_E("Immediate VPUJob execution failed");
+            return ZE_RESULT_ERROR_UNKNOWN;
+        }
+    }
     return ZE_RESULT_SUCCESS;
 }
 
@@ -87,7 +193,7 @@ ze_result_t CommandList::appendCommandWithEvents(ze_event_handle_t hSignalEvent,
             return ZE_RESULT_ERROR_INVALID_SIZE;
         }
 
-        result = appendWaitOnEvents(numWaitEvents, phWaitEvents);
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to add %u wait on events.", numWaitEvents);
             return result;
@@ -101,13 +207,21 @@ ze_result_t CommandList::appendCommandWithEvents(ze_event_handle_t hSignalEvent,
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
+    result = appendKernelTimestampCommand(hSignalEvent, true);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    if (!appendCommand(cmd)) {
         LOG_E("Command(%#x) failed to push to list!", cmd->getCommandType());
         return ZE_RESULT_ERROR_UNKNOWN;
     }
 
+    result = appendKernelTimestampCommand(hSignalEvent, false);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
     if (hSignalEvent != nullptr) {
-        result = appendSignalEvent(hSignalEvent);
+        result = appendSignalEventCommand(hSignalEvent);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to append signal event command (handle: %p, error: %#x).",
                   hSignalEvent,
@@ -123,7 +237,7 @@ ze_result_t CommandList::appendCommandWithEvents(ze_event_handle_t hSignalEvent,
           numWaitEvents,
           phWaitEvents);
 
-    return ZE_RESULT_SUCCESS;
+    return submitImmediateCommands();
 }
 
 ze_result_t CommandList::appendBarrier(ze_event_handle_t hSignalEvent,
@@ -155,6 +269,99 @@ ze_result_t CommandList::appendMemoryCopy(void *dstptr,
                                                         size);
 }
 
+ze_result_t CommandList::appendMemoryCopyRegion(void *dstptr,
+                                                const ze_copy_region_t *dstRegion,
+                                                uint32_t dstPitch,
+                                                uint32_t dstSlicePitch,
+                                                const void *srcptr,
+                                                const ze_copy_region_t *srcRegion,
+                                                uint32_t srcPitch,
+                                                uint32_t srcSlicePitch,
+                                                ze_event_handle_t hSignalEvent,
+                                                uint32_t numWaitEvents,
+                                                ze_event_handle_t *phWaitEvents) {
+    if (dstptr == nullptr || srcptr == nullptr || dstRegion == nullptr || srcRegion == nullptr) {
+        LOG_E("Pointer to destination/source memory or region passed as nullptr.");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    if (dstRegion->width != srcRegion->width || dstRegion->height != srcRegion->height ||
+        dstRegion->depth != srcRegion->depth) {
+        LOG_E("Sizes of source and destination regions differ.");
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    ze_result_t result = checkCommandAppendCondition();
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    if (numWaitEvents > 0) {
+        if (phWaitEvents == nullptr) {
+            LOG_E("Invalid wait event input. phWaitEvents: %p, numWaitEvents: %u",
+                  phWaitEvents,
+                  numWaitEvents);
+            return ZE_RESULT_ERROR_INVALID_SIZE;
+        }
+
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
+        if (result != ZE_RESULT_SUCCESS) {
+            LOG_E("Failed to add %u wait on events.", numWaitEvents);
+            return result;
+        }
+    }
+
+    auto toRegion = [](const ze_copy_region_t *region, uint32_t pitch, uint32_t slicePitch) {
+        VPU::VPUCopyCommand::Region vpuRegion;
+        vpuRegion.pitch = pitch;
+        vpuRegion.slicePitch = slicePitch;
+        vpuRegion.offset = static_cast<size_t>(region->originZ) * slicePitch +
+                           static_cast<size_t>(region->originY) * pitch + region->originX;
+        return vpuRegion;
+    };
+
+    // Region is copied by few copy commands with descriptor per row instead of command per row
+    auto cmds = VPU::VPUCopyCommand::createRegion(ctx,
+                                                  srcptr,
+                                                  toRegion(srcRegion, srcPitch, srcSlicePitch),
+                                                  dstptr,
+                                                  toRegion(dstRegion, dstPitch, dstSlicePitch),
+                                                  srcRegion->width,
+                                                  srcRegion->height,
+                                                  srcRegion->depth);
+    if (cmds.empty()) {
+        LOG_E("Region copy commands failed to be initialized!");
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    result = appendKernelTimestampCommand(hSignalEvent, true);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    for (const auto &cmd : cmds) {
+        if (!appendCommand(cmd)) {
+            LOG_E("Failed to push region copy command to list!");
+            return ZE_RESULT_ERROR_UNKNOWN;
+        }
+    }
+
+    result = appendKernelTimestampCommand(hSignalEvent, false);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    if (hSignalEvent != nullptr) {
+        result = appendSignalEventCommand(hSignalEvent);
+        if (result != ZE_RESULT_SUCCESS) {
+            LOG_E("Failed to append signal event command (handle: %p, error: %#x).",
+                  hSignalEvent,
+                  result);
+            return result;
+        }
+    }
+
+    LOG_V("Successfully appended %lu region copy commands to CommandList.", cmds.size());
+    return submitImmediateCommands();
+}
+
 ze_result_t CommandList::appendMemoryFill(void *ptr,
                                           const void *pattern,
                                           size_t patternSize,
@@ -203,6 +410,8 @@ ze_result_t CommandList::appendGraphInitialize(ze_graph_handle_t hGraph,
                                                ze_event_handle_t hSignalEvent,
                                                uint32_t numWaitEvents,
                                                ze_event_handle_t *phWaitEvents) {
+    VPU::VPUJobTracer::Scope traceScope("appendGraphInitialize", vpuJob.get());
+
     ze_result_t result = checkCommandAppendCondition();
     if (result != ZE_RESULT_SUCCESS)
         return result;
@@ -215,7 +424,7 @@ ze_result_t CommandList::appendGraphInitialize(ze_graph_handle_t hGraph,
             return ZE_RESULT_ERROR_INVALID_SIZE;
         }
 
-        result = appendWaitOnEvents(numWaitEvents, phWaitEvents);
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to add %u wait on events.", numWaitEvents);
             return result;
@@ -234,13 +443,13 @@ ze_result_t CommandList::appendGraphInitialize(ze_graph_handle_t hGraph,
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
+    if (!appendCommand(cmd)) {
         LOG_E("Failed to push Graph-Initialize command to list!");
         return ZE_RESULT_ERROR_UNKNOWN;
     }
 
     if (hSignalEvent != nullptr) {
-        result = appendSignalEvent(hSignalEvent);
+        result = appendSignalEventCommand(hSignalEvent);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to append signal event command (handle: %p, error: %#x).",
                   hSignalEvent,
@@ -250,7 +459,7 @@ ze_result_t CommandList::appendGraphInitialize(ze_graph_handle_t hGraph,
     }
 
     LOG_V("Successfully appended graph initialize command to CommandList.");
-    return ZE_RESULT_SUCCESS;
+    return submitImmediateCommands();
 }
 
 ze_result_t CommandList::appendGraphExecute(ze_graph_handle_t hGraph,
@@ -258,6 +467,8 @@ ze_result_t CommandList::appendGraphExecute(ze_graph_handle_t hGraph,
                                             ze_event_handle_t hSignalEvent,
                                             uint32_t numWaitEvents,
                                             ze_event_handle_t *phWaitEvents) {
+    VPU::VPUJobTracer::Scope traceScope("appendGraphExecute", vpuJob.get());
+
     ze_result_t result = checkCommandAppendCondition();
     if (result != ZE_RESULT_SUCCESS)
         return result;
@@ -270,7 +481,7 @@ ze_result_t CommandList::appendGraphExecute(ze_graph_handle_t hGraph,
             return ZE_RESULT_ERROR_INVALID_SIZE;
         }
 
-        result = appendWaitOnEvents(numWaitEvents, phWaitEvents);
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to add %u wait on events.", numWaitEvents);
             return result;
@@ -299,13 +510,98 @@ ze_result_t CommandList::appendGraphExecute(ze_graph_handle_t hGraph,
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
-        LOG_E("Failed to push Graph-Execute command to list!");
-        return ZE_RESULT_ERROR_UNKNOWN;
+    return appendGraphExecuteCommands({cmd}, hSignalEvent);
+}
+
+ze_result_t
+CommandList::appendGraphExecuteBatch(ze_graph_handle_t hGraph,
+                                     uint32_t batchSize,
+                                     const void **ppArgValues,
+                                     ze_graph_profiling_query_handle_t *phProfilingQueries,
+                                     ze_event_handle_t hSignalEvent,
+                                     uint32_t numWaitEvents,
+                                     ze_event_handle_t *phWaitEvents) {
+    VPU::VPUJobTracer::Scope traceScope("appendGraphExecuteBatch", vpuJob.get());
+
+    ze_result_t result = checkCommandAppendCondition();
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    if (batchSize == 0 || ppArgValues == nullptr) {
+        LOG_E("Invalid batch. batchSize: %u, ppArgValues: %p", batchSize, ppArgValues);
+        return ZE_RESULT_ERROR_INVALID_SIZE;
+    }
+
+    if (numWaitEvents > 0) {
+        if (phWaitEvents == nullptr) {
+            LOG_E("Invalid wait event input. phWaitEvents: %p, numWaitEvents: %u",
+                  phWaitEvents,
+                  numWaitEvents);
+            return ZE_RESULT_ERROR_INVALID_SIZE;
+        }
+
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
+        if (result != ZE_RESULT_SUCCESS) {
+            LOG_E("Failed to add %u wait on events.", numWaitEvents);
+            return result;
+        }
     }
 
+    Graph *graph = Graph::fromHandle(hGraph);
+    if (graph == nullptr) {
+        LOG_E("Invalid graph handle.");
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    std::vector<void *> profilingQueryPtrs;
+    if (graph->getProfilingOutputSize()) {
+        if (phProfilingQueries == nullptr) {
+            LOG_E("Invalid profiling query handles.");
+            return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+        }
+
+        for (uint32_t i = 0; i < batchSize; i++) {
+            auto *profilingQuery = GraphProfilingQuery::fromHandle(phProfilingQueries[i]);
+            if (!profilingQuery) {
+                LOG_E("Invalid profiling query handle.");
+                return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+            }
+            profilingQueryPtrs.push_back(profilingQuery->getQueryPtr());
+        }
+    }
+
+    auto commands = graph->allocateGraphExecuteBatchCommands(ctx,
+                                                             batchSize,
+                                                             ppArgValues,
+                                                             profilingQueryPtrs);
+    if (commands.empty()) {
+        LOG_E("Graph-Execute batch commands failed to be initialized!");
+        return ZE_RESULT_ERROR_UNINITIALIZED;
+    }
+
+    return appendGraphExecuteCommands(commands, hSignalEvent);
+}
+
+ze_result_t
+CommandList::appendGraphExecuteCommands(const std::vector<std::shared_ptr<VPU::VPUCommand>> &cmds,
+                                        ze_event_handle_t hSignalEvent) {
+    ze_result_t result = appendKernelTimestampCommand(hSignalEvent, true);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    for (const auto &cmd : cmds) {
+        if (!appendCommand(cmd)) {
+            LOG_E("Failed to push Graph-Execute command to list!");
+            return ZE_RESULT_ERROR_UNKNOWN;
+        }
+    }
+
+    result = appendKernelTimestampCommand(hSignalEvent, false);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
     if (hSignalEvent != nullptr) {
-        result = appendSignalEvent(hSignalEvent);
+        result = appendSignalEventCommand(hSignalEvent);
         if (result != ZE_RESULT_SUCCESS) {
             LOG_E("Failed to append signal event command (handle: %p, error: %#x).",
                   hSignalEvent,
@@ -315,7 +611,7 @@ ze_result_t CommandList::appendGraphExecute(ze_graph_handle_t hGraph,
     }
 
     LOG_V("Successfully appended graph execute command to CommandList.");
-    return ZE_RESULT_SUCCESS;
+    return submitImmediateCommands();
 }
 
 ze_result_t CommandList::appendSignalEvent(ze_event_handle_t hEvent) {
@@ -323,6 +619,14 @@ ze_result_t CommandList::appendSignalEvent(ze_event_handle_t hEvent) {
     if (result != ZE_RESULT_SUCCESS)
         return result;
 
+    result = appendSignalEventCommand(hEvent);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    return submitImmediateCommands();
+}
+
+ze_result_t CommandList::appendSignalEventCommand(ze_event_handle_t hEvent) {
     auto event = Event::fromHandle(hEvent);
     if (event == nullptr) {
         LOG_E("Failed to get event handle.");
@@ -341,7 +645,7 @@ ze_result_t CommandList::appendSignalEvent(ze_event_handle_t hEvent) {
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
+    if (!appendCommand(cmd)) {
         LOG_E("Failed to push signal event command to list!");
         return ZE_RESULT_ERROR_UNKNOWN;
     }
@@ -351,6 +655,104 @@ ze_result_t CommandList::appendSignalEvent(ze_event_handle_t hEvent) {
     return ZE_RESULT_SUCCESS;
 }
 
+ze_result_t CommandList::appendKernelTimestampCommand(ze_event_handle_t hEvent, bool isStart) {
+    auto event = Event::fromHandle(hEvent);
+    if (event == nullptr || !event->isKernelTimestampEvent())
+        return ZE_RESULT_SUCCESS;
+
+    // Start timestamp runs on the engine of the measured command, end timestamp follows it
+    auto cmd = isStart ? VPU::VPUTimeStampCommand::create(ctx,
+                                                          event->getKernelStartPointer(),
+                                                          VPU::VPUCommand::EngineSupport::Forward)
+                       : VPU::VPUTimeStampCommand::create(ctx, event->getKernelEndPointer());
+    if (cmd == nullptr) {
+        LOG_E("Failed to initialize kernel timestamp command.");
+        return ZE_RESULT_ERROR_UNINITIALIZED;
+    }
+
+    if (!appendCommand(cmd)) {
+        LOG_E("Failed to push kernel timestamp command to list!");
+        return ZE_RESULT_ERROR_UNKNOWN;
+    }
+
+    return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t CommandList::appendQueryKernelTimestamps(uint32_t numEvents,
+                                                     ze_event_handle_t *phEvents,
+                                                     void *dstptr,
+                                                     const size_t *pOffsets,
+                                                     ze_event_handle_t hSignalEvent,
+                                                     uint32_t numWaitEvents,
+                                                     ze_event_handle_t *phWaitEvents) {
+    if (phEvents == nullptr || dstptr == nullptr) {
+        LOG_E("Invalid events (%p) or destination pointer (%p).", phEvents, dstptr);
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    ze_result_t result = checkCommandAppendCondition();
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    if (numWaitEvents > 0) {
+        if (phWaitEvents == nullptr) {
+            LOG_E("Invalid wait event input. phWaitEvents: %p, numWaitEvents: %u",
+                  phWaitEvents,
+                  numWaitEvents);
+            return ZE_RESULT_ERROR_INVALID_SIZE;
+        }
+
+        result = appendWaitOnEventCommands(numWaitEvents, phWaitEvents);
+        if (result != ZE_RESULT_SUCCESS) {
+            LOG_E("Failed to add %u wait on events.", numWaitEvents);
+            return result;
+        }
+    }
+
+    for (uint32_t i = 0; i < numEvents; i++) {
+        auto event = Event::fromHandle(phEvents[i]);
+        if (event == nullptr || !event->isKernelTimestampEvent()) {
+            LOG_E("Event %p does not record kernel timestamps.", event);
+            return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+        }
+
+        auto dst = static_cast<uint8_t *>(dstptr) +
+                   (pOffsets ? pOffsets[i] : i * sizeof(ze_kernel_timestamp_result_t));
+        auto *timestamps = reinterpret_cast<ze_kernel_timestamp_result_t *>(dst);
+
+        // VPU does not distinguish global and context timestamps, copy the pair twice
+        for (auto *data : {&timestamps->global, &timestamps->context}) {
+            auto cmd = VPU::VPUCopyCommand::create(ctx,
+                                                   event->getKernelStartPointer(),
+                                                   data,
+                                                   sizeof(ze_kernel_timestamp_data_t));
+            if (cmd == nullptr) {
+                LOG_E("Failed to initialize copy of kernel timestamp to %p.", data);
+                return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+            }
+
+            if (!appendCommand(cmd)) {
+                LOG_E("Failed to push kernel timestamp copy command to list!");
+                return ZE_RESULT_ERROR_UNKNOWN;
+            }
+        }
+        event->associateJob(vpuJob);
+    }
+
+    if (hSignalEvent != nullptr) {
+        result = appendSignalEventCommand(hSignalEvent);
+        if (result != ZE_RESULT_SUCCESS) {
+            LOG_E("Failed to append signal event command (handle: %p, error: %#x).",
+                  hSignalEvent,
+                  result);
+            return result;
+        }
+    }
+
+    LOG_V("Successfully appended query of %u kernel timestamps to CommandList.", numEvents);
+    return submitImmediateCommands();
+}
+
 ze_result_t CommandList::appendWaitOnEvents(uint32_t numEvents, ze_event_handle_t *phEvent) {
     if (phEvent == nullptr)
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
@@ -362,6 +764,15 @@ ze_result_t CommandList::appendWaitOnEvents(uint32_t numEvents, ze_event_handle_
     if (result != ZE_RESULT_SUCCESS)
         return result;
 
+    result = appendWaitOnEventCommands(numEvents, phEvent);
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    return submitImmediateCommands();
+}
+
+ze_result_t CommandList::appendWaitOnEventCommands(uint32_t numEvents,
+                                                   ze_event_handle_t *phEvent) {
     for (uint32_t i = 0; i < numEvents; ++i) {
         auto event = Event::fromHandle(phEvent[i]);
         if (event == nullptr) {
@@ -381,7 +792,7 @@ ze_result_t CommandList::appendWaitOnEvents(uint32_t numEvents, ze_event_handle_
             return ZE_RESULT_ERROR_UNINITIALIZED;
         }
 
-        if (!vpuJob->appendCommand(cmd)) {
+        if (!appendCommand(cmd)) {
             LOG_E("Failed to push event wait command to list!");
             return ZE_RESULT_ERROR_UNKNOWN;
         }
@@ -415,14 +826,14 @@ ze_result_t CommandList::appendEventReset(ze_event_handle_t hEvent) {
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
+    if (!appendCommand(cmd)) {
         LOG_E("Failed to push reset event command to list!");
         return ZE_RESULT_ERROR_UNKNOWN;
     }
 
     event->associateJob(vpuJob);
     LOG_V("Successfully appended reset event command to CommandList.");
-    return ZE_RESULT_SUCCESS;
+    return submitImmediateCommands();
 }
 
 ze_result_t CommandList::appendMetricQueryBegin(zet_metric_query_handle_t hMetricQuery) {
@@ -451,13 +862,13 @@ ze_result_t CommandList::appendMetricQueryBegin(zet_metric_query_handle_t hMetri
         return ZE_RESULT_ERROR_UNINITIALIZED;
     }
 
-    if (!vpuJob->appendCommand(cmd)) {
+    if (!appendCommand(cmd)) {
         LOG_E("Failed to push metric query begin command to list!");
         return ZE_RESULT_ERROR_UNKNOWN;
     }
 
     LOG_V("Successfully appended metric query begin command to CommandList.");
-    return ZE_RESULT_SUCCESS;
+    return submitImmediateCommands();
 }
 
 ze_result_t CommandList::appendMetricQueryEnd(zet_metric_query_handle_t hMetricQuery,
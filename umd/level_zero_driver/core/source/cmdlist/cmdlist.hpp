@@ -11,6 +11,8 @@
 #include "level_zero_driver/core/source/device/device.hpp"
 #include "level_zero_driver/core/source/cmdqueue/cmdqueue.hpp"
 
+#include <deque>
+
 struct _ze_command_list_handle_t {};
 
 namespace L0 {
@@ -24,6 +26,22 @@ struct CommandList : _ze_command_list_handle_t {
     static CommandList *
     create(bool isCopyOnly, VPU::VPUDeviceContext *ctx, ze_result_t &returnValue);
 
+    /**
+     * @brief Create command list that submits appended commands right away. Each append is
+     * encoded into own command buffer and submitted without going through command queue.
+     *
+     * @param isCopyOnly [in]: Commands are submitted to copy engine.
+     * @param isSynchronous [in]: Each append blocks until the submission is completed.
+     * @param ctx [in]: Device context used for allocations and submissions.
+     * @param returnValue [out]: ZE_RESULT_SUCCESS on successful creation.
+     * @return CommandList* Pointer to immediate command list.
+     */
+    static CommandList *createImmediate(bool isCopyOnly,
+                                        bool isSynchronous,
+                                        VPU::VPUDeviceContext *ctx,
+                                        ze_result_t &returnValue);
+    bool isImmediate() const { return isImmediateCmdList; };
+
     ze_result_t close();
     ze_result_t reset();
     ze_result_t appendBarrier(ze_event_handle_t hSignalEvent,
@@ -35,6 +53,17 @@ struct CommandList : _ze_command_list_handle_t {
                                  ze_event_handle_t hSignalEvent,
                                  uint32_t numWaitEvents,
                                  ze_event_handle_t *phWaitEvents);
+    ze_result_t appendMemoryCopyRegion(void *dstptr,
+                                       const ze_copy_region_t *dstRegion,
+                                       uint32_t dstPitch,
+                                       uint32_t dstSlicePitch,
+                                       const void *srcptr,
+                                       const ze_copy_region_t *srcRegion,
+                                       uint32_t srcPitch,
+                                       uint32_t srcSlicePitch,
+                                       ze_event_handle_t hSignalEvent,
+                                       uint32_t numWaitEvents,
+                                       ze_event_handle_t *phWaitEvents);
     ze_result_t appendMemoryFill(void *ptr,
                                  const void *pattern,
                                  size_t patternSize,
@@ -55,6 +84,25 @@ struct CommandList : _ze_command_list_handle_t {
                                    ze_event_handle_t hSignalEvent,
                                    uint32_t numWaitEvents,
                                    ze_event_handle_t *phWaitEvents);
+    /**
+     * @brief Append executions of the graph, one per argument set. ppArgValues holds batchSize
+     * sets of argument values ordered by argument index, phProfilingQueries holds a query per
+     * set if the graph has profiling output.
+     */
+    ze_result_t appendGraphExecuteBatch(ze_graph_handle_t hGraph,
+                                        uint32_t batchSize,
+                                        const void **ppArgValues,
+                                        ze_graph_profiling_query_handle_t *phProfilingQueries,
+                                        ze_event_handle_t hSignalEvent,
+                                        uint32_t numWaitEvents,
+                                        ze_event_handle_t *phWaitEvents);
+    ze_result_t appendQueryKernelTimestamps(uint32_t numEvents,
+                                            ze_event_handle_t *phEvents,
+                                            void *dstptr,
+                                            const size_t *pOffsets,
+                                            ze_event_handle_t hSignalEvent,
+                                            uint32_t numWaitEvents,
+                                            ze_event_handle_t *phWaitEvents);
     ze_result_t appendSignalEvent(ze_event_handle_t hEvent);
     ze_result_t appendWaitOnEvents(uint32_t numEvents, ze_event_handle_t *phEvent);
     ze_result_t appendEventReset(ze_event_handle_t hEvent);
@@ -82,6 +130,34 @@ struct CommandList : _ze_command_list_handle_t {
 
   private:
     ze_result_t checkCommandAppendCondition();
+    ze_result_t appendSignalEventCommand(ze_event_handle_t hEvent);
+    ze_result_t appendWaitOnEventCommands(uint32_t numEvents, ze_event_handle_t *phEvent);
+
+    /**
+     * @brief Append timestamp command that records start or end of the command to the slot of
+     * signal event. No-op if the event is not created from kernel timestamp event pool.
+     */
+    ze_result_t appendKernelTimestampCommand(ze_event_handle_t hEvent, bool isStart);
+
+    /**
+     * @brief Push command to VPUJob of regular command list or to pending commands of immediate
+     * command list.
+     */
+    bool appendCommand(std::shared_ptr<VPU::VPUCommand> cmd);
+
+    /**
+     * @brief Submit commands pending in immediate command list. No-op for regular command list.
+     *
+     * @return ze_result_t ZE_RESULT_SUCCESS on successful submission.
+     */
+    ze_result_t submitImmediateCommands();
+
+    /**
+     * @brief Append graph execute commands between timestamps and signal of given event.
+     */
+    ze_result_t
+    appendGraphExecuteCommands(const std::vector<std::shared_ptr<VPU::VPUCommand>> &cmds,
+                               ze_event_handle_t hSignalEvent);
     VPU::VPUEventCommand::KMDEventDataType *getEventSyncPointerFromHandle(ze_event_handle_t hEvent);
 
     /**
@@ -103,6 +179,17 @@ struct CommandList : _ze_command_list_handle_t {
     bool isCopyOnlyCmdList;
     VPU::VPUDeviceContext *ctx;
     std::shared_ptr<VPU::VPUJob> vpuJob = nullptr;
+
+    bool isImmediateCmdList = false;
+    bool isSynchronousCmdList = false;
+    /* Commands of immediate command list that are submitted at the end of append call */
+    std::vector<std::shared_ptr<VPU::VPUCommand>> immediateCmds;
+    /* Submitted jobs of immediate command list in submission order. Buffers of the oldest job
+     * are reused by the next submission once it completes. */
+    std::deque<std::shared_ptr<VPU::VPUJob>> immediateJobs;
+    /* Number of completed immediate jobs kept for reuse of their buffers */
+    static constexpr size_t immediateRingSize = 4;
+    VPU::VPUCommandBuffer::Target lastImmediateTarget = VPU::VPUCommandBuffer::Target::COMPUTE;
 };
 
 } // namespace L0
@@ -12,8 +12,6 @@
 #include "vpu_driver/source/utilities/timer.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
 
-#include <thread>
-
 namespace L0 {
 
 CommandQueue *CommandQueue::create(Device *device,
@@ -91,6 +89,11 @@ ze_result_t CommandQueue::executeCommandLists(uint32_t nCommandLists,
             return ZE_RESULT_ERROR_INVALID_COMMAND_LIST_TYPE;
         }
 
+        if (cmdList->isImmediate()) {
+            LOG_E("Immediate command list cannot be executed by command queue.");
+            return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+        }
+
         if (!cmdList->isCmdListClosed()) {
             LOG_E("Command List didn't close.");
             return ZE_RESULT_ERROR_UNINITIALIZED;
@@ -118,24 +121,38 @@ ze_result_t CommandQueue::executeCommandLists(uint32_t nCommandLists,
             return ZE_RESULT_ERROR_UNKNOWN;
         }
 
-        /*
-         * TODO: Temporary WA to prevent the job resubmission in case previous job submission is not
-         * finished (using same job). Timeout can be omitted thanks to TDR. TDR takes care to abort
-         * stall jobs
-         */
-        while (job->waitForCompletion(0) == false) {
-            std::this_thread::yield();
-        };
+        jobs.emplace_back(std::move(job));
+    }
+
+    // Instance of the job selected for submission must not be changed by other queues before
+    // it is submitted
+    std::unique_lock<std::mutex> submissionLock;
+    if (jobs.size() > 1) {
+        // Merge command lists to submit single command buffer per engine
+        auto batch = VPU::VPUJob::createBatch(ctx, jobs);
+        if (!batch) {
+            LOG_E("Failed to create batch of %lu VPUJobs", jobs.size());
+            return ZE_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+        jobs = {std::move(batch)};
+    } else if (jobs.size() == 1) {
+        submissionLock = std::unique_lock<std::mutex>(jobs.front()->getSubmissionMutex());
+        if (!jobs.front()->prepareSubmission()) {
+            LOG_E("Failed to prepare VPUJob for submission");
+            return ZE_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+    }
 
+    for (const auto &job : jobs) {
         LOG_I("VPUJob pointer: %p", job.get());
 
-        if (!ctx->submitJob(job.get())) {
+        if (!ctx->submitJob(job.get(), this)) {
             LOG_E("VPUJob submission failed");
             return ZE_RESULT_ERROR_UNKNOWN;
         }
 
         LOG_I("VPUJob submitted");
-        jobs.emplace_back(std::move(job));
+        ctx->getCompletionNotifier().trackJob(job);
     }
 
     if (hFence != nullptr) {
@@ -168,7 +185,8 @@ ze_result_t CommandQueue::synchronize(uint64_t timeout) {
     if (vpuDevice == nullptr)
         return ZE_RESULT_ERROR_DEVICE_LOST;
 
-    bool allSignaled = waitForSignal(timeout, trackedJobs, vpuDevice->getHwInfo());
+    bool allSignaled =
+        waitForSignal(timeout, trackedJobs, vpuDevice->getHwInfo(), waitPolicy, &waitStats);
     if (!allSignaled) {
         LOG_W("Commands execution is not finished");
         return ZE_RESULT_NOT_READY;
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "level_zero_driver/core/source/device/device.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
 
 #include <level_zero/ze_api.h>
 
@@ -56,12 +57,18 @@ struct CommandQueue : _ze_command_queue_handle_t {
      */
     size_t getSubmittedJobCount() const { return trackedJobs.size(); }
 
+    void setWaitPolicy(const VPU::WaitPolicy &policy) { waitPolicy = policy; }
+    const VPU::WaitPolicy &getWaitPolicy() const { return waitPolicy; }
+    VPU::WaitStatistics &getWaitStatistics() { return waitStats; }
+
   protected:
     Device *device = nullptr;
     const ze_command_queue_desc_t desc;
     VPU::VPUDeviceContext *ctx = nullptr;
     bool isCopyOnlyCommandQueue = false;
     std::vector<std::shared_ptr<VPU::VPUJob>> trackedJobs;
+    VPU::WaitPolicy waitPolicy = VPU::getDefaultWaitPolicy();
+    VPU::WaitStatistics waitStats;
 };
 
 } // namespace L0
@@ -64,6 +64,19 @@ ze_result_t Context::createCommandList(ze_device_handle_t hDevice,
     return L0::Device::fromHandle(hDevice)->createCommandList(desc, commandList, ctx.get());
 }
 
+ze_result_t Context::createCommandListImmediate(ze_device_handle_t hDevice,
+                                                const ze_command_queue_desc_t *altdesc,
+                                                ze_command_list_handle_t *commandList) {
+    if (hDevice == nullptr) {
+        LOG_E("hDevice is NULL!");
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+
+    return L0::Device::fromHandle(hDevice)->createCommandListImmediate(altdesc,
+                                                                       commandList,
+                                                                       ctx.get());
+}
+
 ze_result_t Context::createEventPool(const ze_event_pool_desc_t *desc,
                                      uint32_t numDevices,
                                      ze_device_handle_t *phDevices,
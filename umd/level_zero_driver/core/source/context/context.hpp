@@ -56,6 +56,9 @@ struct Context : _ze_context_handle_t {
     ze_result_t createCommandList(ze_device_handle_t hDevice,
                                   const ze_command_list_desc_t *desc,
                                   ze_command_list_handle_t *commandList);
+    ze_result_t createCommandListImmediate(ze_device_handle_t hDevice,
+                                           const ze_command_queue_desc_t *altdesc,
+                                           ze_command_list_handle_t *commandList);
     ze_result_t createEventPool(const ze_event_pool_desc_t *desc,
                                 uint32_t numDevices,
                                 ze_device_handle_t *phDevices,
@@ -75,6 +75,32 @@ ze_result_t Device::createCommandList(const ze_command_list_desc_t *desc,
     return returnValue;
 }
 
+ze_result_t Device::createCommandListImmediate(const ze_command_queue_desc_t *altdesc,
+                                               ze_command_list_handle_t *commandList,
+                                               VPU::VPUDeviceContext *ctx) {
+    bool isCopyOnly = false;
+    bool isValid = false;
+    ze_result_t returnValue = ZE_RESULT_SUCCESS;
+
+    if ((altdesc == nullptr) || (commandList == nullptr)) {
+        LOG_E("Command queue descriptor/pointer commandList passed as nullptr.");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    isCopyOnly = isCopyOnlyEngineGroup(altdesc->ordinal, isValid);
+    if (!isValid) {
+        LOG_E("Wrong ordinal value received: Immediate CommandList could not be created");
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    *commandList =
+        CommandList::createImmediate(isCopyOnly,
+                                     altdesc->mode == ZE_COMMAND_QUEUE_MODE_SYNCHRONOUS,
+                                     ctx,
+                                     returnValue);
+    return returnValue;
+}
+
 ze_result_t Device::createCommandQueue(const ze_command_queue_desc_t *desc,
                                        ze_command_queue_handle_t *commandQueue,
                                        VPU::VPUDeviceContext *ctx) {
@@ -448,7 +474,7 @@ void Device::loadDeviceProperties() {
     properties.timestampValidBits = 64u;
 
     // Number of valid bits in the kernel timestamp values.
-    properties.kernelTimestampValidBits = 0u;
+    properties.kernelTimestampValidBits = 64u;
 
     // Device name.
     strncpy(properties.name, hwInfo.name, ZE_MAX_DEVICE_NAME - 1);
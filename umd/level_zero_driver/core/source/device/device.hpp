@@ -39,6 +39,9 @@ struct Device : _ze_device_handle_t {
     ze_result_t createCommandList(const ze_command_list_desc_t *desc,
                                   ze_command_list_handle_t *commandList,
                                   VPU::VPUDeviceContext *ctx);
+    ze_result_t createCommandListImmediate(const ze_command_queue_desc_t *altdesc,
+                                           ze_command_list_handle_t *commandList,
+                                           VPU::VPUDeviceContext *ctx);
     ze_result_t createCommandQueue(const ze_command_queue_desc_t *desc,
                                    ze_command_queue_handle_t *commandQueue,
                                    VPU::VPUDeviceContext *ctx);
@@ -10,9 +10,15 @@
 #include "level_zero_driver/core/source/device/device.hpp"
 #include "level_zero_driver/core/source/driver/driver.hpp"
 
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+#include "vpu_driver/source/utilities/trace_buffer.hpp"
 #include "vpu_driver/source/os_interface/vpu_device_factory.hpp"
+#include "vpu_driver/source/os_interface/os_interface_emulator.hpp"
 #include "vpu_driver/source/os_interface/os_interface_imp.hpp"
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
 
 namespace L0 {
 
@@ -34,11 +40,69 @@ void Driver::initializeEnvVariables() {
     envVariables.sharedForceDeviceAlloc =
         env == nullptr || env[0] == '0' || env[0] == '\0' ? false : true;
 
+    env = getenv("VPU_DRV_BUFFER_CACHE_SIZE");
+    envVariables.bufferCacheSize = env == nullptr ? 0 : strtoul(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_BUFFER_CACHE_ENTRIES");
+    envVariables.bufferCacheEntries = env == nullptr
+                                          ? VPU::VPUBufferCache::Limits().maxBuffersPerSize
+                                          : strtoul(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_SCRATCH_POOL_REGIONS");
+    envVariables.scratchPoolRegions = env == nullptr ? 0 : strtoul(env, nullptr, 10);
+
+    VPU::WaitPolicy waitPolicy;
+    env = getenv("VPU_DRV_WAIT_SPIN_TIME");
+    envVariables.waitSpinTimeUs =
+        env == nullptr ? waitPolicy.spinTimeNs / 1000 : strtoull(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_WAIT_MAX_SLEEP_TIME");
+    envVariables.waitMaxSleepUs =
+        env == nullptr ? waitPolicy.maxSleepNs / 1000 : strtoull(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_WAIT_BLOCK_ON_JOB");
+    envVariables.waitBlockOnJob =
+        env == nullptr ? waitPolicy.blockOnJob : !(env[0] == '0' || env[0] == '\0');
+
+    env = getenv("VPU_DRV_COMPILER_CACHE_DIR");
+    envVariables.compilerCacheDir = env == nullptr ? "" : env;
+
+    env = getenv("VPU_DRV_COMPILER_CACHE_SIZE");
+    envVariables.compilerCacheSize =
+        env == nullptr ? Compiler::defaultBlobCacheSize : strtoul(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_EMULATOR");
+    envVariables.emulator = env == nullptr || env[0] == '0' || env[0] == '\0' ? false : true;
+
+    env = getenv("VPU_DRV_EMULATOR_JOB_LATENCY");
+    envVariables.emulatorJobLatencyUs = env == nullptr ? 0 : strtoull(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_EMULATOR_INFERENCE_LATENCY");
+    envVariables.emulatorInferenceLatencyUs = env == nullptr ? 0 : strtoull(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_EMULATOR_COPY_BANDWIDTH");
+    envVariables.emulatorCopyBandwidth = env == nullptr ? 0 : strtoull(env, nullptr, 10);
+
+    env = getenv("VPU_DRV_IOCTL_STATS_DUMP");
+    envVariables.ioctlStatsDump = env == nullptr || env[0] == '0' || env[0] == '\0' ? false : true;
+
+    env = getenv("VPU_DRV_JOB_TRACE_FILE");
+    envVariables.jobTraceFile = env == nullptr ? "" : env;
+
+    env = getenv("VPU_DRV_CMDBUF_CAPTURE_DIR");
+    envVariables.cmdBufferCaptureDir = env == nullptr ? "" : env;
+
     env = getenv("VPU_DRV_UMD_LOGLEVEL");
     envVariables.umdLogLevel = env == nullptr ? "" : env;
 
     env = getenv("VPU_DRV_CID_LOGLEVEL");
     envVariables.cidLogLevel = env == nullptr ? "" : env;
+
+    env = getenv("VPU_DRV_UMD_TRACE_LEVEL");
+    envVariables.umdTraceLevel = env == nullptr ? "" : env;
+
+    env = getenv("VPU_DRV_UMD_TRACE_FILE");
+    envVariables.umdTraceFile = env == nullptr ? "" : env;
 }
 
 ze_result_t Driver::getInitStatus() {
@@ -50,11 +114,42 @@ void Driver::driverInit(ze_init_flags_t flags) {
     std::call_once(this->initDriverOnce, [&]() {
         initializeEnvVariables();
         VPU::setLogLevel(envVariables.umdLogLevel);
+        VPU::setTraceLevel(envVariables.umdTraceLevel);
+        if (VPU::getTraceLevel() != QUIET)
+            VPU::TraceBuffer::getInstance().enableDumpAtExit(envVariables.umdTraceFile);
         Compiler::setCidLogLevel(envVariables.cidLogLevel);
+        Compiler::setBlobCache(envVariables.compilerCacheDir,
+                               envVariables.compilerCacheSize * 1024 * 1024);
+
+        VPU::WaitPolicy waitPolicy;
+        waitPolicy.spinTimeNs = envVariables.waitSpinTimeUs * 1000;
+        waitPolicy.maxSleepNs = envVariables.waitMaxSleepUs * 1000;
+        waitPolicy.blockOnJob = envVariables.waitBlockOnJob;
+        VPU::setDefaultWaitPolicy(waitPolicy);
+
+        if (envVariables.ioctlStatsDump)
+            VPU::VPUIoctlStats::getInstance().enableDumpAtExit();
+
+        if (!envVariables.jobTraceFile.empty())
+            VPU::VPUJobTracer::getInstance().enableDumpAtExit(envVariables.jobTraceFile);
+
+        VPU::VPUCommandDecoder::setCaptureDirectory(envVariables.cmdBufferCaptureDir);
 
         if (osInfc == nullptr) {
             LOG_V("OS interface updated.");
-            osInfc = &VPU::OsInterfaceImp::getInstance();
+            if (envVariables.emulator) {
+                VPU::OsInterfaceEmulator::LatencyModel latency;
+                latency.jobNs = envVariables.emulatorJobLatencyUs * 1000;
+                latency.inferenceNs = envVariables.emulatorInferenceLatencyUs * 1000;
+                latency.copyBytesPerSec = envVariables.emulatorCopyBandwidth * 1024 * 1024;
+
+                auto &emulator = VPU::OsInterfaceEmulator::getInstance();
+                emulator.setLatencyModel(latency);
+                osInfc = &emulator;
+                LOG_W("Using software VPU emulator instead of the device.");
+            } else {
+                osInfc = &VPU::OsInterfaceImp::getInstance();
+            }
 
             if (osInfc == nullptr) {
                 LOG_E("Failed to initialize (OS interface is null).");
@@ -23,9 +23,36 @@ class Driver {
         bool metrics;
         bool pciIdDeviceOrder;
         bool sharedForceDeviceAlloc;
+        /* Limits of the cache of released user allocations, size in MB, 0 disables the cache */
+        size_t bufferCacheSize;
+        size_t bufferCacheEntries;
+        /* Scratch heap sets shared by graphs of a context, 0 gives each graph its own heaps */
+        size_t scratchPoolRegions;
+        /* Default wait policy of events, queues and fences, times in microseconds */
+        uint64_t waitSpinTimeUs;
+        uint64_t waitMaxSleepUs;
+        bool waitBlockOnJob;
+        /* Location of compiled blob cache, empty disables the cache, size in MB */
+        std::string_view compilerCacheDir;
+        size_t compilerCacheSize;
+        /* Software VPU emulator used instead of the device, latencies in microseconds */
+        bool emulator;
+        uint64_t emulatorJobLatencyUs;
+        uint64_t emulatorInferenceLatencyUs;
+        /* Copy throughput of the emulator in MB/s, 0 does not limit it */
+        uint64_t emulatorCopyBandwidth;
+        /* Print ioctl statistics to stderr at process exit */
+        bool ioctlStatsDump;
+        /* Chrome trace of job lifecycle written at process exit, empty disables tracing */
+        std::string_view jobTraceFile;
+        /* Directory where submitted command buffers are captured, empty disables capturing */
+        std::string_view cmdBufferCaptureDir;
 
         std::string_view umdLogLevel;
         std::string_view cidLogLevel;
+        /* Messages up to this level are traced in memory and dumped to the file at exit */
+        std::string_view umdTraceLevel;
+        std::string_view umdTraceFile;
     };
 
     Driver() { pDriver = this; }
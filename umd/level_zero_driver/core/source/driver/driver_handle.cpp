@@ -9,14 +9,20 @@
 #include "level_zero_driver/core/source/device/device.hpp"
 #include "level_zero_driver/core/source/driver/driver.hpp"
 #include "level_zero_driver/core/source/context/context.hpp"
+#include "level_zero_driver/core/source/cmdqueue/cmdqueue.hpp"
+#include "level_zero_driver/core/source/event/event.hpp"
 #include "level_zero_driver/api/ext/ze_graph.hpp"
 
 #include "driver_version_l0.h"
 #include "vpu_driver/source/device/vpu_device.hpp"
 #include "vpu_driver/source/device/vpu_device_context.hpp"
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
 
 #include <level_zero/ze_ddi.h>
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace L0 {
@@ -40,6 +46,17 @@ ze_result_t DriverHandle::createContext(const ze_context_desc_t *desc,
         return ZE_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
     }
 
+    Driver *pDriver = Driver::getInstance();
+    if (pDriver && pDriver->getEnvVariables().bufferCacheSize > 0) {
+        VPU::VPUBufferCache::Limits limits;
+        limits.maxBytes = pDriver->getEnvVariables().bufferCacheSize << 20;
+        limits.maxBuffersPerSize = pDriver->getEnvVariables().bufferCacheEntries;
+        ctx->setBufferCacheLimits(limits);
+    }
+
+    if (pDriver && pDriver->getEnvVariables().scratchPoolRegions > 0)
+        ctx->setScratchPoolRegions(pDriver->getEnvVariables().scratchPoolRegions);
+
     Context *context = new Context(this, std::move(ctx));
     if (nullptr == context) {
         LOG_E("Failed to create Context");
@@ -188,6 +205,102 @@ Device *DriverHandle::getPrimaryDevice() {
     return nullptr;
 }
 
+static ze_result_t ZE_APICALL zeDriverGetIoctlStatistics(ze_driver_handle_t hDriver,
+                                                         size_t *pSize,
+                                                         char *pReport) {
+    if (hDriver == nullptr) {
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    }
+    return DriverHandle::fromHandle(hDriver)->getIoctlStatistics(pSize, pReport);
+}
+
+ze_result_t DriverHandle::getIoctlStatistics(size_t *pSize, char *pReport) {
+    if (pSize == nullptr) {
+        LOG_E("Invalid pSize pointer.");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    std::string report = VPU::VPUIoctlStats::getInstance().getReport();
+    if (pReport == nullptr) {
+        *pSize = report.size() + 1;
+        return ZE_RESULT_SUCCESS;
+    }
+
+    if (*pSize == 0) {
+        LOG_E("Invalid report size.");
+        return ZE_RESULT_ERROR_INVALID_SIZE;
+    }
+
+    // Report that does not fit is truncated
+    size_t size = std::min(*pSize - 1, report.size());
+    memcpy(pReport, report.data(), size);
+    pReport[size] = '\0';
+    *pSize = size + 1;
+    return ZE_RESULT_SUCCESS;
+}
+
+static VPU::WaitPolicy toWaitPolicy(const ze_vpu_wait_policy_ext_t &policy) {
+    VPU::WaitPolicy waitPolicy;
+    waitPolicy.spinTimeNs = policy.spinTimeNs;
+    waitPolicy.minSleepNs = policy.minSleepNs;
+    waitPolicy.maxSleepNs = policy.maxSleepNs;
+    waitPolicy.blockOnJob = policy.blockOnJob;
+    return waitPolicy;
+}
+
+static void toWaitStatistics(const VPU::WaitStatistics &stats,
+                             ze_vpu_wait_statistics_ext_t *pStatistics) {
+    pStatistics->waitCount = stats.getWaitCount();
+    pStatistics->cpuTimeNs = stats.getCpuTimeNs();
+    pStatistics->wallTimeNs = stats.getWallTimeNs();
+    pStatistics->cpuTimePerWaitNs = stats.getCpuTimePerWaitNs();
+}
+
+static ze_result_t ZE_APICALL zeCommandQueueSetWaitPolicy(ze_command_queue_handle_t hCommandQueue,
+                                                          const ze_vpu_wait_policy_ext_t *pPolicy) {
+    if (hCommandQueue == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    if (pPolicy == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    CommandQueue::fromHandle(hCommandQueue)->setWaitPolicy(toWaitPolicy(*pPolicy));
+    return ZE_RESULT_SUCCESS;
+}
+
+static ze_result_t ZE_APICALL
+zeCommandQueueGetWaitStatistics(ze_command_queue_handle_t hCommandQueue,
+                                ze_vpu_wait_statistics_ext_t *pStatistics) {
+    if (hCommandQueue == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    if (pStatistics == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    toWaitStatistics(CommandQueue::fromHandle(hCommandQueue)->getWaitStatistics(), pStatistics);
+    return ZE_RESULT_SUCCESS;
+}
+
+static ze_result_t ZE_APICALL zeEventSetWaitPolicy(ze_event_handle_t hEvent,
+                                                   const ze_vpu_wait_policy_ext_t *pPolicy) {
+    if (hEvent == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    if (pPolicy == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    Event::fromHandle(hEvent)->setWaitPolicy(toWaitPolicy(*pPolicy));
+    return ZE_RESULT_SUCCESS;
+}
+
+static ze_result_t ZE_APICALL zeEventGetWaitStatistics(ze_event_handle_t hEvent,
+                                                       ze_vpu_wait_statistics_ext_t *pStatistics) {
+    if (hEvent == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_HANDLE;
+    if (pStatistics == nullptr)
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+
+    toWaitStatistics(Event::fromHandle(hEvent)->getWaitStatistics(), pStatistics);
+    return ZE_RESULT_SUCCESS;
+}
+
 ze_result_t DriverHandle::getExtensionFunctionAddress(const char *name, void **ppFunctionAddress) {
     if (name == nullptr || ppFunctionAddress == nullptr) {
         LOG_E("Invalid name or ppFunctionAddress pointer.");
@@ -206,6 +319,21 @@ ze_result_t DriverHandle::getExtensionFunctionAddress(const char *name, void **p
         table.pfnAppendGraphExecute = L0::zeAppendGraphExecute;
         table.pfnDeviceGetGraphProperties = L0::zeDeviceGetGraphProperties;
         *ppFunctionAddress = reinterpret_cast<void *>(&table);
+    } else if (strcmp(name, ZE_VPU_GRAPH_CREATE_FROM_FILE_EXT_NAME) == 0) {
+        static ze_vpu_graph_create_from_file_dditable_ext_t table;
+        table.pfnCreateFromFile = L0::zeGraphCreateFromFile;
+        table.pfnCreateFromFd = L0::zeGraphCreateFromFd;
+        *ppFunctionAddress = reinterpret_cast<void *>(&table);
+    } else if (strcmp(name, ZE_VPU_GRAPH_ASYNC_CREATE_EXT_NAME) == 0) {
+        static ze_vpu_graph_async_create_dditable_ext_t table;
+        table.pfnCreateAsync = L0::zeGraphCreateAsync;
+        table.pfnCreationSynchronize = L0::zeGraphCreationSynchronize;
+        table.pfnCreationQueryStatus = L0::zeGraphCreationQueryStatus;
+        *ppFunctionAddress = reinterpret_cast<void *>(&table);
+    } else if (strcmp(name, ZE_VPU_GRAPH_EXECUTE_BATCH_EXT_NAME) == 0) {
+        static ze_vpu_graph_execute_batch_dditable_ext_t table;
+        table.pfnAppendGraphExecuteBatch = L0::zeAppendGraphExecuteBatch;
+        *ppFunctionAddress = reinterpret_cast<void *>(&table);
     } else if (strncmp(name, ZE_PROFILING_DATA_EXT_NAME, strlen(ZE_PROFILING_DATA_EXT_NAME)) == 0) {
         static ze_graph_profiling_dditable_ext_t table;
         table.pfnProfilingPoolCreate = L0::zeGraphProfilingPoolCreate;
@@ -215,6 +343,15 @@ ze_result_t DriverHandle::getExtensionFunctionAddress(const char *name, void **p
         table.pfnProfilingQueryGetData = L0::zeGraphProfilingQueryGetData;
         table.pfnDeviceGetProfilingDataProperties = L0::zeDeviceGetProfilingDataProperties;
         *ppFunctionAddress = reinterpret_cast<void *>(&table);
+    } else if (strcmp(name, ZE_VPU_IOCTL_STATISTICS_EXT_NAME) == 0) {
+        *ppFunctionAddress = reinterpret_cast<void *>(&zeDriverGetIoctlStatistics);
+    } else if (strcmp(name, ZE_VPU_WAIT_POLICY_EXT_NAME) == 0) {
+        static ze_vpu_wait_policy_dditable_ext_t table;
+        table.pfnCommandQueueSetWaitPolicy = zeCommandQueueSetWaitPolicy;
+        table.pfnCommandQueueGetWaitStatistics = zeCommandQueueGetWaitStatistics;
+        table.pfnEventSetWaitPolicy = zeEventSetWaitPolicy;
+        table.pfnEventGetWaitStatistics = zeEventGetWaitStatistics;
+        *ppFunctionAddress = reinterpret_cast<void *>(&table);
     } else {
         LOG_E("The name of extension is unknown: %s", name);
         return ZE_RESULT_ERROR_UNKNOWN;
@@ -14,6 +14,52 @@
 
 struct _ze_driver_handle_t {};
 
+/* Extension returning text report of ioctl statistics, the size includes terminating null */
+#define ZE_VPU_IOCTL_STATISTICS_EXT_NAME "ZE_extension_vpu_ioctl_statistics"
+typedef ze_result_t(ZE_APICALL *ze_pfnDriverGetIoctlStatistics_ext_t)(ze_driver_handle_t hDriver,
+                                                                      size_t *pSize,
+                                                                      char *pReport);
+
+/* Extension setting wait policy of command queues and events and reading their wait statistics */
+#define ZE_VPU_WAIT_POLICY_EXT_NAME "ZE_extension_vpu_wait_policy"
+
+/* Signal is polled for spinTimeNs, then the waiter sleeps with exponential backoff from
+ * minSleepNs to maxSleepNs or blocks in KMD on the signalling job if blockOnJob is set */
+typedef struct _ze_vpu_wait_policy_ext_t {
+    uint64_t spinTimeNs;
+    uint64_t minSleepNs;
+    uint64_t maxSleepNs;
+    ze_bool_t blockOnJob;
+} ze_vpu_wait_policy_ext_t;
+
+/* Statistics accumulated over all host waits on the object */
+typedef struct _ze_vpu_wait_statistics_ext_t {
+    uint64_t waitCount;
+    uint64_t cpuTimeNs;
+    uint64_t wallTimeNs;
+    uint64_t cpuTimePerWaitNs;
+} ze_vpu_wait_statistics_ext_t;
+
+typedef ze_result_t(ZE_APICALL *ze_pfnCommandQueueSetWaitPolicy_ext_t)(
+    ze_command_queue_handle_t hCommandQueue,
+    const ze_vpu_wait_policy_ext_t *pPolicy);
+typedef ze_result_t(ZE_APICALL *ze_pfnCommandQueueGetWaitStatistics_ext_t)(
+    ze_command_queue_handle_t hCommandQueue,
+    ze_vpu_wait_statistics_ext_t *pStatistics);
+typedef ze_result_t(ZE_APICALL *ze_pfnEventSetWaitPolicy_ext_t)(
+    ze_event_handle_t hEvent,
+    const ze_vpu_wait_policy_ext_t *pPolicy);
+typedef ze_result_t(ZE_APICALL *ze_pfnEventGetWaitStatistics_ext_t)(
+    ze_event_handle_t hEvent,
+    ze_vpu_wait_statistics_ext_t *pStatistics);
+
+typedef struct _ze_vpu_wait_policy_dditable_ext_t {
+    ze_pfnCommandQueueSetWaitPolicy_ext_t pfnCommandQueueSetWaitPolicy;
+    ze_pfnCommandQueueGetWaitStatistics_ext_t pfnCommandQueueGetWaitStatistics;
+    ze_pfnEventSetWaitPolicy_ext_t pfnEventSetWaitPolicy;
+    ze_pfnEventGetWaitStatistics_ext_t pfnEventGetWaitStatistics;
+} ze_vpu_wait_policy_dditable_ext_t;
+
 namespace L0 {
 
 struct Device;
@@ -28,6 +74,7 @@ struct DriverHandle : _ze_driver_handle_t {
     ze_result_t getExtensionProperties(uint32_t *pCount,
                                        ze_driver_extension_properties_t *pExtensionProperties);
     ze_result_t getExtensionFunctionAddress(const char *name, void **ppFunctionAddress);
+    ze_result_t getIoctlStatistics(size_t *pSize, char *pReport);
 
     ze_result_t getMemAllocProperties(const void *ptr,
                                       ze_memory_allocation_properties_t *pMemAllocProperties,
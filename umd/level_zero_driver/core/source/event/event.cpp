@@ -11,6 +11,8 @@
 #include "level_zero_driver/core/source/device/device.hpp"
 
 #include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
+#include "vpu_driver/source/device/vpu_device_context.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
 #include "vpu_driver/source/utilities/timer.hpp"
 
@@ -60,9 +62,81 @@ ze_result_t Event::destroy() {
 
 ze_result_t Event::hostSignal() {
     updateSyncState(VPU::VPUEventCommand::STATE_HOST_SIGNAL);
+
+    auto ctx = pEventPool->getDeviceContext();
+    if (ctx != nullptr)
+        ctx->getCompletionNotifier().notify();
     return ZE_RESULT_SUCCESS;
 }
 
+bool Event::waitForJobs(uint64_t timeout) {
+    return VPU::waitForSignal(
+        timeout,
+        [this]() {
+            if (queryStatus() == ZE_RESULT_SUCCESS)
+                return true;
+
+            /*
+             * If there is no job in execution with Event then return to user to avoid waiting
+             * infinitiely. This approach is a hack to break loop that waits infinitely for
+             * inference result in ZeroBackend in VPUX plugin.
+             */
+            for (auto weakPtr : associatedJobs) {
+                std::shared_ptr<VPU::VPUJob> job = weakPtr.lock();
+                if (job.get() != nullptr && !job->waitForCompletion(0)) {
+                    return false;
+                }
+            }
+
+            return true;
+        },
+        waitPolicy,
+        &waitStats,
+        [this](int64_t timeout_abs_ns) {
+            /*
+             * Block in KMD on the busy jobs that are expected to signal the event. Completed
+             * jobs return without sleeping, so they do not count as blocked.
+             */
+            bool blocked = false;
+            for (auto weakPtr : associatedJobs) {
+                std::shared_ptr<VPU::VPUJob> job = weakPtr.lock();
+                if (job.get() == nullptr || job->waitForCompletion(0))
+                    continue;
+                if (!job->waitForCompletion(timeout_abs_ns))
+                    return false;
+                blocked = true;
+            }
+            return blocked;
+        });
+}
+
+bool Event::waitForNotification(uint64_t timeout) {
+    auto ctx = pEventPool->getDeviceContext();
+    if (ctx == nullptr)
+        return VPU::waitForSignal(
+            timeout,
+            [this]() { return queryStatus() == ZE_RESULT_SUCCESS; },
+            waitPolicy,
+            &waitStats);
+
+    /*
+     * The signalling job is not known, sleep on futex until the event is signalled by host or
+     * any job of the context completes.
+     */
+    auto &notifier = ctx->getCompletionNotifier();
+    return VPU::waitForSignal(
+        timeout,
+        [this]() { return queryStatus() == ZE_RESULT_SUCCESS; },
+        waitPolicy,
+        &waitStats,
+        [this, &notifier](int64_t timeout_abs_ns) {
+            uint32_t seq = notifier.getSequence();
+            if (queryStatus() == ZE_RESULT_SUCCESS)
+                return true;
+            return notifier.wait(seq, timeout_abs_ns);
+        });
+}
+
 ze_result_t Event::hostSynchronize(uint64_t timeout) {
     /* Remove dangling weak pointers */
     associatedJobs.erase(std::remove_if(associatedJobs.begin(),
@@ -70,26 +144,12 @@ ze_result_t Event::hostSynchronize(uint64_t timeout) {
                                         [](auto x) { return x.use_count() == 0; }),
                          associatedJobs.end());
 
-    bool signaled = VPU::waitForSignal(timeout, [this]() {
-        if (queryStatus() == ZE_RESULT_SUCCESS)
-            return true;
-
-        /*
-         * If there is no job in execution with Event then return to user to avoid waiting
-         * infinitiely. This approach is a hack to break loop that waits infinitely for
-         * inference result in ZeroBackend in VPUX plugin.
-         */
-        for (auto weakPtr : associatedJobs) {
-            std::shared_ptr<VPU::VPUJob> job = weakPtr.lock();
-            if (job.get() != nullptr && !job->waitForCompletion(0)) {
-                return false;
-            }
-        }
-
-        return true;
-    });
+    bool signaled = associatedJobs.empty() ? waitForNotification(timeout) : waitForJobs(timeout);
 
-    LOG_I("Sync completed. Time: %ld, signaled: %u", timeout, signaled);
+    LOG_I("Sync completed. Time: %ld, signaled: %u, CPU time per wait: %lu ns",
+          timeout,
+          signaled,
+          waitStats.getCpuTimePerWaitNs());
     /*
      * 'queryStatus()' is used instead of 'signaled' beause waitForSignal can return true when
      * there all jobs are finished
@@ -113,6 +173,7 @@ ze_result_t Event::queryStatus() {
         return ZE_RESULT_SUCCESS;
     case VPU::VPUEventCommand::STATE_DEVICE_SIGNAL:
         LOG_V("Sync point %p has been signaled by device.", pSyncPointer);
+        traceJobsCompletion();
         return ZE_RESULT_SUCCESS;
     default:
         LOG_E("Unexpected sync value. (%lx)", *pSyncPointer);
@@ -120,8 +181,44 @@ ze_result_t Event::queryStatus() {
     }
 }
 
+void Event::traceJobsCompletion() {
+    if (!VPU::VPUJobTracer::isEnabled())
+        return;
+
+    for (auto weakPtr : associatedJobs) {
+        std::shared_ptr<VPU::VPUJob> job = weakPtr.lock();
+        if (job.get() != nullptr)
+            job->waitForCompletion(0);
+    }
+}
+
+ze_result_t Event::queryKernelTimestamp(ze_kernel_timestamp_result_t *dstptr) {
+    if (dstptr == nullptr) {
+        LOG_E("Invalid kernel timestamp result pointer.");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    if (!isKernelTimestampEvent()) {
+        LOG_E("Event pool of event %p was not created with ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP",
+              this);
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    ze_result_t result = queryStatus();
+    if (result != ZE_RESULT_SUCCESS)
+        return result;
+
+    /* VPU does not distinguish global and context timestamps */
+    dstptr->global.kernelStart = *getKernelStartPointer();
+    dstptr->global.kernelEnd = *getKernelEndPointer();
+    dstptr->context = dstptr->global;
+    return ZE_RESULT_SUCCESS;
+}
+
 ze_result_t Event::reset() {
     updateSyncState(VPU::VPUEventCommand::STATE_HOST_RESET);
+    *getKernelStartPointer() = 0;
+    *getKernelEndPointer() = 0;
     return ZE_RESULT_SUCCESS;
 }
 
@@ -9,6 +9,7 @@
 
 #include "level_zero_driver/core/source/event/eventpool.hpp"
 #include "level_zero_driver/core/source/device/device.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
 
 #include <level_zero/ze_api.h>
 #include <memory>
@@ -33,13 +34,49 @@ struct Event : _ze_event_handle_t {
     ze_result_t hostSignal();
     ze_result_t hostSynchronize(uint64_t timeout);
     ze_result_t queryStatus();
+    ze_result_t queryKernelTimestamp(ze_kernel_timestamp_result_t *dstptr);
     ze_result_t reset();
 
     inline VPU::VPUEventCommand::KMDEventDataType *getSyncPointer() const { return pSyncPointer; }
 
+    /**
+     * @brief Return true if the event records timestamps around the command that signals it.
+     */
+    bool isKernelTimestampEvent() const { return pEventPool->isKernelTimestampPool(); }
+
+    /**
+     * @brief Pointers to start and end timestamp stored in the event slot of the event pool.
+     */
+    uint64_t *getKernelStartPointer() const { return &getEventData()->kernelStart; }
+    uint64_t *getKernelEndPointer() const { return &getEventData()->kernelEnd; }
+
     void associateJob(std::weak_ptr<VPU::VPUJob> job) { associatedJobs.push_back(std::move(job)); }
 
+    void setWaitPolicy(const VPU::WaitPolicy &policy) { waitPolicy = policy; }
+    const VPU::WaitStatistics &getWaitStatistics() const { return waitStats; }
+
   private:
+    VPU::VPUEventCommand::JsmEventData *getEventData() const {
+        return reinterpret_cast<VPU::VPUEventCommand::JsmEventData *>(pSyncPointer);
+    }
+
+    /**
+     * @brief Wait for the event, block on associated jobs after spin time.
+     */
+    bool waitForJobs(uint64_t timeout);
+
+    /**
+     * @brief Wait for the event that is not associated with any job, sleep on completion
+     * notifier of the device context after spin time.
+     */
+    bool waitForNotification(uint64_t timeout);
+
+    /**
+     * @brief Let the job tracer see completion of associated jobs when the device signal is read
+     * from event memory, the jobs may not be waited for otherwise.
+     */
+    void traceJobsCompletion();
+
     /**
      * @brief Change sync state.
      * @param updateTo [in] Target status to be changed.
@@ -65,6 +102,9 @@ struct Event : _ze_event_handle_t {
      * @brief Jobs that uses the event.
      */
     std::vector<std::weak_ptr<VPU::VPUJob>> associatedJobs;
+
+    VPU::WaitPolicy waitPolicy = VPU::getDefaultWaitPolicy();
+    VPU::WaitStatistics waitStats;
 };
 
 } // namespace L0
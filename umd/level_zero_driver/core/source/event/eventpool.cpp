@@ -66,6 +66,7 @@ EventPool::EventPool(DriverHandle *driver,
     , ctx(ctx)
     , pEventPool(nullptr)
     , szEventCap(numEvents)
+    , flags(flags)
     , szEventAllocated(0)
     , allocationTable(szEventCap, std::make_pair(nullptr, false)) {}
 
@@ -53,6 +53,13 @@ struct EventPool : _ze_event_pool_handle_t {
      */
     uint32_t getEventPoolCapability() const { return szEventCap; }
 
+    VPU::VPUDeviceContext *getDeviceContext() const { return ctx; }
+
+    /**
+     * Return true if events of the pool record kernel timestamps.
+     */
+    bool isKernelTimestampPool() const { return flags & ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP; }
+
     /**
      * Allocate a event from the event pool.
      */
@@ -84,6 +91,11 @@ struct EventPool : _ze_event_pool_handle_t {
      */
     uint32_t szEventCap = 0;
 
+    /**
+     * Event pool creation flags.
+     */
+    ze_event_pool_flags_t flags = 0;
+
     /**
      * Currently allocated event size.
      */
@@ -45,7 +45,11 @@ ze_result_t Fence::hostSynchronize(uint64_t timeout) {
     if (vpuDevice == nullptr)
         return ZE_RESULT_ERROR_DEVICE_LOST;
 
-    bool allSignaled = waitForSignal(timeout, trackedJobs, vpuDevice->getHwInfo());
+    bool allSignaled = waitForSignal(timeout,
+                                     trackedJobs,
+                                     vpuDevice->getHwInfo(),
+                                     cmdQueue->getWaitPolicy(),
+                                     &cmdQueue->getWaitStatistics());
     if (!allSignaled) {
         LOG_W("Commands execution is not finished");
         return ZE_RESULT_NOT_READY;
@@ -9,17 +9,154 @@
 #include "vpu_driver/source/utilities/log.hpp"
 
 #include <boost/numeric/conversion/cast.hpp>
+#include <map>
+#include <mutex>
 #include <string.h>
 
 namespace L0 {
 
 uint32_t Compiler::cidLogLevel = 0;
+std::unique_ptr<VPU::VPUDiskCache> Compiler::blobCache = nullptr;
+
+void Compiler::setBlobCache(std::string_view directory, size_t maxBytes) {
+    if (directory.empty() || maxBytes == 0) {
+        blobCache.reset();
+        return;
+    }
+
+    std::string path(directory);
+    LOG_I("Compiled blob cache in %s, limit %lu bytes", path.c_str(), maxBytes);
+    blobCache = std::make_unique<VPU::VPUDiskCache>(path, maxBytes);
+}
 
 #ifdef ENABLE_VPUX_COMPILER
 
 #include "VPUXCompilerL0.h"
 
-static bool getCompilerExecutable(vcl_compiler_handle_t &comp,
+/**
+   Compiler instances of single platform kept for reuse. Instance is created when all pooled
+   ones are in use and it returns to the pool after the compilation, so each instance is used by
+   one thread at a time. At most maxIdle instances are kept, further ones are destroyed on
+   release. Compiler properties are read once and served from the pool afterwards.
+ */
+class CompilerPool {
+  public:
+    /* Compiler instance holds large state, keep only a few for the next compilations */
+    static constexpr size_t maxIdle = 2;
+
+    explicit CompilerPool(vcl_platform_t platform)
+        : platform(platform) {}
+
+    CompilerPool(const CompilerPool &) = delete;
+    CompilerPool &operator=(const CompilerPool &) = delete;
+
+    vcl_compiler_handle_t acquire(uint32_t logLevel) {
+        {
+            const std::lock_guard<std::mutex> lock(mtx);
+            if (!idle.empty()) {
+                vcl_compiler_handle_t compiler = idle.back();
+                idle.pop_back();
+                return compiler;
+            }
+        }
+
+        vcl_compiler_handle_t compiler = NULL;
+        vcl_compiler_desc_t compilerDesc = {platform, logLevel};
+        vcl_result_t ret = vclCompilerCreate(compilerDesc, &compiler);
+        if (ret != VCL_RESULT_SUCCESS) {
+            LOG_E("Failed to create compiler! Result:%x", ret);
+            return NULL;
+        }
+        return compiler;
+    }
+
+    void release(vcl_compiler_handle_t compiler) {
+        {
+            const std::lock_guard<std::mutex> lock(mtx);
+            if (idle.size() < maxIdle) {
+                idle.push_back(compiler);
+                return;
+            }
+        }
+
+        vcl_result_t ret = vclCompilerDestroy(compiler);
+        if (ret != VCL_RESULT_SUCCESS)
+            LOG_W("Failed to destroy compiler! Result:%x", ret);
+    }
+
+    bool getProperties(uint32_t logLevel, vcl_compiler_properties_t &props) {
+        {
+            const std::lock_guard<std::mutex> lock(mtx);
+            if (propertiesValid) {
+                props = properties;
+                return true;
+            }
+        }
+
+        vcl_compiler_handle_t compiler = acquire(logLevel);
+        if (compiler == NULL)
+            return false;
+
+        vcl_result_t ret = vclCompilerGetProperties(compiler, &props);
+        release(compiler);
+        if (ret != VCL_RESULT_SUCCESS) {
+            LOG_E("Failed to get properties from compiler! Result:%x", ret);
+            return false;
+        }
+
+        const std::lock_guard<std::mutex> lock(mtx);
+        properties = props;
+        propertiesValid = true;
+        return true;
+    }
+
+    vcl_platform_t getPlatform() const { return platform; }
+
+  private:
+    const vcl_platform_t platform;
+    std::mutex mtx;
+    std::vector<vcl_compiler_handle_t> idle;
+    bool propertiesValid = false;
+    vcl_compiler_properties_t properties = {};
+};
+
+static CompilerPool &getCompilerPool(vcl_platform_t platform) {
+    // Never destroyed, idle compilers are not released from static destructors at exit
+    static std::mutex poolsMtx;
+    static auto *pools = new std::map<vcl_platform_t, std::unique_ptr<CompilerPool>>;
+
+    const std::lock_guard<std::mutex> lock(poolsMtx);
+    auto &pool = (*pools)[platform];
+    if (pool == nullptr)
+        pool = std::make_unique<CompilerPool>(platform);
+    return *pool;
+}
+
+/**
+   Compiler taken from the pool for the lifetime of the object.
+ */
+class PooledCompiler {
+  public:
+    PooledCompiler(CompilerPool &pool, uint32_t logLevel)
+        : pool(pool)
+        , handle(pool.acquire(logLevel)) {}
+
+    ~PooledCompiler() {
+        if (handle != NULL)
+            pool.release(handle);
+    }
+
+    PooledCompiler(const PooledCompiler &) = delete;
+    PooledCompiler &operator=(const PooledCompiler &) = delete;
+
+    vcl_compiler_handle_t get() const { return handle; }
+
+  private:
+    CompilerPool &pool;
+    vcl_compiler_handle_t handle;
+};
+
+static bool getCompilerExecutable(vcl_compiler_handle_t comp,
                                   vcl_executable_handle_t *exec,
                                   ze_graph_desc_t &desc) {
     std::string options = "";
@@ -42,23 +179,51 @@ static bool getCompilerExecutable(vcl_compiler_handle_t &comp,
     return true;
 }
 
+static std::string
+getBlobCacheKey(CompilerPool &pool, uint32_t logLevel, const ze_graph_desc_t &desc) {
+    vcl_compiler_properties_t properties;
+    if (!pool.getProperties(logLevel, properties)) {
+        LOG_W("Failed to get compiler properties, blob cache is skipped.");
+        return "";
+    }
+
+    // Compiler id carries the build, blobs of rebuilt compilers of same version differ
+    std::string_view buildFlags = desc.pBuildFlags != nullptr ? desc.pBuildFlags : "";
+    std::string_view compilerId = properties.id != nullptr ? properties.id : "";
+    return VPU::VPUDiskCache::Key()
+        .add(desc.pInput, desc.inputSize)
+        .add(buildFlags)
+        .add(compilerId)
+        .add(static_cast<uint64_t>(properties.version.major))
+        .add(static_cast<uint64_t>(properties.version.minor))
+        .add(static_cast<uint64_t>(properties.supportedOpsets))
+        .add(static_cast<uint64_t>(pool.getPlatform()))
+        .str();
+}
+
 bool Compiler::getCompiledBlob(size_t &graphSize,
                                std::vector<uint8_t> &graphBlob,
                                ze_graph_desc_t &desc) {
-    vcl_compiler_handle_t compiler = NULL;
     vcl_result_t ret = VCL_RESULT_SUCCESS;
-    vcl_compiler_desc_t compilerDesc = {VCL_PLATFORM_VPU3720, cidLogLevel};
+    CompilerPool &pool = getCompilerPool(VCL_PLATFORM_VPU3720);
+
+    std::string cacheKey;
+    if (blobCache != nullptr) {
+        cacheKey = getBlobCacheKey(pool, cidLogLevel, desc);
+        if (!cacheKey.empty() && blobCache->load(cacheKey, graphBlob)) {
+            LOG_V("Compiled blob %s loaded from cache", cacheKey.c_str());
+            graphSize = graphBlob.size();
+            return true;
+        }
+    }
 
-    ret = vclCompilerCreate(compilerDesc, &compiler);
-    if (ret != VCL_RESULT_SUCCESS) {
-        LOG_E("Failed to create compiler! Result:%x", ret);
+    PooledCompiler compiler(pool, cidLogLevel);
+    if (compiler.get() == NULL)
         return false;
-    }
 
     vcl_executable_handle_t executable;
-    if (!getCompilerExecutable(compiler, &executable, desc)) {
+    if (!getCompilerExecutable(compiler.get(), &executable, desc)) {
         LOG_E("Failed to get compiler executable!");
-        vclCompilerDestroy(compiler);
         return false;
     }
 
@@ -66,7 +231,6 @@ bool Compiler::getCompiledBlob(size_t &graphSize,
     if (ret != VCL_RESULT_SUCCESS || graphSize == 0) {
         LOG_E("Failed to get blob size! Result:%x", ret);
         vclExecutableDestroy(executable);
-        vclCompilerDestroy(compiler);
         return false;
     }
 
@@ -75,53 +239,40 @@ bool Compiler::getCompiledBlob(size_t &graphSize,
     if (ret != VCL_RESULT_SUCCESS) {
         LOG_E("Failed to get blob! Result:%x", ret);
         vclExecutableDestroy(executable);
-        vclCompilerDestroy(compiler);
         return false;
     }
 
     vclExecutableDestroy(executable);
-    vclCompilerDestroy(compiler);
+
+    if (!cacheKey.empty())
+        blobCache->store(cacheKey, graphBlob);
 
     return true;
 }
 
 bool Compiler::getCompilerProperties(ze_device_graph_properties_t *pDeviceGraphProperties) {
-    vcl_compiler_desc_t compilerDesc = {VCL_PLATFORM_VPU3720, 0};
-    vcl_compiler_handle_t compiler;
     vcl_compiler_properties_t properties;
-
-    auto ret = vclCompilerCreate(compilerDesc, &compiler);
-    if (ret) {
-        LOG_E("Failed to create compiler! Result:%x", ret);
+    if (!getCompilerPool(VCL_PLATFORM_VPU3720).getProperties(cidLogLevel, properties))
         return false;
-    }
-
-    ret = vclCompilerGetProperties(compiler, &properties);
-    if (ret) {
-        LOG_E("Failed to get properties from compiler! Result:%x", ret);
-        vclCompilerDestroy(compiler);
-        return false;
-    }
 
     pDeviceGraphProperties->compilerVersion.major = properties.version.major;
     pDeviceGraphProperties->compilerVersion.minor = properties.version.minor;
     pDeviceGraphProperties->graphFormatsSupported = ZE_GRAPH_FORMAT_NGRAPH_LITE;
     pDeviceGraphProperties->maxOVOpsetVersionSupported = properties.supportedOpsets;
 
-    vclCompilerDestroy(compiler);
-
     return true;
 }
 
 ze_result_t Compiler::getDecodedProfilingBuffer(ze_graph_profiling_type_t profilingType,
-                                                const std::vector<uint8_t> *blobRaw,
+                                                const uint8_t *blobData,
+                                                size_t blobSize,
                                                 const uint8_t *profData,
                                                 uint64_t profSize,
                                                 uint32_t *pSize,
                                                 void *pData) {
     vcl_profiling_handle_t profHandle = nullptr;
-    vcl_profiling_input_t profilingApiInput = {.blobData = blobRaw->data(),
-                                               .blobSize = blobRaw->size(),
+    vcl_profiling_input_t profilingApiInput = {.blobData = blobData,
+                                               .blobSize = blobSize,
                                                .profData = profData,
                                                .profSize = profSize};
 
@@ -168,7 +319,8 @@ bool Compiler::getCompilerProperties(ze_device_graph_properties_t *pDeviceGraphP
 }
 
 ze_result_t Compiler::getDecodedProfilingBuffer(ze_graph_profiling_type_t profilingType,
-                                                const std::vector<uint8_t> *blobRaw,
+                                                const uint8_t *blobData,
+                                                size_t blobSize,
                                                 const uint8_t *profData,
                                                 uint64_t profSize,
                                                 uint32_t *size,
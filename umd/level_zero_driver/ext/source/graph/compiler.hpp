@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include "vpu_driver/source/utilities/disk_cache.hpp"
+
 #include <level_zero/ze_graph_ext.h>
+#include <memory>
 #include <string>
 
 #include <vector>
@@ -15,11 +18,15 @@
 namespace L0 {
 class Compiler {
   public:
+    /* Default size limit of compiled blob cache in MB */
+    static constexpr size_t defaultBlobCacheSize = 1024;
+
     static bool
     getCompiledBlob(size_t &graphSize, std::vector<uint8_t> &graphBlob, ze_graph_desc_t &desc);
     static bool getCompilerProperties(ze_device_graph_properties_t *pDeviceGraphProperties);
     static ze_result_t getDecodedProfilingBuffer(ze_graph_profiling_type_t profilingType,
-                                                 const std::vector<uint8_t> *blobRaw,
+                                                 const uint8_t *blobData,
+                                                 size_t blobSize,
                                                  const uint8_t *profData,
                                                  uint64_t profSize,
                                                  uint32_t *size,
@@ -41,8 +48,14 @@ class Compiler {
         }
     }
 
+    /**
+       Enable cache of compiled blobs in given directory, empty directory disables the cache.
+     */
+    static void setBlobCache(std::string_view directory, size_t maxBytes);
+
   private:
     static uint32_t cidLogLevel;
+    static std::unique_ptr<VPU::VPUDiskCache> blobCache;
 };
 
 } // namespace L0
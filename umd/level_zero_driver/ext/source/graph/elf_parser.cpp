@@ -14,7 +14,12 @@
 
 #include <algorithm>
 #include <boost/numeric/conversion/cast.hpp>
+#include <deque>
 #include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string.h>
 #include <vpux_elf/utils/error.hpp>
 #include <vpux_elf/accessor.hpp>
@@ -33,7 +38,19 @@ class DriverBufferManager : public elf::BufferManager {
   public:
     DriverBufferManager(VPU::VPUDeviceContext *context)
         : ctx(context) {}
-    ~DriverBufferManager() override = default;
+    ~DriverBufferManager() override {
+        for (auto &[ptr, section] : sharedSections) {
+            for (size_t i = 0; i < section.refCount; i++) {
+                if (!ctx->releaseSharedBufferObject(section.bo))
+                    LOG_E("Failed to release shared section");
+            }
+        }
+
+        for (auto &[type, arena] : arenas) {
+            if (!ctx->freeMemAlloc(arena.bo))
+                LOG_E("Failed to free section arena");
+        }
+    }
 
     VPU::VPUBufferObject::Type getBufferType(elf::Elf_Xword flag) {
         if (flag & elf::SHF_EXECINSTR)
@@ -42,6 +59,74 @@ class DriverBufferManager : public elf::BufferManager {
         return VPU::VPUBufferObject::Type::CachedHigh;
     }
 
+    static size_t getPlacementAlignment(elf::Elf_Xword alignment) {
+        // Sections do not share firmware data cache lines
+        return std::max<size_t>(alignment, VPU::VPUSlabAllocator::minBlockSize);
+    }
+
+    /**
+       Find constant sections that are shared with other graphs of the device context. Section
+       is constant if it has content, it is not writable and no relocation targets it. Small
+       sections are left to the arena, they would cost a buffer object handle per section.
+     */
+    void planSections(elf::ElfDDRAccessManager *elfAccess) {
+        elf::Reader<elf::ELF_Bitness::Elf64> reader(elfAccess);
+
+        std::set<size_t> relocatedSections;
+        for (size_t i = 0; i < reader.getSectionsNum(); i++) {
+            const auto *header = reader.getSection(i).getHeader();
+            if (header->sh_type == elf::SHT_RELA || header->sh_type == elf::VPU_SHT_JIT_RELA)
+                relocatedSections.insert(header->sh_info);
+        }
+
+        for (size_t i = 0; i < reader.getSectionsNum(); i++) {
+            const auto &section = reader.getSection(i);
+            const auto *header = section.getHeader();
+            bool constant = header->sh_type == elf::SHT_PROGBITS &&
+                            (header->sh_flags & elf::SHF_ALLOC) &&
+                            !(header->sh_flags & elf::SHF_WRITE) &&
+                            !VPU::VPUSlabAllocator::isSupportedSize(header->sh_size) &&
+                            relocatedSections.count(i) == 0;
+            plannedSections.push_back({i,
+                                       header->sh_size,
+                                       header->sh_flags,
+                                       header->sh_addralign,
+                                       constant ? section.getData<uint8_t>() : nullptr});
+        }
+    }
+
+    /**
+       Allocate one arena buffer per buffer type that fits all allocated sections of the ELF, so
+       the loader places sections in few buffer objects instead of a buffer object per section.
+     */
+    void reserveArenas() {
+        std::map<VPU::VPUBufferObject::Type, size_t> arenaSizes;
+
+        for (const auto &section : plannedSections) {
+            if (!(section.flags & elf::SHF_ALLOC) || section.size == 0 ||
+                section.sharedData != nullptr)
+                continue;
+
+            size_t alignment = getPlacementAlignment(section.alignment);
+            size_t &arenaSize = arenaSizes[getBufferType(section.flags)];
+            arenaSize = ALIGN(arenaSize, alignment) + section.size;
+        }
+
+        for (const auto &[type, size] : arenaSizes) {
+            VPU::VPUBufferObject *bo = ctx->createInternalBufferObject(size, type);
+            if (bo == nullptr) {
+                LOG_W("Failed to allocate section arena of %#lx bytes", size);
+                continue;
+            }
+
+            LOG_I("Section arena: type: %i, vpu_addr: %#lx, size: %#lx",
+                  static_cast<int>(type),
+                  bo->getVPUAddr(),
+                  bo->getAllocSize());
+            arenas[type] = {bo, 0};
+        }
+    }
+
     elf::DeviceBuffer allocate(const elf::BufferSpecs &buffSpecs) override {
         LOG_I("Allocate: size: %#lx, alignment: %#lx, procFlags: %#lx",
               buffSpecs.size,
@@ -54,8 +139,47 @@ class DriverBufferManager : public elf::BufferManager {
             size = 1;
         }
 
+        std::optional<PlannedSection> planned = takePlannedSection(buffSpecs);
+        const uint8_t *sharedData = planned ? planned->sharedData : nullptr;
+        if (sharedData != nullptr) {
+            auto type = getBufferType(buffSpecs.procFlags);
+            VPU::VPUBufferObject *bo = ctx->acquireSharedBufferObject(sharedData, size, type);
+            if (bo != nullptr && buffSpecs.alignment > 1 &&
+                bo->getVPUAddr() % buffSpecs.alignment != 0) {
+                ctx->releaseSharedBufferObject(bo);
+                bo = nullptr;
+            }
+
+            if (bo != nullptr) {
+                // Identical sections of one blob get the same buffer, each holds a reference
+                auto &section = sharedSections[bo->getBasePointer()];
+                section = {bo, sharedData, section.refCount + 1};
+                return elf::DeviceBuffer(bo->getBasePointer(), bo->getVPUAddr(), buffSpecs.size);
+            }
+            LOG_W("Failed to share constant section, private buffer is allocated");
+        }
+
+        auto it = arenas.find(getBufferType(buffSpecs.procFlags));
+        if (it != arenas.end()) {
+            Arena &arena = it->second;
+            size_t alignment = getPlacementAlignment(buffSpecs.alignment);
+            size_t offset = ALIGN(arena.offset, alignment);
+            bool aligned = (arena.bo->getVPUAddr() + offset) % alignment == 0;
+            if (aligned && offset + size <= arena.bo->getAllocSize()) {
+                arena.offset = offset + size;
+                if (planned)
+                    sectionAddresses[planned->index] = arena.bo->getBasePointer() + offset;
+                return elf::DeviceBuffer(arena.bo->getBasePointer() + offset,
+                                         arena.bo->getVPUAddr() + offset,
+                                         buffSpecs.size);
+            }
+            LOG_W("Section does not fit in the arena, separate buffer is allocated");
+        }
+
+        // Slab blocks guarantee only firmware data cache alignment
+        bool suballocate = buffSpecs.alignment <= VPU::VPUSlabAllocator::minBlockSize;
         VPU::VPUBufferObject *bo =
-            ctx->createInternalBufferObject(size, getBufferType(buffSpecs.procFlags));
+            ctx->createInternalBufferObject(size, getBufferType(buffSpecs.procFlags), suballocate);
         if (bo == nullptr) {
             LOG_E("Failed to allocate the memory");
             return elf::DeviceBuffer();
@@ -65,6 +189,8 @@ class DriverBufferManager : public elf::BufferManager {
               bo->getBasePointer(),
               bo->getVPUAddr(),
               bo->getAllocSize());
+        if (planned)
+            sectionAddresses[planned->index] = bo->getBasePointer();
         return elf::DeviceBuffer(bo->getBasePointer(), bo->getVPUAddr(), buffSpecs.size);
     }
 
@@ -73,6 +199,15 @@ class DriverBufferManager : public elf::BufferManager {
               devAddress.cpu_addr(),
               devAddress.vpu_addr(),
               devAddress.size());
+        // Shared sections and arena are released with the manager
+        if (sharedSections.count(devAddress.cpu_addr()))
+            return;
+
+        for (const auto &[type, arena] : arenas) {
+            if (arena.bo->isInRange(devAddress.cpu_addr()))
+                return;
+        }
+
         if (!ctx->freeMemAlloc(devAddress.cpu_addr()))
             LOG_E("Failed to deallocate the memory");
     }
@@ -92,13 +227,25 @@ class DriverBufferManager : public elf::BufferManager {
             return 0;
         }
 
+        // Content of shared section is filled by the graph that created it
+        auto sharedIt = sharedSections.find(to.cpu_addr());
+        if (sharedIt != sharedSections.end()) {
+            if (sharedIt->second.data != from && memcmp(to.cpu_addr(), from, count) != 0) {
+                LOG_E("Loader copies unexpected data to shared section");
+                return 0;
+            }
+            return count;
+        }
+
         VPU::VPUBufferObject *bo = ctx->findBuffer(to.cpu_addr());
         if (bo == nullptr) {
             LOG_E("Failed to find a buffer");
             return 0;
         }
 
-        if (!bo->copyToBuffer(from, count, 0)) {
+        // Section can be placed in the middle of the arena
+        uint64_t offset = static_cast<uint64_t>(to.cpu_addr() - bo->getBasePointer());
+        if (!bo->copyToBuffer(from, count, offset)) {
             LOG_E("Failed to copy a buffer");
             return 0;
         }
@@ -106,22 +253,170 @@ class DriverBufferManager : public elf::BufferManager {
         return count;
     }
 
+    /**
+       @return CPU address of section placed in private buffer or arena, nullptr if the section
+       is shared or it was not matched with the allocation
+     */
+    uint8_t *getSectionAddress(size_t index) const {
+        auto it = sectionAddresses.find(index);
+        return it == sectionAddresses.end() ? nullptr : it->second;
+    }
+
   private:
+    struct PlannedSection {
+        size_t index;
+        elf::Elf_Xword size;
+        elf::Elf_Xword flags;
+        elf::Elf_Xword alignment;
+        /* Content of constant section, nullptr if the section is private to the graph */
+        const uint8_t *sharedData;
+    };
+
+    struct SharedSection {
+        VPU::VPUBufferObject *bo;
+        const uint8_t *data;
+        size_t refCount;
+    };
+
+    struct Arena {
+        VPU::VPUBufferObject *bo;
+        size_t offset;
+    };
+
+    /**
+       Loader allocates sections in order of section headers. Planned sections before the one
+       that matches the allocation were skipped by the loader and are dropped.
+       @return matching section or std::nullopt
+     */
+    std::optional<PlannedSection> takePlannedSection(const elf::BufferSpecs &buffSpecs) {
+        auto it = std::find_if(plannedSections.begin(),
+                               plannedSections.end(),
+                               [&buffSpecs](const PlannedSection &section) {
+                                   return section.size == buffSpecs.size &&
+                                          section.flags == buffSpecs.procFlags;
+                               });
+        if (it == plannedSections.end())
+            return std::nullopt;
+
+        PlannedSection section = *it;
+        plannedSections.erase(plannedSections.begin(), std::next(it));
+        return section;
+    }
+
     VPU::VPUDeviceContext *ctx;
+    std::deque<PlannedSection> plannedSections;
+    std::map<const void *, SharedSection> sharedSections;
+    std::map<VPU::VPUBufferObject::Type, Arena> arenas;
+    /* Section index to CPU address of private placement */
+    std::map<size_t, uint8_t *> sectionAddresses;
+};
+
+struct ElfParser::InferenceInstance {
+    /* Site in loaded section that holds address of graph argument */
+    struct JitRelocation {
+        uint8_t *site;
+        elf::Elf_Word type;
+        elf::Elf_Sxword addend;
+    };
+
+    InferenceInstance(VPU::VPUDeviceContext *ctx)
+        : ctx(ctx) {}
+    ~InferenceInstance() {
+        if (hostParsedInference && !ctx->freeMemAlloc(hostParsedInference))
+            LOG_E("Failed to free hostParsedInference memory");
+    }
+
+    VPU::VPUDeviceContext *ctx;
+    /* Loader is destroyed first, it deallocates sections through the manager */
+    std::unique_ptr<DriverBufferManager> manager;
+    std::unique_ptr<elf::VPUXLoader> loader;
+    /* Buffer objects of loaded sections */
+    std::vector<VPU::VPUBufferObject *> sectionBuffers;
+    VPU::VPUBufferObject *hostParsedInference = nullptr;
+    std::vector<VPU::VPUBufferObject *> userBuffers;
+    /* VPU address and size of inputs followed by outputs applied to relocations */
+    std::vector<std::pair<uint64_t, uint32_t>> boundArguments;
+    /* JIT relocation sites per argument, empty if the table could not be built */
+    std::vector<std::vector<JitRelocation>> jitRelocations;
+};
+
+/*
+ * Instances are bound to commands for the lifetime of the command, so the pool can not make a
+ * command wait for another one. Instead at most maxIdle instances are kept when commands are
+ * destroyed, further ones are freed. The first instance is never freed, it serves the graph
+ * properties.
+ */
+struct ElfParser::InstancePool {
+    static constexpr size_t maxIdle = 2;
+
+    InferenceInstance *add(std::unique_ptr<InferenceInstance> instance, bool isIdle) {
+        const std::lock_guard<std::mutex> lock(mtx);
+        InferenceInstance *ptr = instances.emplace_back(std::move(instance)).get();
+        if (isIdle)
+            idle.push_back(ptr);
+        return ptr;
+    }
+
+    InferenceInstance *take() {
+        const std::lock_guard<std::mutex> lock(mtx);
+        if (idle.empty())
+            return nullptr;
+
+        InferenceInstance *instance = idle.back();
+        idle.pop_back();
+        return instance;
+    }
+
+    void release(InferenceInstance *instance) {
+        std::unique_ptr<InferenceInstance> extra;
+        {
+            const std::lock_guard<std::mutex> lock(mtx);
+            if (idle.size() < maxIdle || instance == instances.front().get()) {
+                idle.push_back(instance);
+                return;
+            }
+
+            auto it = std::find_if(instances.begin(), instances.end(), [instance](auto &ptr) {
+                return ptr.get() == instance;
+            });
+            extra = std::move(*it);
+            instances.erase(it);
+        }
+        // Buffers of the instance are freed outside of the lock
+        LOG_I("Inference instance %p is freed, %lu idle instances are kept", extra.get(), maxIdle);
+    }
+
+    /* Instance loaded with the parser, it is used to read graph properties */
+    InferenceInstance *getFirst() const {
+        const std::lock_guard<std::mutex> lock(mtx);
+        return instances.front().get();
+    }
+
+    size_t getCount() const {
+        const std::lock_guard<std::mutex> lock(mtx);
+        return instances.size();
+    }
+
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<InferenceInstance>> instances;
+    std::vector<InferenceInstance *> idle;
 };
 
 ElfParser::ElfParser(VPU::VPUDeviceContext *ctx,
-                     std::unique_ptr<elf::BufferManager> manager,
-                     std::unique_ptr<elf::VPUXLoader> loader)
+                     std::unique_ptr<elf::ElfDDRAccessManager> elfAccess,
+                     uint32_t nnSliceCount,
+                     std::unique_ptr<InferenceInstance> instance)
     : ctx(ctx)
-    , manager(std::move(manager))
-    , loader(std::move(loader))
-    , hostParsedInference(nullptr) {}
+    , elfAccess(std::move(elfAccess))
+    , nnSliceCount(nnSliceCount)
+    , pool(std::make_shared<InstancePool>()) {
+    pool->add(std::move(instance), true);
+}
 
-ElfParser::~ElfParser() {
-    if (hostParsedInference)
-        if (!ctx->freeMemAlloc(hostParsedInference))
-            LOG_E("Failed to free hostParsedInference memory");
+ElfParser::~ElfParser() = default;
+
+size_t ElfParser::getInstanceCount() const {
+    return pool->getCount();
 }
 
 static elf::ResourceRequirements readResourcesFromElf(elf::ElfDDRAccessManager *elfAccess) {
@@ -150,25 +445,164 @@ static elf::ResourceRequirements readResourcesFromElf(elf::ElfDDRAccessManager *
     throw std::runtime_error("Failed to find a resource");
 }
 
+std::unique_ptr<ElfParser::InferenceInstance>
+ElfParser::loadInstance(VPU::VPUDeviceContext *ctx,
+                        elf::ElfDDRAccessManager *elfAccess,
+                        uint32_t nnSliceCount) {
+    auto instance = std::make_unique<InferenceInstance>(ctx);
+    instance->manager = std::make_unique<DriverBufferManager>(ctx);
+
+    try {
+        instance->manager->planSections(elfAccess);
+        instance->manager->reserveArenas();
+        instance->loader =
+            std::make_unique<elf::VPUXLoader>(elfAccess,
+                                              instance->manager.get(),
+                                              elf::SymTabGen::symTab(nnSliceCount));
+    } catch (const elf::RuntimeError &err) {
+        LOG_E("Failed to create elf::VPUXLoader, type: elf::RuntimeError, reason: %s", err.what());
+        return nullptr;
+    } catch (const elf::LogicError &err) {
+        LOG_E("Failed to create elf::VPUXLoader, type: elf::LogicError, reason: %s", err.what());
+        return nullptr;
+    }
+
+    /*
+     * All associated buffer objects needs to be added to command. Thanks to it kernel pin pages
+     */
+    for (const auto &buffer : instance->loader->getAllocatedBuffers()) {
+        if (buffer.size() == 0)
+            continue;
+
+        VPU::VPUBufferObject *bo = ctx->findBuffer(buffer.cpu_addr());
+        if (bo == nullptr) {
+            LOG_E("Failed to find a buffer in tracked memory");
+            return nullptr;
+        }
+
+        // Sections placed in one arena share the buffer object
+        auto &bos = instance->sectionBuffers;
+        if (std::find(bos.begin(), bos.end(), bo) == bos.end())
+            bos.push_back(bo);
+    }
+
+    bool jitTableBuilt = false;
+    try {
+        jitTableBuilt = buildJitRelocations(elfAccess, *instance);
+    } catch (const elf::RuntimeError &err) {
+        LOG_W("Failed to read JIT relocations, type: elf::RuntimeError, reason: %s", err.what());
+    } catch (const elf::LogicError &err) {
+        LOG_W("Failed to read JIT relocations, type: elf::LogicError, reason: %s", err.what());
+    }
+
+    if (!jitTableBuilt)
+        LOG_W("JIT relocations are applied in full for every change of arguments");
+
+    addArtificalBarrierConfig(*instance->loader);
+    return instance;
+}
+
+bool ElfParser::buildJitRelocations(elf::ElfDDRAccessManager *elfAccess,
+                                    InferenceInstance &instance) {
+    auto metadata = instance.loader->getNetworkMetadata();
+    size_t inputCount = metadata.in_tenosr_count;
+    size_t outputCount = metadata.out_tensor_count;
+    std::vector<std::vector<InferenceInstance::JitRelocation>> relocations(inputCount +
+                                                                           outputCount);
+
+    elf::Reader<elf::ELF_Bitness::Elf64> reader(elfAccess);
+    for (size_t i = 0; i < reader.getSectionsNum(); i++) {
+        const auto &section = reader.getSection(i);
+        const auto *header = section.getHeader();
+        if (header->sh_type != elf::VPU_SHT_JIT_RELA)
+            continue;
+
+        // Symbols of the linked table are the inputs or the outputs in order
+        auto symTabFlags = reader.getSection(header->sh_link).getHeader()->sh_flags;
+        size_t firstArg = 0;
+        size_t argCount = 0;
+        if (symTabFlags & elf::VPU_SHF_USERINPUT) {
+            argCount = inputCount;
+        } else if (symTabFlags & elf::VPU_SHF_USEROUTPUT) {
+            firstArg = inputCount;
+            argCount = outputCount;
+        } else {
+            LOG_W("JIT relocation section %zu does not target user arguments", i);
+            return false;
+        }
+
+        uint8_t *target = instance.manager->getSectionAddress(header->sh_info);
+        size_t targetSize = reader.getSection(header->sh_info).getHeader()->sh_size;
+        if (target == nullptr) {
+            LOG_W("Target section %u of JIT relocations is not placed", header->sh_info);
+            return false;
+        }
+
+        const auto *entries = section.getData<elf::RelocationAEntry>();
+        for (size_t j = 0; j < section.getEntriesNum(); j++) {
+            auto type = elf::elf64RType(entries[j].r_info);
+            auto symIdx = elf::elf64RSym(entries[j].r_info);
+            size_t width = type == elf::R_VPU_64 ? sizeof(uint64_t) : sizeof(uint32_t);
+
+            // Read-modify-write relocations depend on previous content of the site
+            if ((type != elf::R_VPU_64 && type != elf::R_VPU_32) || symIdx == 0 ||
+                symIdx > argCount || entries[j].r_offset + width > targetSize) {
+                LOG_W("Unsupported JIT relocation, type: %u, symbol: %lu", type, symIdx);
+                return false;
+            }
+
+            // Symbol 0 is the undefined symbol of the table
+            relocations[firstArg + symIdx - 1].push_back(
+                {target + entries[j].r_offset, type, entries[j].r_addend});
+        }
+    }
+
+    instance.jitRelocations = std::move(relocations);
+    return true;
+}
+
+void ElfParser::patchJitRelocations(InferenceInstance &instance,
+                                    const std::vector<std::pair<uint64_t, uint32_t>> &arguments) {
+    for (size_t i = 0; i < arguments.size(); i++) {
+        if (arguments[i].first == instance.boundArguments[i].first)
+            continue;
+
+        for (const auto &reloc : instance.jitRelocations[i]) {
+            uint64_t value = arguments[i].first + static_cast<uint64_t>(reloc.addend);
+            if (reloc.type == elf::R_VPU_64) {
+                memcpy(reloc.site, &value, sizeof(value));
+            } else {
+                uint32_t value32 = static_cast<uint32_t>(value);
+                memcpy(reloc.site, &value32, sizeof(value32));
+            }
+        }
+    }
+}
+
 std::optional<ElfParser>
 ElfParser::getElfParser(VPU::VPUDeviceContext *ctx, uint8_t *ptr, size_t size) {
-    elf::SymTabGen::initSymTab();
-    auto bufferManager = std::make_unique<DriverBufferManager>(ctx);
+    // Symbol table is shared by all parsers, graphs can be created from many threads
+    static std::once_flag symTabInitialized;
+    std::call_once(symTabInitialized, [] { elf::SymTabGen::initSymTab(); });
+    // Blob is accessed by every instance loaded later
     auto elfAccess = std::make_unique<elf::ElfDDRAccessManager>(ptr, size);
 
+    uint32_t nnSliceCount = 0;
     try {
-        auto resReq = readResourcesFromElf(elfAccess.get());
-        auto loader =
-            std::make_unique<elf::VPUXLoader>(elfAccess.get(),
-                                              bufferManager.get(),
-                                              elf::SymTabGen::symTab(resReq.nn_slice_count_));
-        return ElfParser(ctx, std::move(bufferManager), std::move(loader));
+        nnSliceCount = readResourcesFromElf(elfAccess.get()).nn_slice_count_;
     } catch (const elf::RuntimeError &err) {
-        LOG_E("Failed to create elf::VPUXLoader, type: elf::RuntimeError, reason: %s", err.what());
+        LOG_E("Failed to read resources, type: elf::RuntimeError, reason: %s", err.what());
+        return std::nullopt;
     } catch (const elf::LogicError &err) {
-        LOG_E("Failed to create elf::VPUXLoader, type: elf::LogicError, reason: %s", err.what());
+        LOG_E("Failed to read resources, type: elf::LogicError, reason: %s", err.what());
+        return std::nullopt;
     }
-    return std::nullopt;
+
+    auto instance = loadInstance(ctx, elfAccess.get(), nnSliceCount);
+    if (instance == nullptr)
+        return std::nullopt;
+
+    return ElfParser(ctx, std::move(elfAccess), nnSliceCount, std::move(instance));
 }
 
 ze_graph_argument_precision_t ElfParser::getTensorPrecision(elf::DType type) {
@@ -308,7 +742,7 @@ static ze_graph_argument_layout_t getDeviceLayout(const elf::TensorRef &tensor)
 }
 
 void ElfParser::getArgumentProperties(std::vector<ze_graph_argument_properties_t> &props) const {
-    auto metadata = loader->getNetworkMetadata();
+    auto metadata = pool->getFirst()->loader->getNetworkMetadata();
 
     props.reserve(metadata.in_tenosr_count + metadata.out_tensor_count);
 
@@ -350,10 +784,15 @@ void ElfParser::getArgumentProperties(std::vector<ze_graph_argument_properties_t
 }
 
 bool ElfParser::applyInputOutputs(
+    InferenceInstance &instance,
     const std::vector<std::pair<const void *, uint32_t>> &inputPtrs,
     const std::vector<std::pair<const void *, uint32_t>> &outputPtrs) {
-    auto getDeviceBuffers = [this](const std::vector<std::pair<const void *, uint32_t>> &ptrs,
-                                   std::vector<elf::DeviceBuffer> &buffers) {
+    using ArgumentPointers = std::vector<std::pair<const void *, uint32_t>>;
+    std::vector<std::pair<uint64_t, uint32_t>> arguments;
+    arguments.reserve(inputPtrs.size() + outputPtrs.size());
+
+    auto getDeviceBuffers = [this, &instance, &arguments](const ArgumentPointers &ptrs,
+                                                          std::vector<elf::DeviceBuffer> &buffers) {
         buffers.reserve(ptrs.size());
 
         for (const auto &[ptr, size] : ptrs) {
@@ -363,16 +802,20 @@ bool ElfParser::applyInputOutputs(
                 return false;
             }
 
-            userBuffers.push_back(bo);
+            instance.userBuffers.push_back(bo);
 
-            uint64_t vpuAddr = ctx->getBufferVPUAddress(ptr);
             uint8_t *basePtr = static_cast<uint8_t *>(const_cast<void *>(ptr));
+            uint64_t vpuAddr = bo->getVPUAddr() + (basePtr - bo->getBasePointer());
             buffers.emplace_back(basePtr, vpuAddr, size);
+            arguments.emplace_back(vpuAddr, size);
         }
 
         return true;
     };
 
+    // Instance is rebound, buffers of previous arguments are not used anymore
+    instance.userBuffers.clear();
+
     std::vector<elf::DeviceBuffer> inputs;
     if (!getDeviceBuffers(inputPtrs, inputs))
         return false;
@@ -381,16 +824,30 @@ bool ElfParser::applyInputOutputs(
     if (!getDeviceBuffers(outputPtrs, outputs))
         return false;
 
-    loader->applyJitRelocations(inputs, outputs);
+    // Sections still hold relocations of the same arguments from previous binding
+    if (arguments == instance.boundArguments) {
+        LOG_I("Arguments of inference instance did not change, relocations are skipped");
+        return true;
+    }
+
+    // Sites of changed arguments are patched once all of them were written by the loader
+    if (instance.jitRelocations.size() == arguments.size() &&
+        instance.boundArguments.size() == arguments.size()) {
+        patchJitRelocations(instance, arguments);
+    } else {
+        instance.boundArguments.clear();
+        instance.loader->applyJitRelocations(inputs, outputs);
+    }
+    instance.boundArguments = std::move(arguments);
 
     return true;
 }
 
-void ElfParser::addArtificalBarrierConfig() {
+void ElfParser::addArtificalBarrierConfig(elf::VPUXLoader &loader) {
     /* TODO: Termporary WA to allow elf execution when barrierConfigs is not defined*/
-    auto vpuAddr = loader->getEntry();
+    auto vpuAddr = loader.getEntry();
 
-    for (const auto &buf : loader->getAllocatedBuffers()) {
+    for (const auto &buf : loader.getAllocatedBuffers()) {
         if (buf.vpu_addr() == vpuAddr) {
             uint8_t *ptr = const_cast<uint8_t *>(buf.cpu_addr());
             auto *mappedInference = reinterpret_cast<nn_public::VpuMappedInference *>(ptr);
@@ -464,43 +921,19 @@ static void printMappedInference(nn_public::VpuMappedInference *mi) {
           static_cast<uint8_t>(mi->shv_rt_configs.dpu_perf_mode));
 }
 
-std::shared_ptr<VPU::VPUInferenceExecute> ElfParser::getCommand(uint64_t inferenceId) {
-    /*
-     * All associated buffer objects needs to be added to command. Thanks to it kernel pin pages
-     */
-    std::vector<VPU::VPUBufferObject *> bos;
-    for (const auto &buffer : loader->getAllocatedBuffers()) {
-        if (buffer.size() == 0)
-            continue;
-
-        VPU::VPUBufferObject *bo = ctx->findBuffer(buffer.cpu_addr());
-        if (bo == nullptr) {
-            LOG_E("Failed to find a buffer in tracked memory");
-            return nullptr;
-        }
-
-        bos.push_back(bo);
-    }
-
-    addArtificalBarrierConfig();
-
-    hostParsedInference = ctx->createInternalBufferObject(
+bool ElfParser::initializeHostParsedInference(InferenceInstance &instance) {
+    instance.hostParsedInference = ctx->createInternalBufferObject(
         getFwDataCacheAlign(sizeof(nn_public::VpuHostParsedInference)),
         VPU::VPUBufferObject::Type::CachedLow);
-    if (hostParsedInference == nullptr) {
+    if (instance.hostParsedInference == nullptr) {
         LOG_E("Failed to allocate Host Parsed Inference buffer");
-        return nullptr;
+        return false;
     }
 
-    bos.push_back(hostParsedInference);
-
-    for (auto *bo : userBuffers)
-        bos.push_back(bo);
-
     auto *hpi = reinterpret_cast<nn_public::VpuHostParsedInference *>(
-        hostParsedInference->getBasePointer());
+        instance.hostParsedInference->getBasePointer());
 
-    auto resource = loader->getResourceRequirements();
+    auto resource = instance.loader->getResourceRequirements();
     hpi->resource_requirements_ = {};
     /* TODO: Below three fields should not be passed */
     // hpi->resource_requirements_.nn_slice_length_ = resource.nn_slice_length_;
@@ -511,7 +944,7 @@ std::shared_ptr<VPU::VPUInferenceExecute> ElfParser::getCommand(uint64_t inferen
 
     hpi->performance_metrics_ = {};
 
-    hpi->mapped_.address = loader->getEntry();
+    hpi->mapped_.address = instance.loader->getEntry();
     hpi->mapped_.count = 1;
 
     LOG_I("HostParsedInference->resource_requirements_\n"
@@ -531,17 +964,53 @@ std::shared_ptr<VPU::VPUInferenceExecute> ElfParser::getCommand(uint64_t inferen
           hpi->mapped_.address,
           hpi->mapped_.count);
 
-    for (const auto &bo : bos) {
+    for (const auto &bo : instance.sectionBuffers) {
         if (bo->getVPUAddr() == hpi->mapped_.address) {
             printMappedInference(
                 reinterpret_cast<nn_public::VpuMappedInference *>(bo->getBasePointer()));
         }
     }
 
-    return VPU::VPUInferenceExecute::create(inferenceId,
-                                            hostParsedInference->getVPUAddr(),
-                                            hostParsedInference->getAllocSize(),
-                                            bos);
+    return true;
+}
+
+std::shared_ptr<VPU::VPUInferenceExecute>
+ElfParser::getCommand(uint64_t inferenceId,
+                      const std::vector<std::pair<const void *, uint32_t>> &inputs,
+                      const std::vector<std::pair<const void *, uint32_t>> &outputs) {
+    InferenceInstance *instance = pool->take();
+    if (instance == nullptr) {
+        auto newInstance = loadInstance(ctx, elfAccess.get(), nnSliceCount);
+        if (newInstance == nullptr) {
+            LOG_E("Failed to load inference instance");
+            return nullptr;
+        }
+
+        instance = pool->add(std::move(newInstance), false);
+        LOG_I("All inference instances are in use, instance %lu is loaded", getInstanceCount());
+    }
+
+    if (!applyInputOutputs(*instance, inputs, outputs) ||
+        (instance->hostParsedInference == nullptr && !initializeHostParsedInference(*instance))) {
+        pool->release(instance);
+        return nullptr;
+    }
+
+    std::vector<VPU::VPUBufferObject *> bos = instance->sectionBuffers;
+    bos.push_back(instance->hostParsedInference);
+    bos.insert(bos.end(), instance->userBuffers.begin(), instance->userBuffers.end());
+
+    // Instance is bound to the command until the command is destroyed
+    auto *cmd = new VPU::VPUInferenceExecute(inferenceId,
+                                             instance->hostParsedInference->getVPUAddr(),
+                                             instance->hostParsedInference->getAllocSize(),
+                                             bos);
+    return std::shared_ptr<VPU::VPUInferenceExecute>(
+        cmd,
+        [pool = pool, instance](VPU::VPUInferenceExecute *cmd) {
+            delete cmd;
+            pool->release(instance);
+        });
 }
 
 } // namespace L0
@@ -14,56 +14,75 @@
 
 #include <cstdint>
 #include <memory>
+#include <vpux_elf/accessor.hpp>
 #include <vpux_loader/vpux_loader.hpp>
 
 namespace L0 {
 
+/**
+   Loaded ELF graph. Every execution command gets own inference instance, that is the graph
+   loaded with private copy of relocatable sections and own host parsed inference. Instances
+   are pooled, so many commands of the graph can be in flight with different arguments.
+ */
 class ElfParser {
   public:
+    struct InferenceInstance;
+    struct InstancePool;
+
     ElfParser(VPU::VPUDeviceContext *ctx,
-              std::unique_ptr<elf::BufferManager> manager,
-              std::unique_ptr<elf::VPUXLoader> loader);
+              std::unique_ptr<elf::ElfDDRAccessManager> elfAccess,
+              uint32_t nnSliceCount,
+              std::unique_ptr<InferenceInstance> instance);
     ~ElfParser();
 
     ElfParser(const ElfParser &rhs) = delete;
     ElfParser operator=(const ElfParser &rhs) = delete;
-    ElfParser(ElfParser &&rhs)
-        : ctx(rhs.ctx)
-        , manager(std::move(rhs.manager))
-        , loader(std::move(rhs.loader))
-        , hostParsedInference(rhs.hostParsedInference) {
-        rhs.ctx = nullptr;
-        rhs.hostParsedInference = nullptr;
-    }
-    ElfParser &operator=(ElfParser &&rhs) {
-        ctx = rhs.ctx;
-        manager = std::move(rhs.manager);
-        loader = std::move(rhs.loader);
-        hostParsedInference = rhs.hostParsedInference;
-        rhs.ctx = nullptr;
-        rhs.hostParsedInference = nullptr;
-        return *this;
-    }
+    ElfParser(ElfParser &&rhs) = default;
+    ElfParser &operator=(ElfParser &&rhs) = default;
 
     static std::optional<ElfParser>
     getElfParser(VPU::VPUDeviceContext *ctx, uint8_t *ptr, size_t size);
 
     void getArgumentProperties(std::vector<ze_graph_argument_properties_t> &props) const;
 
-    bool applyInputOutputs(const std::vector<std::pair<const void *, uint32_t>> &inputs,
-                           const std::vector<std::pair<const void *, uint32_t>> &outputs);
+    /**
+       Bind arguments to idle inference instance, new instance is loaded if all are in use.
+       The instance is returned to the pool when the command is destroyed, or freed if enough
+       instances are idle already.
+     */
+    std::shared_ptr<VPU::VPUInferenceExecute>
+    getCommand(uint64_t inferenceId,
+               const std::vector<std::pair<const void *, uint32_t>> &inputs,
+               const std::vector<std::pair<const void *, uint32_t>> &outputs);
 
-    std::shared_ptr<VPU::VPUInferenceExecute> getCommand(uint64_t inferenceId);
+    size_t getInstanceCount() const;
 
   private:
-    void addArtificalBarrierConfig();
+    static std::unique_ptr<InferenceInstance>
+    loadInstance(VPU::VPUDeviceContext *ctx,
+                 elf::ElfDDRAccessManager *elfAccess,
+                 uint32_t nnSliceCount);
+    /**
+       Collect sites of JIT relocations per argument, so arguments that change are patched
+       without applying all relocations again. Table is left empty when any relocation can not
+       be patched in place.
+     */
+    static bool buildJitRelocations(elf::ElfDDRAccessManager *elfAccess,
+                                    InferenceInstance &instance);
+    static void patchJitRelocations(InferenceInstance &instance,
+                                    const std::vector<std::pair<uint64_t, uint32_t>> &arguments);
+    bool applyInputOutputs(InferenceInstance &instance,
+                           const std::vector<std::pair<const void *, uint32_t>> &inputs,
+                           const std::vector<std::pair<const void *, uint32_t>> &outputs);
+    bool initializeHostParsedInference(InferenceInstance &instance);
+    static void addArtificalBarrierConfig(elf::VPUXLoader &loader);
     static ze_graph_argument_precision_t getTensorPrecision(elf::DType type);
 
     VPU::VPUDeviceContext *ctx;
-    std::unique_ptr<elf::BufferManager> manager;
-    std::unique_ptr<elf::VPUXLoader> loader;
-    VPU::VPUBufferObject *hostParsedInference;
-    std::vector<VPU::VPUBufferObject *> userBuffers;
+    std::unique_ptr<elf::ElfDDRAccessManager> elfAccess;
+    uint32_t nnSliceCount;
+    /* Shared with commands, an instance can outlive the parser */
+    std::shared_ptr<InstancePool> pool;
 };
 
 } // namespace L0
@@ -17,6 +17,7 @@
 #include "vpu_driver/source/utilities/log.hpp"
 
 #include <boost/numeric/conversion/cast.hpp>
+#include <chrono>
 
 namespace L0 {
 Graph::Graph(VPU::VPUDeviceContext *pCtx, const ze_graph_desc_t *pDesc)
@@ -27,6 +28,51 @@ ze_result_t Graph::create(const ze_context_handle_t hContext,
                           const ze_device_handle_t hDevice,
                           const ze_graph_desc_t *pDesc,
                           ze_graph_handle_t *phGraph) {
+    return createGraph(hContext, pDesc, nullptr, phGraph);
+}
+
+ze_result_t Graph::createFromFile(const ze_context_handle_t hContext,
+                                  const ze_device_handle_t hDevice,
+                                  const ze_graph_desc_t *pDesc,
+                                  const char *pPath,
+                                  ze_graph_handle_t *phGraph) {
+    if (pDesc == nullptr || pPath == nullptr) {
+        LOG_E("Invalid graph descriptor or file path");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    auto blobFile = VPU::VPUMappedFile::open(pPath);
+    if (blobFile == nullptr) {
+        LOG_E("Failed to map graph file %s", pPath);
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    return createGraph(hContext, pDesc, std::move(blobFile), phGraph);
+}
+
+ze_result_t Graph::createFromFd(const ze_context_handle_t hContext,
+                                const ze_device_handle_t hDevice,
+                                const ze_graph_desc_t *pDesc,
+                                int fd,
+                                ze_graph_handle_t *phGraph) {
+    if (pDesc == nullptr) {
+        LOG_E("Invalid graph descriptor");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    auto blobFile = VPU::VPUMappedFile::map(fd);
+    if (blobFile == nullptr) {
+        LOG_E("Failed to map graph file descriptor %d", fd);
+        return ZE_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    return createGraph(hContext, pDesc, std::move(blobFile), phGraph);
+}
+
+ze_result_t Graph::createGraph(const ze_context_handle_t hContext,
+                               const ze_graph_desc_t *pDesc,
+                               std::unique_ptr<VPU::VPUMappedFile> blobFile,
+                               ze_graph_handle_t *phGraph) {
     if (pDesc == nullptr) {
         LOG_E("Invalid graph descriptor");
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
@@ -49,6 +95,13 @@ ze_result_t Graph::create(const ze_context_handle_t hContext,
         return ZE_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
+    // Mapped file replaces the input, it is parsed in place instead of being copied
+    if (blobFile != nullptr) {
+        pGraph->desc.pInput = blobFile->data();
+        pGraph->desc.inputSize = blobFile->size();
+        pGraph->blobFile = std::move(blobFile);
+    }
+
     ze_result_t ret = pGraph->initialize();
     if (ret != ZE_RESULT_SUCCESS) {
         LOG_E("Graph initialization failed, destroying graph object");
@@ -61,9 +114,77 @@ ze_result_t Graph::create(const ze_context_handle_t hContext,
     return ZE_RESULT_SUCCESS;
 }
 
+VPU::VPUThreadPool &Graph::getCreationThreadPool() {
+    // Never destroyed, static teardown must not join workers of creations still queued
+    static VPU::VPUThreadPool *pool = new VPU::VPUThreadPool;
+    return *pool;
+}
+
+ze_result_t Graph::createAsync(const ze_context_handle_t hContext,
+                               const ze_device_handle_t hDevice,
+                               const ze_graph_desc_t *pDesc,
+                               ze_graph_handle_t *phGraph) {
+    if (pDesc == nullptr) {
+        LOG_E("Invalid graph descriptor");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    if (phGraph == nullptr) {
+        LOG_E("Invalid graph pointer to handle");
+        return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
+    }
+
+    auto pCtx = Context::fromHandle(hContext)->getDeviceContext();
+    if (pCtx == nullptr) {
+        LOG_E("Device Context failed to be retrieved");
+        return ZE_RESULT_ERROR_UNINITIALIZED;
+    }
+
+    Graph *pGraph = new Graph(pCtx, pDesc);
+    if (pGraph == nullptr) {
+        LOG_E("Failed to allocate Graph object");
+        return ZE_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    // Caller may release the input when the call returns
+    if (pDesc->pInput != nullptr) {
+        pGraph->inputCopy.assign(pDesc->pInput, pDesc->pInput + pDesc->inputSize);
+        pGraph->desc.pInput = pGraph->inputCopy.data();
+    }
+    if (pDesc->pBuildFlags != nullptr) {
+        pGraph->buildFlagsCopy = pDesc->pBuildFlags;
+        pGraph->desc.pBuildFlags = pGraph->buildFlagsCopy.c_str();
+    }
+
+    pGraph->creation =
+        getCreationThreadPool().submit([pGraph] { return pGraph->initialize(); }).share();
+
+    *phGraph = pGraph;
+    LOG_I("Graph creation queued - %p", pGraph);
+    return ZE_RESULT_SUCCESS;
+}
+
+ze_result_t Graph::synchronizeCreation(uint64_t timeout) {
+    if (!creation.valid())
+        return ZE_RESULT_SUCCESS;
+
+    // Timeouts that overflow the steady clock are infinite
+    if (timeout > static_cast<uint64_t>(INT64_MAX / 2)) {
+        creation.wait();
+    } else if (creation.wait_for(std::chrono::nanoseconds(timeout)) !=
+               std::future_status::ready) {
+        return ZE_RESULT_NOT_READY;
+    }
+
+    return creation.get();
+}
+
 ze_result_t Graph::destroy() {
     LOG_V("Destroying graph.");
 
+    // Pending initialization accesses the graph
+    waitForCreation();
+
     free(pKernelData);
 
     delete this;
@@ -71,31 +192,39 @@ ze_result_t Graph::destroy() {
 }
 
 ze_result_t Graph::getNativeBinary(size_t *pSize, uint8_t *pGraphNativeBinary) {
+    ze_result_t creationResult = waitForCreation();
+    if (creationResult != ZE_RESULT_SUCCESS)
+        return creationResult;
+
     if (pSize == nullptr) {
         LOG_E("Input size pointer is NULL");
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
     }
 
-    if (graphBlobRaw.size() == 0) {
+    if (getBlobSize() == 0) {
         LOG_E("Graph contain invalid descriptor");
         return ZE_RESULT_ERROR_UNINITIALIZED;
     } else {
-        *pSize = graphBlobRaw.size();
+        *pSize = getBlobSize();
     }
 
     if (pGraphNativeBinary == nullptr) {
         LOG_W("Input Graph Native Binary pointer is NULL");
     } else {
-        if (graphBlobRaw.size() > *pSize) {
-            LOG_E("Failed to copy Graph Native Binary! graphBlobRaw > *pSize");
+        if (getBlobSize() > *pSize) {
+            LOG_E("Failed to copy Graph Native Binary! blob size > *pSize");
             return ZE_RESULT_ERROR_UNKNOWN;
         }
-        memcpy(pGraphNativeBinary, graphBlobRaw.data(), *pSize);
+        memcpy(pGraphNativeBinary, getBlobData(), *pSize);
     }
     return ZE_RESULT_SUCCESS;
 }
 
 ze_result_t Graph::setArgumentValue(uint32_t argIndex, const void *pArgValue) {
+    ze_result_t creationResult = waitForCreation();
+    if (creationResult != ZE_RESULT_SUCCESS)
+        return creationResult;
+
     if (pArgValue == nullptr)
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
 
@@ -110,6 +239,10 @@ ze_result_t Graph::setArgumentValue(uint32_t argIndex, const void *pArgValue) {
 }
 
 ze_result_t Graph::getProperties(ze_graph_properties_t *pGraphProperties) {
+    ze_result_t creationResult = waitForCreation();
+    if (creationResult != ZE_RESULT_SUCCESS)
+        return creationResult;
+
     if (pGraphProperties == nullptr) {
         LOG_E("Invalid pointer.");
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
@@ -121,6 +254,10 @@ ze_result_t Graph::getProperties(ze_graph_properties_t *pGraphProperties) {
 
 ze_result_t Graph::getArgumentProperties(boost::safe_numerics::safe<uint32_t> argIndex,
                                          ze_graph_argument_properties_t *pGraphArgProps) {
+    ze_result_t creationResult = waitForCreation();
+    if (creationResult != ZE_RESULT_SUCCESS)
+        return creationResult;
+
     if (pGraphArgProps == nullptr) {
         LOG_E("Invalid pointer for argument properties.");
         return ZE_RESULT_ERROR_INVALID_NULL_POINTER;
@@ -139,6 +276,10 @@ ze_result_t Graph::getArgumentProperties(boost::safe_numerics::safe<uint32_t> ar
 
 ze_result_t Graph::createProfilingPool(uint32_t count,
                                        ze_graph_profiling_pool_handle_t *phProfilingPool) {
+    ze_result_t creationResult = waitForCreation();
+    if (creationResult != ZE_RESULT_SUCCESS)
+        return creationResult;
+
     if (ctx == nullptr) {
         LOG_E("Context is nullptr!");
         return ZE_RESULT_ERROR_DEVICE_LOST;
@@ -167,8 +308,12 @@ ze_result_t Graph::createProfilingPool(uint32_t count,
         return ZE_RESULT_ERROR_OUT_OF_DEVICE_MEMORY;
     }
 
-    auto *profilingPool =
-        new GraphProfilingPool(ctx, profilingOutputSize, count, profilingPoolBuffer, &graphBlobRaw);
+    auto *profilingPool = new GraphProfilingPool(ctx,
+                                                 profilingOutputSize,
+                                                 count,
+                                                 profilingPoolBuffer,
+                                                 getBlobData(),
+                                                 getBlobSize());
     if (profilingPool == nullptr) {
         LOG_E("Failed to create profiling pool");
         if (!ctx->freeMemAlloc(profilingPoolBuffer))
@@ -294,12 +439,20 @@ ze_result_t Graph::initialize() {
             LOG_E("Failed to get compiled blob!");
             return ZE_RESULT_ERROR_UNKNOWN;
         }
-    } else {
+
+        // Source IR is not needed anymore
+        desc.pInput = nullptr;
+        blobFile.reset();
+        inputCopy = {};
+    } else if (!inputCopy.empty()) {
+        graphBlobRaw = std::move(inputCopy);
+    } else if (blobFile == nullptr) {
         graphBlobRaw.resize(graphSize);
         memcpy(graphBlobRaw.data(), desc.pInput, graphBlobRaw.size());
     }
 
-    elfParser = ElfParser::getElfParser(ctx, graphBlobRaw.data(), graphBlobRaw.size());
+    // Sections are parsed from mapped file in place and copied to buffers by the loader
+    elfParser = ElfParser::getElfParser(ctx, const_cast<uint8_t *>(getBlobData()), getBlobSize());
     if (!elfParser.has_value()) {
         LOG_E("Failed to get Elf executor");
         return ZE_RESULT_ERROR_INVALID_ARGUMENT;
@@ -321,6 +474,11 @@ ze_result_t Graph::initialize() {
 }
 
 std::shared_ptr<VPU::VPUCommand> Graph::allocateGraphInitCommand(VPU::VPUDeviceContext *ctx) {
+    if (waitForCreation() != ZE_RESULT_SUCCESS) {
+        LOG_E("Graph is not initialized");
+        return nullptr;
+    }
+
     struct drm_ivpu_param deviceParameter = {};
 
     if (elfParser.has_value()) {
@@ -348,8 +506,8 @@ std::shared_ptr<VPU::VPUCommand> Graph::allocateGraphInitCommand(VPU::VPUDeviceC
 
     auto cmd = VPU::VPUGraphInitCommand::create(ctx,
                                                 blobId,
-                                                graphBlobRaw.data(),
-                                                graphBlobRaw.size(),
+                                                const_cast<uint8_t *>(getBlobData()),
+                                                getBlobSize(),
                                                 scratchSize,
                                                 metadataSize,
                                                 pKernelData,
@@ -364,13 +522,16 @@ std::shared_ptr<VPU::VPUCommand> Graph::allocateGraphInitCommand(VPU::VPUDeviceC
 
 std::shared_ptr<VPU::VPUCommand> Graph::allocateGraphExecuteCommand(VPU::VPUDeviceContext *ctx,
                                                                     void *profilingQueryPtr) {
+    if (waitForCreation() != ZE_RESULT_SUCCESS) {
+        LOG_E("Graph is not initialized");
+        return nullptr;
+    }
+
     if (elfParser.has_value()) {
-        if (!elfParser->applyInputOutputs(inputArgs, outputArgs)) {
+        auto cmd = elfParser->getCommand(blobId, inputArgs, outputArgs);
+        if (cmd == nullptr)
             LOG_E("Failed to apply inputs and outputs arguments");
-            return nullptr;
-        }
-
-        return elfParser->getCommand(blobId);
+        return cmd;
     }
 
     std::vector<VPU::VPUBufferObject *> graphInitBufferObjects;
@@ -391,4 +552,48 @@ std::shared_ptr<VPU::VPUCommand> Graph::allocateGraphExecuteCommand(VPU::VPUDevi
                                                profilingQueryPtr);
 }
 
+std::vector<std::shared_ptr<VPU::VPUCommand>>
+Graph::allocateGraphExecuteBatchCommands(VPU::VPUDeviceContext *ctx,
+                                         uint32_t batchSize,
+                                         const void *const *ppArgValues,
+                                         const std::vector<void *> &profilingQueryPtrs) {
+    if (waitForCreation() != ZE_RESULT_SUCCESS) {
+        LOG_E("Graph is not initialized");
+        return {};
+    }
+
+    if (!profilingQueryPtrs.empty() && profilingQueryPtrs.size() != batchSize) {
+        LOG_E("Expected %u profiling queries, got %lu", batchSize, profilingQueryPtrs.size());
+        return {};
+    }
+
+    if (!elfParser.has_value()) {
+        LOG_E("Batched execute requires ELF graph");
+        return {};
+    }
+
+    size_t argCount = inputArgs.size() + outputArgs.size();
+    std::vector<std::shared_ptr<VPU::VPUCommand>> commands;
+    commands.reserve(batchSize);
+    for (uint32_t i = 0; i < batchSize; i++) {
+        const void *const *argValues = ppArgValues + i * argCount;
+
+        auto inputs = inputArgs;
+        for (size_t j = 0; j < inputArgs.size(); j++)
+            inputs[j].first = argValues[j];
+
+        auto outputs = outputArgs;
+        for (size_t j = 0; j < outputArgs.size(); j++)
+            outputs[j].first = argValues[inputArgs.size() + j];
+
+        auto cmd = elfParser->getCommand(blobId, inputs, outputs);
+        if (cmd == nullptr) {
+            LOG_E("Failed to apply inputs and outputs arguments");
+            return {};
+        }
+        commands.push_back(std::move(cmd));
+    }
+    return commands;
+}
+
 } // namespace L0
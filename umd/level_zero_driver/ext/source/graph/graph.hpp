@@ -15,12 +15,16 @@
 #include "level_zero_driver/ext/source/graph/compiler.hpp"
 #include "level_zero_driver/ext/source/graph/profiling_data.hpp"
 #include "level_zero_driver/ext/source/graph/elf_parser.hpp"
+#include "vpu_driver/source/utilities/mapped_file.hpp"
+#include "vpu_driver/source/utilities/thread_pool.hpp"
 
 #include <level_zero/ze_api.h>
 #include <level_zero/ze_graph_ext.h>
 
 #include <boost/safe_numerics/safe_integer.hpp>
 #include <cstring>
+#include <future>
+#include <string>
 #include <vector>
 
 struct _ze_graph_handle_t {};
@@ -36,6 +40,34 @@ struct Graph : _ze_graph_handle_t {
                               const ze_device_handle_t hDevice,
                               const ze_graph_desc_t *pDesc,
                               ze_graph_handle_t *phGraph);
+    /**
+       Create graph from a file given by path or descriptor. File is mapped read-only instead of
+       pInput, only format and build flags of the descriptor are used.
+     */
+    static ze_result_t createFromFile(const ze_context_handle_t hContext,
+                                      const ze_device_handle_t hDevice,
+                                      const ze_graph_desc_t *pDesc,
+                                      const char *pPath,
+                                      ze_graph_handle_t *phGraph);
+    static ze_result_t createFromFd(const ze_context_handle_t hContext,
+                                    const ze_device_handle_t hDevice,
+                                    const ze_graph_desc_t *pDesc,
+                                    int fd,
+                                    ze_graph_handle_t *phGraph);
+    /**
+       Create graph handle immediately and initialize the graph on driver thread pool. Graph
+       input and build flags are copied. Use of pending graph waits until it is initialized,
+       destroy is the only call that does not fail when the initialization failed.
+     */
+    static ze_result_t createAsync(const ze_context_handle_t hContext,
+                                   const ze_device_handle_t hDevice,
+                                   const ze_graph_desc_t *pDesc,
+                                   ze_graph_handle_t *phGraph);
+    /**
+       Wait until the graph is initialized.
+       @return ZE_RESULT_NOT_READY on timeout, otherwise the result of the initialization.
+     */
+    ze_result_t synchronizeCreation(uint64_t timeout);
     ze_result_t destroy();
     ze_result_t getNativeBinary(size_t *pSize, uint8_t *pGraphNativeBinary);
     ze_result_t setArgumentValue(uint32_t argIndex, const void *pArgValue);
@@ -57,14 +89,44 @@ struct Graph : _ze_graph_handle_t {
     std::shared_ptr<VPU::VPUCommand> allocateGraphInitCommand(VPU::VPUDeviceContext *ctx);
     std::shared_ptr<VPU::VPUCommand> allocateGraphExecuteCommand(VPU::VPUDeviceContext *ctx,
                                                                  void *profilingQueryPtr);
+    /**
+       Create execute commands for batchSize sets of argument values, each ordered by argument
+       index. Every set gets an inference command of its own instance of the ELF graph.
+       @return empty vector on failure.
+     */
+    std::vector<std::shared_ptr<VPU::VPUCommand>>
+    allocateGraphExecuteBatchCommands(VPU::VPUDeviceContext *ctx,
+                                      uint32_t batchSize,
+                                      const void *const *ppArgValues,
+                                      const std::vector<void *> &profilingQueryPtrs);
 
   private:
+    static ze_result_t createGraph(const ze_context_handle_t hContext,
+                                   const ze_graph_desc_t *pDesc,
+                                   std::unique_ptr<VPU::VPUMappedFile> blobFile,
+                                   ze_graph_handle_t *phGraph);
+    static VPU::VPUThreadPool &getCreationThreadPool();
+    ze_result_t waitForCreation() { return synchronizeCreation(UINT64_MAX); }
+    const uint8_t *getBlobData() const {
+        return blobFile != nullptr ? blobFile->data() : graphBlobRaw.data();
+    }
+    size_t getBlobSize() const {
+        return blobFile != nullptr ? blobFile->size() : graphBlobRaw.size();
+    }
+
     ze_result_t initialize();
     ze_result_t getUserKernelData();
 
     VPU::VPUDeviceContext *ctx;
     ze_graph_desc_t desc;
     std::vector<uint8_t> graphBlobRaw;
+    /* Native blob mapped from a file, used instead of graphBlobRaw */
+    std::unique_ptr<VPU::VPUMappedFile> blobFile;
+
+    /* Pending initialization of graph created asynchronously with own copy of its input */
+    std::shared_future<ze_result_t> creation;
+    std::vector<uint8_t> inputCopy;
+    std::string buildFlagsCopy;
 
     uint64_t blobId = 0u;
     uint32_t scratchSize = 0u;
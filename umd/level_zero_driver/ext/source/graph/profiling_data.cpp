@@ -20,11 +20,13 @@ GraphProfilingPool::GraphProfilingPool(VPU::VPUDeviceContext *ctx,
                                        const uint32_t size,
                                        const uint32_t count,
                                        VPU::VPUBufferObject *profilingPoolBuffer,
-                                       std::vector<uint8_t> *graphBlobRaw)
+                                       const uint8_t *graphBlobData,
+                                       size_t graphBlobSize)
     : ctx(ctx)
     , querySize(size)
     , profilingPool(profilingPoolBuffer)
-    , graphBlobRaw(graphBlobRaw) {
+    , graphBlobData(graphBlobData)
+    , graphBlobSize(graphBlobSize) {
     queryAllocation.resize(count, nullptr);
 };
 
@@ -95,7 +97,8 @@ ze_result_t GraphProfilingQuery::getData(ze_graph_profiling_type_t profilingType
     if (profilingType == ZE_GRAPH_PROFILING_LAYER_LEVEL ||
         profilingType == ZE_GRAPH_PROFILING_TASK_LEVEL) {
         return Compiler::getDecodedProfilingBuffer(profilingType,
-                                                   pool->getGraphBlobRaw(),
+                                                   pool->getGraphBlobData(),
+                                                   pool->getGraphBlobSize(),
                                                    static_cast<uint8_t *>(queryPtr),
                                                    size,
                                                    pSize,
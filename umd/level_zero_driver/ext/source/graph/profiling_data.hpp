@@ -49,14 +49,16 @@ struct GraphProfilingPool : _ze_graph_profiling_pool_handle_t {
                        const uint32_t size,
                        const uint32_t count,
                        VPU::VPUBufferObject *profilingPoolBuffer,
-                       std::vector<uint8_t> *graphBlobRaw);
+                       const uint8_t *graphBlobData,
+                       size_t graphBlobSize);
     ze_result_t destroy();
 
     ze_result_t createProfilingQuery(const uint32_t index,
                                      ze_graph_profiling_query_handle_t *phProfilingQuery);
     void removeQuery(GraphProfilingQuery *profilingQuery);
 
-    std::vector<uint8_t> *getGraphBlobRaw() { return graphBlobRaw; };
+    const uint8_t *getGraphBlobData() const { return graphBlobData; };
+    size_t getGraphBlobSize() const { return graphBlobSize; };
 
     inline ze_graph_profiling_pool_handle_t toHandle() { return this; }
     static GraphProfilingPool *fromHandle(ze_graph_profiling_pool_handle_t handle) {
@@ -67,7 +69,8 @@ struct GraphProfilingPool : _ze_graph_profiling_pool_handle_t {
     VPU::VPUDeviceContext *ctx;
     uint32_t querySize = 0u;
     VPU::VPUBufferObject *profilingPool = nullptr;
-    std::vector<uint8_t> *graphBlobRaw;
+    const uint8_t *graphBlobData;
+    size_t graphBlobSize;
 
     std::vector<GraphProfilingQuery *> queryAllocation;
 };
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#ifndef _ZE_VPU_GRAPH_EXT_H
+#define _ZE_VPU_GRAPH_EXT_H
+#if defined(__cplusplus)
+#pragma once
+#endif
+
+#include <level_zero/ze_graph_ext.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*
+ * Graph creation on a worker thread. The graph handle is returned immediately, the creation
+ * is completed by zeGraphCreationSynchronize or observed by zeGraphCreationQueryStatus.
+ */
+#define ZE_VPU_GRAPH_ASYNC_CREATE_EXT_NAME "ZE_extension_vpu_graph_async_create"
+
+typedef ze_result_t(ZE_APICALL *ze_pfnGraphCreateAsync_ext_t)(ze_context_handle_t hContext,
+                                                              ze_device_handle_t hDevice,
+                                                              const ze_graph_desc_t *pDesc,
+                                                              ze_graph_handle_t *phGraph);
+typedef ze_result_t(ZE_APICALL *ze_pfnGraphCreationSynchronize_ext_t)(ze_graph_handle_t hGraph,
+                                                                      uint64_t timeout);
+typedef ze_result_t(ZE_APICALL *ze_pfnGraphCreationQueryStatus_ext_t)(ze_graph_handle_t hGraph);
+
+typedef struct _ze_vpu_graph_async_create_dditable_ext_t {
+    ze_pfnGraphCreateAsync_ext_t pfnCreateAsync;
+    ze_pfnGraphCreationSynchronize_ext_t pfnCreationSynchronize;
+    ze_pfnGraphCreationQueryStatus_ext_t pfnCreationQueryStatus;
+} ze_vpu_graph_async_create_dditable_ext_t;
+
+/*
+ * Graph creation from a blob file given by path or file descriptor. The blob is mapped instead
+ * of being copied into host memory.
+ */
+#define ZE_VPU_GRAPH_CREATE_FROM_FILE_EXT_NAME "ZE_extension_vpu_graph_create_from_file"
+
+typedef ze_result_t(ZE_APICALL *ze_pfnGraphCreateFromFile_ext_t)(ze_context_handle_t hContext,
+                                                                 ze_device_handle_t hDevice,
+                                                                 const ze_graph_desc_t *pDesc,
+                                                                 const char *pPath,
+                                                                 ze_graph_handle_t *phGraph);
+typedef ze_result_t(ZE_APICALL *ze_pfnGraphCreateFromFd_ext_t)(ze_context_handle_t hContext,
+                                                               ze_device_handle_t hDevice,
+                                                               const ze_graph_desc_t *pDesc,
+                                                               int fd,
+                                                               ze_graph_handle_t *phGraph);
+
+typedef struct _ze_vpu_graph_create_from_file_dditable_ext_t {
+    ze_pfnGraphCreateFromFile_ext_t pfnCreateFromFile;
+    ze_pfnGraphCreateFromFd_ext_t pfnCreateFromFd;
+} ze_vpu_graph_create_from_file_dditable_ext_t;
+
+/*
+ * Execution of a graph with batchSize argument sets appended at once. ppArgValues holds the
+ * argument values of all sets, set after set. If the graph has profiling output,
+ * phProfilingQueries holds one query per set.
+ */
+#define ZE_VPU_GRAPH_EXECUTE_BATCH_EXT_NAME "ZE_extension_vpu_graph_execute_batch"
+
+typedef ze_result_t(ZE_APICALL *ze_pfnAppendGraphExecuteBatch_ext_t)(
+    ze_command_list_handle_t hCommandList,
+    ze_graph_handle_t hGraph,
+    uint32_t batchSize,
+    const void **ppArgValues,
+    ze_graph_profiling_query_handle_t *phProfilingQueries,
+    ze_event_handle_t hSignalEvent,
+    uint32_t numWaitEvents,
+    ze_event_handle_t *phWaitEvents);
+
+typedef struct _ze_vpu_graph_execute_batch_dditable_ext_t {
+    ze_pfnAppendGraphExecuteBatch_ext_t pfnAppendGraphExecuteBatch;
+} ze_vpu_graph_execute_batch_dditable_ext_t;
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+#endif // _ZE_VPU_GRAPH_EXT_H
@@ -256,6 +256,60 @@ TEST_F(CommandListCommitSizeTest, l2lCopyAndbarrierCommandWithEvents) {
     EXPECT_EQ(0u, nnCmdlist->getCopyCommands().size());
 }
 
+TEST_F(CommandListCommitSizeTest, regionCopyIsAppendedAsSingleCommandWithEvent) {
+    ze_copy_region_t srcRegion = {0, 0, 0, 16, 8, 1};
+    ze_copy_region_t dstRegion = {16, 1, 0, 16, 8, 1};
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              nnCmdlist->appendMemoryCopyRegion(shareMem1,
+                                                &dstRegion,
+                                                64,
+                                                0,
+                                                shareMem2,
+                                                &srcRegion,
+                                                32,
+                                                0,
+                                                hEvent0,
+                                                0,
+                                                nullptr));
+    ASSERT_EQ(ZE_RESULT_SUCCESS, nnCmdlist->close());
+
+    EXPECT_EQ(2u, nnCmdlist->getNumCommands());
+    EXPECT_EQ(2u, nnCmdlist->getNNCommands().size());
+}
+
+TEST_F(CommandListCommitSizeTest, regionCopyWithInvalidRegionsReturnsError) {
+    ze_copy_region_t srcRegion = {0, 0, 0, 16, 8, 1};
+    ze_copy_region_t dstRegion = {0, 0, 0, 16, 4, 1};
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              nnCmdlist->appendMemoryCopyRegion(shareMem1,
+                                                &dstRegion,
+                                                16,
+                                                0,
+                                                shareMem2,
+                                                &srcRegion,
+                                                16,
+                                                0,
+                                                nullptr,
+                                                0,
+                                                nullptr));
+
+    // Region exceeds the allocation
+    dstRegion.height = 8;
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              nnCmdlist->appendMemoryCopyRegion(shareMem1,
+                                                &dstRegion,
+                                                4096,
+                                                0,
+                                                shareMem2,
+                                                &srcRegion,
+                                                16,
+                                                0,
+                                                nullptr,
+                                                0,
+                                                nullptr));
+    EXPECT_EQ(0u, nnCmdlist->getNumCommands());
+}
+
 TEST_F(CommandListCommitSizeTest, timeStampAndS2LCopyCommands) {
     auto timestampPtr = static_cast<uint64_t *>(shareMem2);
 
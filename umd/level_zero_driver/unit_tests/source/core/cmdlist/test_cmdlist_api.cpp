@@ -348,6 +348,22 @@ TEST_F(CommandListApiTest, whenCalledAppendGraphInitializeWithoutInitGraphFailur
     EXPECT_EQ(ZE_RESULT_ERROR_UNINITIALIZED, result);
 }
 
+TEST_F(CommandListApiTest, whenCalledAppendGraphExecuteBatchWithInvalidParamsFailureIsReturned) {
+    const void *argValues[2] = {};
+    auto result =
+        commandList->appendGraphExecuteBatch(nullptr, 0u, argValues, nullptr, nullptr, 0u, nullptr);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_SIZE, result);
+
+    result =
+        commandList->appendGraphExecuteBatch(nullptr, 1u, nullptr, nullptr, nullptr, 0u, nullptr);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_SIZE, result);
+
+    result =
+        commandList->appendGraphExecuteBatch(nullptr, 1u, argValues, nullptr, nullptr, 0u, nullptr);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE, result);
+    EXPECT_EQ(0u, commandList->getNumCommands());
+}
+
 struct CommandListEventApiTest : Test<CommandListFixture> {
     void SetUp() override {
         CommandListFixture::SetUp();
@@ -21,6 +21,7 @@
 
 #include <thread>
 #include <chrono>
+#include <limits>
 
 namespace L0 {
 namespace ult {
@@ -368,6 +369,124 @@ TEST_F(CommandQueueExecTest, eventAttachedToSingleQueuesRespectively) {
     cpCmdlist->destroy();
 }
 
+TEST_F(CommandQueueExecTest, immediateCommandListSubmitsEachAppendDirectly) {
+    size_t testAllocSize = 4 * 1024;
+    auto srcShareMem = ctx->createSharedMemAlloc(testAllocSize);
+    auto destHostMem = ctx->createHostMemAlloc(testAllocSize);
+    ASSERT_NE(nullptr, srcShareMem);
+    ASSERT_NE(nullptr, destHostMem);
+
+    ze_command_queue_desc_t desc = {};
+    desc.ordinal = getCopyOnlyQueueOrdinal();
+    desc.mode = ZE_COMMAND_QUEUE_MODE_SYNCHRONOUS;
+
+    ze_command_list_handle_t hCmdList = nullptr;
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              zeCommandListCreateImmediate(nullptr, device, &desc, &hCmdList));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              zeCommandListCreateImmediate(context, device, nullptr, &hCmdList));
+    ASSERT_EQ(ZE_RESULT_SUCCESS, zeCommandListCreateImmediate(context, device, &desc, &hCmdList));
+
+    auto cmdList = L0::CommandList::fromHandle(hCmdList);
+    ASSERT_NE(nullptr, cmdList);
+    EXPECT_TRUE(cmdList->isImmediate());
+    EXPECT_TRUE(cmdList->isCopyOnly());
+
+    uint32_t ioctlCount = osInfc.callCntIoctl;
+    ASSERT_EQ(
+        ZE_RESULT_SUCCESS,
+        cmdList->appendMemoryCopy(destHostMem, srcShareMem, testAllocSize, event1, 1, &event0));
+    EXPECT_LT(ioctlCount, osInfc.callCntIoctl);
+    EXPECT_EQ(DRM_IOCTL_IVPU_BO_WAIT, osInfc.ioctlLastCommand);
+    EXPECT_EQ(0u, cmdList->getNumCommands());
+
+    // Commands are already submitted, immediate list is not executed through command queue
+    EXPECT_EQ(ZE_RESULT_SUCCESS, cmdList->close());
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT, cpQue->executeCommandLists(1, &hCmdList, nullptr));
+
+    // Compute commands are rejected by copy-only immediate list
+    EXPECT_EQ(ZE_RESULT_SUCCESS, cmdList->appendBarrier(nullptr, 0, nullptr));
+    EXPECT_EQ(
+        ZE_RESULT_ERROR_UNKNOWN,
+        cmdList->appendMemoryCopy(srcShareMem, srcShareMem, testAllocSize, nullptr, 0, nullptr));
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, zeCommandListDestroy(hCmdList));
+    ctx->freeMemAlloc(srcShareMem);
+    ctx->freeMemAlloc(destHostMem);
+}
+
+TEST_F(CommandQueueExecTest, asynchronousImmediateCommandListDoesNotWaitForCompletion) {
+    size_t testAllocSize = 4 * 1024;
+    auto srcShareMem = ctx->createSharedMemAlloc(testAllocSize);
+    auto destShareMem = ctx->createSharedMemAlloc(testAllocSize);
+    ASSERT_NE(nullptr, srcShareMem);
+    ASSERT_NE(nullptr, destShareMem);
+
+    ze_result_t res;
+    L0::CommandList *cmdList = L0::CommandList::createImmediate(false, false, ctx, res);
+    ASSERT_EQ(ZE_RESULT_SUCCESS, res);
+    ASSERT_NE(nullptr, cmdList);
+
+    ASSERT_EQ(
+        ZE_RESULT_SUCCESS,
+        cmdList->appendMemoryCopy(destShareMem, srcShareMem, testAllocSize, nullptr, 0, nullptr));
+    EXPECT_EQ(DRM_IOCTL_IVPU_SUBMIT, osInfc.ioctlLastCommand);
+    ASSERT_EQ(ZE_RESULT_SUCCESS, cmdList->appendSignalEvent(event0));
+    EXPECT_EQ(DRM_IOCTL_IVPU_SUBMIT, osInfc.ioctlLastCommand);
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, cmdList->destroy());
+    ctx->freeMemAlloc(srcShareMem);
+    ctx->freeMemAlloc(destShareMem);
+}
+
+TEST_F(CommandQueueExecTest, DISABLED_immediateCommandListLatencyBenchmark) {
+    const size_t iterations = 10'000;
+    const size_t copySize = 64;
+    auto srcShareMem = ctx->createSharedMemAlloc(copySize);
+    auto destHostMem = ctx->createHostMemAlloc(copySize);
+    ASSERT_NE(nullptr, srcShareMem);
+    ASSERT_NE(nullptr, destHostMem);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        ze_result_t res;
+        L0::CommandList *cmdList = L0::CommandList::create(true, ctx, res);
+        ASSERT_EQ(
+            ZE_RESULT_SUCCESS,
+            cmdList->appendMemoryCopy(destHostMem, srcShareMem, copySize, nullptr, 0, nullptr));
+        ASSERT_EQ(ZE_RESULT_SUCCESS, cmdList->close());
+        auto hCmdList = cmdList->toHandle();
+        ASSERT_EQ(ZE_RESULT_SUCCESS, cpQue->executeCommandLists(1, &hCmdList, nullptr));
+        ASSERT_EQ(ZE_RESULT_SUCCESS, cpQue->synchronize(std::numeric_limits<uint64_t>::max()));
+        ASSERT_EQ(ZE_RESULT_SUCCESS, cmdList->destroy());
+    }
+    auto regularNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    ze_result_t res;
+    L0::CommandList *immCmdList = L0::CommandList::createImmediate(true, true, ctx, res);
+    ASSERT_NE(nullptr, immCmdList);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        ASSERT_EQ(
+            ZE_RESULT_SUCCESS,
+            immCmdList->appendMemoryCopy(destHostMem, srcShareMem, copySize, nullptr, 0, nullptr));
+    }
+    auto immediateNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    ASSERT_EQ(ZE_RESULT_SUCCESS, immCmdList->destroy());
+
+    printf("regular list:   %8.3f us per copy\n",
+           static_cast<double>(regularNs) / 1e3 / iterations);
+    printf("immediate list: %8.3f us per copy\n",
+           static_cast<double>(immediateNs) / 1e3 / iterations);
+
+    ctx->freeMemAlloc(srcShareMem);
+    ctx->freeMemAlloc(destHostMem);
+}
+
 struct CommandQueueJobTest : public Test<CommandQueueFixture> {
     void SetUp() override {
         CommandQueueFixture::SetUp();
@@ -561,8 +680,10 @@ TEST_F(CommandQueueJobTest, multipleJobsMaintainedInSingleSubmitId) {
     ze_command_list_handle_t nnCmdlists[] = {hNNCmdlist, hNNCmdlist1, hNNCmdlist2};
     ASSERT_EQ(ZE_RESULT_SUCCESS, nnCmdque->executeCommandLists(3, nnCmdlists, nullptr));
 
-    // Expect all submitted command lists are observed within the same submit ID.
-    EXPECT_EQ(3u, nnCmdque->getSubmittedJobCount());
+    // Expect all submitted command lists are merged into single batch job.
+    EXPECT_EQ(1u, nnCmdque->getSubmittedJobCount());
+    EXPECT_EQ(DRM_IOCTL_IVPU_SUBMIT, osInfc.ioctlLastCommand);
+    EXPECT_EQ(ZE_RESULT_SUCCESS, nnCmdque->synchronize(0));
 
     // Deallocate the memory.
     ASSERT_EQ(ZE_RESULT_SUCCESS, nnCmdlist1->destroy());
@@ -135,7 +135,7 @@ TEST_F(SingleDeviceTest, givenCallToDevicePropertiesThenBasicPropertiesCorrectly
     EXPECT_EQ(l0DevProps.timestampValidBits, 64u);
 
     // Number of valid bits in the kernel timestamp values.
-    EXPECT_EQ(l0DevProps.kernelTimestampValidBits, 0u);
+    EXPECT_EQ(l0DevProps.kernelTimestampValidBits, 64u);
 
     // Device name.
     EXPECT_STREQ(l0DevProps.name, hwInfo.name);
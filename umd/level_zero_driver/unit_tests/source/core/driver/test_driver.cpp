@@ -7,14 +7,17 @@
 
 #include "level_zero_driver/core/source/driver/driver_handle.hpp"
 #include "level_zero_driver/core/source/driver/driver.hpp"
+#include "level_zero_driver/ext/source/graph/compiler.hpp"
 #include "level_zero_driver/unit_tests/fixtures/device_fixture.hpp"
 #include "level_zero_driver/unit_tests/mocks/mock_driver.hpp"
 
+#include "vpu_driver/source/utilities/timer.hpp"
 #include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
 
 #include "gtest/gtest.h"
 #include "vpu_driver/unit_tests/test_macros/test.hpp"
 
+#include <cstring>
 #include <stdlib.h>
 
 namespace L0 {
@@ -111,6 +114,29 @@ TEST_F(DriverVersionTest, givenCallToGetExtensionPropertiesThenUnsupportedIsRetu
     EXPECT_EQ(ZE_RESULT_ERROR_UNSUPPORTED_FEATURE, res);
 }
 
+TEST_F(DriverVersionTest, ioctlStatisticsAreReturnedThroughExtensionFunction) {
+    void *pfn = nullptr;
+    ze_result_t res =
+        driverHandle->getExtensionFunctionAddress(ZE_VPU_IOCTL_STATISTICS_EXT_NAME, &pfn);
+    EXPECT_EQ(ZE_RESULT_SUCCESS, res);
+    ASSERT_NE(nullptr, pfn);
+    auto getIoctlStatistics = reinterpret_cast<ze_pfnDriverGetIoctlStatistics_ext_t>(pfn);
+
+    size_t size = 0;
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE, getIoctlStatistics(nullptr, &size, nullptr));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              getIoctlStatistics(driverHandle, nullptr, nullptr));
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, getIoctlStatistics(driverHandle, &size, nullptr));
+    ASSERT_GT(size, 1u);
+
+    std::vector<char> report(size);
+    EXPECT_EQ(ZE_RESULT_SUCCESS, getIoctlStatistics(driverHandle, &size, report.data()));
+    EXPECT_EQ(report.size(), size);
+    EXPECT_EQ('\0', report.back());
+    EXPECT_NE(nullptr, strstr(report.data(), "VPU ioctl statistics"));
+}
+
 TEST_F(DriverVersionTest, returnsExpectedGetDriverPropertiesResultAndIPCPropertyFlagType) {
     ze_result_t res = driverHandle->getIPCProperties(nullptr);
     EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER, res);
@@ -128,12 +154,36 @@ TEST_F(DriverVersionTest, checkEnvironmentVariableInitialization) {
     char *enablePciIdOrderDefault = getenv("ZE_ENABLE_PCI_ID_DEVICE_ORDER");
     char *sharedForceDeviceAllocDefault = getenv("ZE_SHARED_FORCE_DEVICE_ALLOC");
     char *umdLogLevel = getenv("VPU_DRV_UMD_LOGLEVEL");
+    char *bufferCacheSize = getenv("VPU_DRV_BUFFER_CACHE_SIZE");
+    char *scratchPoolRegions = getenv("VPU_DRV_SCRATCH_POOL_REGIONS");
+    char *waitSpinTime = getenv("VPU_DRV_WAIT_SPIN_TIME");
+    char *waitBlockOnJob = getenv("VPU_DRV_WAIT_BLOCK_ON_JOB");
+    char *compilerCacheDir = getenv("VPU_DRV_COMPILER_CACHE_DIR");
+    char *compilerCacheSize = getenv("VPU_DRV_COMPILER_CACHE_SIZE");
+    char *emulator = getenv("VPU_DRV_EMULATOR");
+    char *emulatorJobLatency = getenv("VPU_DRV_EMULATOR_JOB_LATENCY");
+    char *ioctlStatsDump = getenv("VPU_DRV_IOCTL_STATS_DUMP");
+    char *umdTraceLevel = getenv("VPU_DRV_UMD_TRACE_LEVEL");
+    char *jobTraceFile = getenv("VPU_DRV_JOB_TRACE_FILE");
+    char *cmdBufferCaptureDir = getenv("VPU_DRV_CMDBUF_CAPTURE_DIR");
 
     unsetenv("ZE_AFFINITY_MASK");
     unsetenv("ZET_ENABLE_METRICS");
     unsetenv("ZE_ENABLE_PCI_ID_DEVICE_ORDER");
     unsetenv("ZE_SHARED_FORCE_DEVICE_ALLOC");
     unsetenv("VPU_DRV_UMD_LOGLEVEL");
+    unsetenv("VPU_DRV_BUFFER_CACHE_SIZE");
+    unsetenv("VPU_DRV_SCRATCH_POOL_REGIONS");
+    unsetenv("VPU_DRV_WAIT_SPIN_TIME");
+    unsetenv("VPU_DRV_WAIT_BLOCK_ON_JOB");
+    unsetenv("VPU_DRV_COMPILER_CACHE_DIR");
+    unsetenv("VPU_DRV_COMPILER_CACHE_SIZE");
+    unsetenv("VPU_DRV_EMULATOR");
+    unsetenv("VPU_DRV_EMULATOR_JOB_LATENCY");
+    unsetenv("VPU_DRV_IOCTL_STATS_DUMP");
+    unsetenv("VPU_DRV_UMD_TRACE_LEVEL");
+    unsetenv("VPU_DRV_JOB_TRACE_FILE");
+    unsetenv("VPU_DRV_CMDBUF_CAPTURE_DIR");
 
     driver.initializeEnvVariables();
     EXPECT_EQ(driver.getEnvVariables().affinityMask, "");
@@ -141,12 +191,36 @@ TEST_F(DriverVersionTest, checkEnvironmentVariableInitialization) {
     EXPECT_EQ(driver.getEnvVariables().pciIdDeviceOrder, false);
     EXPECT_EQ(driver.getEnvVariables().sharedForceDeviceAlloc, false);
     EXPECT_EQ(driver.getEnvVariables().umdLogLevel, "");
+    EXPECT_EQ(driver.getEnvVariables().bufferCacheSize, 0u);
+    EXPECT_EQ(driver.getEnvVariables().scratchPoolRegions, 0u);
+    EXPECT_EQ(driver.getEnvVariables().waitSpinTimeUs, VPU::WaitPolicy().spinTimeNs / 1000);
+    EXPECT_EQ(driver.getEnvVariables().waitBlockOnJob, true);
+    EXPECT_EQ(driver.getEnvVariables().compilerCacheDir, "");
+    EXPECT_EQ(driver.getEnvVariables().compilerCacheSize, Compiler::defaultBlobCacheSize);
+    EXPECT_EQ(driver.getEnvVariables().emulator, false);
+    EXPECT_EQ(driver.getEnvVariables().emulatorJobLatencyUs, 0u);
+    EXPECT_EQ(driver.getEnvVariables().ioctlStatsDump, false);
+    EXPECT_EQ(driver.getEnvVariables().umdTraceLevel, "");
+    EXPECT_EQ(driver.getEnvVariables().jobTraceFile, "");
+    EXPECT_EQ(driver.getEnvVariables().cmdBufferCaptureDir, "");
 
     setenv("ZE_AFFINITY_MASK", "0,1", 1);
     setenv("ZET_ENABLE_METRICS", "1", 1);
     setenv("ZE_ENABLE_PCI_ID_DEVICE_ORDER", "1", 1);
     setenv("ZE_SHARED_FORCE_DEVICE_ALLOC", "1", 1);
     setenv("VPU_DRV_UMD_LOGLEVEL", "VERBOSE", 1);
+    setenv("VPU_DRV_BUFFER_CACHE_SIZE", "64", 1);
+    setenv("VPU_DRV_SCRATCH_POOL_REGIONS", "2", 1);
+    setenv("VPU_DRV_WAIT_SPIN_TIME", "0", 1);
+    setenv("VPU_DRV_WAIT_BLOCK_ON_JOB", "0", 1);
+    setenv("VPU_DRV_COMPILER_CACHE_DIR", "/tmp/vpu_cache", 1);
+    setenv("VPU_DRV_COMPILER_CACHE_SIZE", "16", 1);
+    setenv("VPU_DRV_EMULATOR", "1", 1);
+    setenv("VPU_DRV_EMULATOR_JOB_LATENCY", "100", 1);
+    setenv("VPU_DRV_IOCTL_STATS_DUMP", "1", 1);
+    setenv("VPU_DRV_UMD_TRACE_LEVEL", "INFO", 1);
+    setenv("VPU_DRV_JOB_TRACE_FILE", "/tmp/vpu_jobs.json", 1);
+    setenv("VPU_DRV_CMDBUF_CAPTURE_DIR", "/tmp/vpu_cmdbuf", 1);
 
     driver.initializeEnvVariables();
     EXPECT_EQ(driver.getEnvVariables().affinityMask, "0,1");
@@ -154,6 +228,18 @@ TEST_F(DriverVersionTest, checkEnvironmentVariableInitialization) {
     EXPECT_EQ(driver.getEnvVariables().pciIdDeviceOrder, true);
     EXPECT_EQ(driver.getEnvVariables().sharedForceDeviceAlloc, true);
     EXPECT_EQ(driver.getEnvVariables().umdLogLevel, "VERBOSE");
+    EXPECT_EQ(driver.getEnvVariables().bufferCacheSize, 64u);
+    EXPECT_EQ(driver.getEnvVariables().scratchPoolRegions, 2u);
+    EXPECT_EQ(driver.getEnvVariables().waitSpinTimeUs, 0u);
+    EXPECT_EQ(driver.getEnvVariables().waitBlockOnJob, false);
+    EXPECT_EQ(driver.getEnvVariables().compilerCacheDir, "/tmp/vpu_cache");
+    EXPECT_EQ(driver.getEnvVariables().compilerCacheSize, 16u);
+    EXPECT_EQ(driver.getEnvVariables().emulator, true);
+    EXPECT_EQ(driver.getEnvVariables().emulatorJobLatencyUs, 100u);
+    EXPECT_EQ(driver.getEnvVariables().ioctlStatsDump, true);
+    EXPECT_EQ(driver.getEnvVariables().umdTraceLevel, "INFO");
+    EXPECT_EQ(driver.getEnvVariables().jobTraceFile, "/tmp/vpu_jobs.json");
+    EXPECT_EQ(driver.getEnvVariables().cmdBufferCaptureDir, "/tmp/vpu_cmdbuf");
 
     affinityMaskDefault == nullptr ? unsetenv("ZE_AFFINITY_MASK")
                                    : setenv("ZE_AFFINITY_MASK", affinityMaskDefault, 1);
@@ -167,6 +253,32 @@ TEST_F(DriverVersionTest, checkEnvironmentVariableInitialization) {
         : setenv("ZE_SHARED_FORCE_DEVICE_ALLOC", sharedForceDeviceAllocDefault, 1);
     umdLogLevel == nullptr ? unsetenv("VPU_DRV_UMD_LOGLEVEL")
                            : setenv("VPU_DRV_UMD_LOGLEVEL", umdLogLevel, 1);
+    bufferCacheSize == nullptr ? unsetenv("VPU_DRV_BUFFER_CACHE_SIZE")
+                               : setenv("VPU_DRV_BUFFER_CACHE_SIZE", bufferCacheSize, 1);
+    scratchPoolRegions == nullptr
+        ? unsetenv("VPU_DRV_SCRATCH_POOL_REGIONS")
+        : setenv("VPU_DRV_SCRATCH_POOL_REGIONS", scratchPoolRegions, 1);
+    waitSpinTime == nullptr ? unsetenv("VPU_DRV_WAIT_SPIN_TIME")
+                            : setenv("VPU_DRV_WAIT_SPIN_TIME", waitSpinTime, 1);
+    waitBlockOnJob == nullptr ? unsetenv("VPU_DRV_WAIT_BLOCK_ON_JOB")
+                              : setenv("VPU_DRV_WAIT_BLOCK_ON_JOB", waitBlockOnJob, 1);
+    compilerCacheDir == nullptr ? unsetenv("VPU_DRV_COMPILER_CACHE_DIR")
+                                : setenv("VPU_DRV_COMPILER_CACHE_DIR", compilerCacheDir, 1);
+    compilerCacheSize == nullptr ? unsetenv("VPU_DRV_COMPILER_CACHE_SIZE")
+                                 : setenv("VPU_DRV_COMPILER_CACHE_SIZE", compilerCacheSize, 1);
+    emulator == nullptr ? unsetenv("VPU_DRV_EMULATOR") : setenv("VPU_DRV_EMULATOR", emulator, 1);
+    emulatorJobLatency == nullptr
+        ? unsetenv("VPU_DRV_EMULATOR_JOB_LATENCY")
+        : setenv("VPU_DRV_EMULATOR_JOB_LATENCY", emulatorJobLatency, 1);
+    ioctlStatsDump == nullptr ? unsetenv("VPU_DRV_IOCTL_STATS_DUMP")
+                              : setenv("VPU_DRV_IOCTL_STATS_DUMP", ioctlStatsDump, 1);
+    umdTraceLevel == nullptr ? unsetenv("VPU_DRV_UMD_TRACE_LEVEL")
+                             : setenv("VPU_DRV_UMD_TRACE_LEVEL", umdTraceLevel, 1);
+    jobTraceFile == nullptr ? unsetenv("VPU_DRV_JOB_TRACE_FILE")
+                            : setenv("VPU_DRV_JOB_TRACE_FILE", jobTraceFile, 1);
+    cmdBufferCaptureDir == nullptr
+        ? unsetenv("VPU_DRV_CMDBUF_CAPTURE_DIR")
+        : setenv("VPU_DRV_CMDBUF_CAPTURE_DIR", cmdBufferCaptureDir, 1);
 }
 
 } // namespace ult
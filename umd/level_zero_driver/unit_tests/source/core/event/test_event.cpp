@@ -13,7 +13,14 @@
 #include "level_zero_driver/unit_tests/fixtures/device_fixture.hpp"
 #include "level_zero_driver/core/source/event/eventpool.hpp"
 #include "level_zero_driver/core/source/event/event.hpp"
-
+#include "level_zero_driver/core/source/cmdlist/cmdlist.hpp"
+#include "level_zero_driver/core/source/driver/driver_handle.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+
+#include <chrono>
+#include <limits>
+#include <thread>
 #include <vector>
 
 namespace L0 {
@@ -149,6 +156,87 @@ TEST_F(EventTest, givenCallHostSyncReturnsSignalStatus) {
     EXPECT_EQ(ZE_RESULT_NOT_READY, ev->hostSynchronize(0u));
 }
 
+TEST_F(EventTest, hostSynchronizeBlocksOnAssociatedJobAfterSpinTime) {
+    auto ev = Event::fromHandle(hEvent);
+    ASSERT_NE(nullptr, ev);
+
+    uint64_t *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, ts);
+    auto job = std::make_shared<VPU::VPUJob>(ctx, false);
+    ASSERT_TRUE(job->appendCommand(VPU::VPUTimeStampCommand::create(ctx, ts)));
+    ASSERT_TRUE(job->closeCommands());
+    ev->associateJob(job);
+
+    VPU::WaitPolicy policy;
+    policy.spinTimeNs = 0;
+    ev->setWaitPolicy(policy);
+
+    // Polling reports busy job, then the waiter blocks on the job in KMD and polls again
+    osInfc.mockFailNextJobWait();
+    uint32_t ioctlCount = osInfc.callCntIoctl;
+    EXPECT_EQ(ZE_RESULT_NOT_READY, ev->hostSynchronize(std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ(ioctlCount + 3, osInfc.callCntIoctl);
+    EXPECT_EQ(DRM_IOCTL_IVPU_BO_WAIT, osInfc.ioctlLastCommand);
+    EXPECT_EQ(1u, ev->getWaitStatistics().getWaitCount());
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+}
+
+TEST_F(EventTest, hostSynchronizeWithoutJobIsWokenUpByHostSignal) {
+    auto ev = Event::fromHandle(hEvent);
+    ASSERT_NE(nullptr, ev);
+
+    VPU::WaitPolicy policy;
+    policy.spinTimeNs = 0;
+    ev->setWaitPolicy(policy);
+
+    std::thread signaller([ev] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ev->hostSignal();
+    });
+    EXPECT_EQ(ZE_RESULT_SUCCESS, ev->hostSynchronize(std::numeric_limits<uint64_t>::max()));
+    signaller.join();
+    EXPECT_EQ(1u, ev->getWaitStatistics().getWaitCount());
+}
+
+TEST_F(EventTest, waitPolicyIsSetAndStatisticsAreReadThroughExtension) {
+    void *pfn = nullptr;
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              driverHandle->getExtensionFunctionAddress(ZE_VPU_WAIT_POLICY_EXT_NAME, &pfn));
+    ASSERT_NE(nullptr, pfn);
+    auto *table = reinterpret_cast<ze_vpu_wait_policy_dditable_ext_t *>(pfn);
+
+    ze_vpu_wait_policy_ext_t policy = {0, 1'000, 1'000'000, false};
+    ze_vpu_wait_statistics_ext_t stats = {};
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE, table->pfnEventSetWaitPolicy(nullptr, &policy));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER, table->pfnEventSetWaitPolicy(hEvent, nullptr));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              table->pfnCommandQueueSetWaitPolicy(nullptr, &policy));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              table->pfnCommandQueueGetWaitStatistics(nullptr, &stats));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              table->pfnEventGetWaitStatistics(hEvent, nullptr));
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, table->pfnEventSetWaitPolicy(hEvent, &policy));
+    EXPECT_EQ(ZE_RESULT_SUCCESS, table->pfnEventGetWaitStatistics(hEvent, &stats));
+    EXPECT_EQ(0u, stats.waitCount);
+
+    auto ev = Event::fromHandle(hEvent);
+    ASSERT_NE(nullptr, ev);
+    std::thread signaller([ev] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ev->hostSignal();
+    });
+    EXPECT_EQ(ZE_RESULT_SUCCESS, ev->hostSynchronize(std::numeric_limits<uint64_t>::max()));
+    signaller.join();
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, table->pfnEventGetWaitStatistics(hEvent, &stats));
+    EXPECT_EQ(1u, stats.waitCount);
+    EXPECT_EQ(stats.cpuTimeNs, stats.cpuTimePerWaitNs);
+    EXPECT_GE(stats.wallTimeNs, 10'000'000u);
+}
+
 TEST_F(EventTest, eventCreateHandleErrors) {
     auto evPool = EventPool::fromHandle(hEventPool);
     ASSERT_NE(nullptr, evPool);
@@ -165,6 +253,104 @@ TEST_F(EventTest, eventCreateHandleErrors) {
     EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ENUMERATION, evPool->createEvent(&desc, &hTestEvent));
 }
 
+TEST_F(EventTest, queryKernelTimestampOnRegularEventReturnsError) {
+    auto ev = Event::fromHandle(hEvent);
+    ASSERT_NE(nullptr, ev);
+
+    ze_kernel_timestamp_result_t result = {};
+    EXPECT_FALSE(ev->isKernelTimestampEvent());
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE, zeEventQueryKernelTimestamp(nullptr, &result));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT, zeEventQueryKernelTimestamp(hEvent, &result));
+}
+
+struct KernelTimestampEventTest : public EventTest {
+    void SetUp() override {
+        eventPoolDesc.flags |= ZE_EVENT_POOL_FLAG_KERNEL_TIMESTAMP;
+        EventTest::SetUp();
+
+        sharedMem = ctx->createSharedMemAlloc(allocSize);
+        ASSERT_NE(nullptr, sharedMem);
+    }
+
+    void TearDown() override {
+        if (sharedMem != nullptr)
+            EXPECT_TRUE(ctx->freeMemAlloc(sharedMem));
+        EventTest::TearDown();
+    }
+
+    const size_t allocSize = 4 * 1024;
+    void *sharedMem = nullptr;
+};
+
+TEST_F(KernelTimestampEventTest, queryKernelTimestampReturnsTimestampsOfSignaledEvent) {
+    auto ev = Event::fromHandle(hEvent);
+    ASSERT_NE(nullptr, ev);
+    EXPECT_TRUE(ev->isKernelTimestampEvent());
+
+    ze_kernel_timestamp_result_t result = {};
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER, zeEventQueryKernelTimestamp(hEvent, nullptr));
+    EXPECT_EQ(ZE_RESULT_NOT_READY, zeEventQueryKernelTimestamp(hEvent, &result));
+
+    // Emulate timestamps written by device
+    *ev->getKernelStartPointer() = 100;
+    *ev->getKernelEndPointer() = 250;
+    EXPECT_EQ(ZE_RESULT_SUCCESS, ev->hostSignal());
+    EXPECT_EQ(ZE_RESULT_SUCCESS, zeEventQueryKernelTimestamp(hEvent, &result));
+    EXPECT_EQ(100u, result.global.kernelStart);
+    EXPECT_EQ(250u, result.global.kernelEnd);
+    EXPECT_EQ(100u, result.context.kernelStart);
+    EXPECT_EQ(250u, result.context.kernelEnd);
+
+    // Reset clears timestamps
+    EXPECT_EQ(ZE_RESULT_SUCCESS, ev->reset());
+    EXPECT_EQ(0u, *ev->getKernelStartPointer());
+    EXPECT_EQ(0u, *ev->getKernelEndPointer());
+}
+
+TEST_F(KernelTimestampEventTest, signalEventBracketsCommandWithTimestamps) {
+    ze_result_t res = ZE_RESULT_SUCCESS;
+    auto cmdList = CommandList::create(false, ctx, res);
+    ASSERT_NE(nullptr, cmdList);
+    ASSERT_EQ(ZE_RESULT_SUCCESS, res);
+
+    void *dst = static_cast<uint8_t *>(sharedMem) + allocSize / 2;
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              cmdList->appendMemoryCopy(dst, sharedMem, allocSize / 2, hEvent, 0, nullptr));
+    ASSERT_EQ(ZE_RESULT_SUCCESS, cmdList->close());
+
+    // Start timestamp, copy, end timestamp and signal event
+    const auto &cmds = cmdList->getNNCommands();
+    ASSERT_EQ(4u, cmds.size());
+    EXPECT_EQ(VPU_CMD_TIMESTAMP, cmds[0]->getCommandType());
+    EXPECT_EQ(VPU_CMD_TIMESTAMP, cmds[2]->getCommandType());
+    EXPECT_EQ(VPU_CMD_FENCE_SIGNAL, cmds[3]->getCommandType());
+
+    EXPECT_EQ(ZE_RESULT_SUCCESS, cmdList->destroy());
+}
+
+TEST_F(KernelTimestampEventTest, appendQueryKernelTimestampsCopiesTimestampsOfEvents) {
+    ze_result_t res = ZE_RESULT_SUCCESS;
+    auto cmdList = CommandList::create(false, ctx, res);
+    ASSERT_NE(nullptr, cmdList);
+    ASSERT_EQ(ZE_RESULT_SUCCESS, res);
+
+    EXPECT_EQ(
+        ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+        cmdList->appendQueryKernelTimestamps(1, &hEvent, nullptr, nullptr, nullptr, 0, nullptr));
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              cmdList->appendQueryKernelTimestamps(1,
+                                                   &hEvent,
+                                                   sharedMem,
+                                                   nullptr,
+                                                   nullptr,
+                                                   0,
+                                                   nullptr));
+
+    // Global and context timestamps are copied
+    EXPECT_EQ(2u, cmdList->getNumCommands());
+    EXPECT_EQ(ZE_RESULT_SUCCESS, cmdList->destroy());
+}
+
 struct MultipleEventTest : public EventPoolTest {
     void SetUp() override { EventPoolTest::SetUp(); }
 
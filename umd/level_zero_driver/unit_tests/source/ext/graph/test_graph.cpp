@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "gtest/gtest.h"
+#include "vpu_driver/unit_tests/test_macros/test.hpp"
+
+#include "level_zero_driver/api/ext/ze_graph.hpp"
+#include "level_zero_driver/core/source/driver/driver_handle.hpp"
+#include "level_zero_driver/ext/source/graph/graph.hpp"
+#include "level_zero_driver/unit_tests/fixtures/device_fixture.hpp"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace L0 {
+namespace ult {
+
+struct GraphTest : public ContextFixture, public testing::Test {
+    void SetUp() override { ContextFixture::SetUp(); }
+
+    void TearDown() override { ContextFixture::TearDown(); }
+
+    ze_graph_desc_t getNativeDesc(const std::vector<uint8_t> &blob) {
+        ze_graph_desc_t desc = {};
+        desc.format = ZE_GRAPH_FORMAT_NATIVE;
+        desc.inputSize = blob.size();
+        desc.pInput = blob.data();
+        return desc;
+    }
+};
+
+TEST_F(GraphTest, asyncCreateFunctionsAreReturnedThroughExtensionTable) {
+    void *pfn = nullptr;
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              driverHandle->getExtensionFunctionAddress(ZE_VPU_GRAPH_ASYNC_CREATE_EXT_NAME, &pfn));
+    ASSERT_NE(nullptr, pfn);
+    auto *table = reinterpret_cast<ze_vpu_graph_async_create_dditable_ext_t *>(pfn);
+
+    EXPECT_EQ(&L0::zeGraphCreateAsync, table->pfnCreateAsync);
+    EXPECT_EQ(&L0::zeGraphCreationSynchronize, table->pfnCreationSynchronize);
+    EXPECT_EQ(&L0::zeGraphCreationQueryStatus, table->pfnCreationQueryStatus);
+
+    ze_graph_handle_t hGraph = nullptr;
+    std::vector<uint8_t> blob(64, 0);
+    ze_graph_desc_t desc = getNativeDesc(blob);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              table->pfnCreateAsync(nullptr, device->toHandle(), &desc, &hGraph));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE, table->pfnCreationQueryStatus(nullptr));
+    EXPECT_EQ(nullptr, hGraph);
+}
+
+TEST_F(GraphTest, asyncCreationWithNullArgumentsFails) {
+    ze_graph_handle_t hGraph = nullptr;
+    std::vector<uint8_t> blob(64, 0);
+    ze_graph_desc_t desc = getNativeDesc(blob);
+
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              Graph::createAsync(context->toHandle(), device->toHandle(), nullptr, &hGraph));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              Graph::createAsync(context->toHandle(), device->toHandle(), &desc, nullptr));
+    EXPECT_EQ(nullptr, hGraph);
+}
+
+TEST_F(GraphTest, asyncCreationReportsInitializationFailureOnSynchronize) {
+    ze_graph_handle_t hGraph = nullptr;
+    auto blob = std::make_unique<std::vector<uint8_t>>(64, 0);
+    ze_graph_desc_t desc = getNativeDesc(*blob);
+
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              Graph::createAsync(context->toHandle(), device->toHandle(), &desc, &hGraph));
+    ASSERT_NE(nullptr, hGraph);
+
+    // Graph keeps own copy of the input
+    blob.reset();
+
+    auto *graph = Graph::fromHandle(hGraph);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT, graph->synchronizeCreation(UINT64_MAX));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT, graph->synchronizeCreation(0));
+
+    ze_graph_properties_t properties = {};
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT, graph->getProperties(&properties));
+    EXPECT_EQ(ZE_RESULT_SUCCESS, graph->destroy());
+}
+
+TEST_F(GraphTest, createFromFileFunctionsAreReturnedThroughExtensionTable) {
+    void *pfn = nullptr;
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              driverHandle->getExtensionFunctionAddress(ZE_VPU_GRAPH_CREATE_FROM_FILE_EXT_NAME,
+                                                        &pfn));
+    ASSERT_NE(nullptr, pfn);
+    auto *table = reinterpret_cast<ze_vpu_graph_create_from_file_dditable_ext_t *>(pfn);
+
+    EXPECT_EQ(&L0::zeGraphCreateFromFile, table->pfnCreateFromFile);
+    EXPECT_EQ(&L0::zeGraphCreateFromFd, table->pfnCreateFromFd);
+
+    ze_graph_handle_t hGraph = nullptr;
+    ze_graph_desc_t desc = {};
+    desc.format = ZE_GRAPH_FORMAT_NATIVE;
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              table->pfnCreateFromFd(nullptr, device->toHandle(), &desc, -1, &hGraph));
+    EXPECT_EQ(nullptr, hGraph);
+}
+
+TEST_F(GraphTest, executeBatchFunctionIsReturnedThroughExtensionTable) {
+    void *pfn = nullptr;
+    ASSERT_EQ(ZE_RESULT_SUCCESS,
+              driverHandle->getExtensionFunctionAddress(ZE_VPU_GRAPH_EXECUTE_BATCH_EXT_NAME,
+                                                        &pfn));
+    ASSERT_NE(nullptr, pfn);
+    auto *table = reinterpret_cast<ze_vpu_graph_execute_batch_dditable_ext_t *>(pfn);
+
+    EXPECT_EQ(&L0::zeAppendGraphExecuteBatch, table->pfnAppendGraphExecuteBatch);
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_HANDLE,
+              table->pfnAppendGraphExecuteBatch(nullptr,
+                                                nullptr,
+                                                1u,
+                                                nullptr,
+                                                nullptr,
+                                                nullptr,
+                                                0u,
+                                                nullptr));
+}
+
+TEST_F(GraphTest, creationFromInvalidFileFails) {
+    ze_graph_handle_t hGraph = nullptr;
+    ze_graph_desc_t desc = {};
+    desc.format = ZE_GRAPH_FORMAT_NATIVE;
+
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_NULL_POINTER,
+              Graph::createFromFile(context->toHandle(),
+                                    device->toHandle(),
+                                    &desc,
+                                    nullptr,
+                                    &hGraph));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              Graph::createFromFile(context->toHandle(),
+                                    device->toHandle(),
+                                    &desc,
+                                    "/nonexistent/graph.blob",
+                                    &hGraph));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              Graph::createFromFd(context->toHandle(), device->toHandle(), &desc, -1, &hGraph));
+    EXPECT_EQ(nullptr, hGraph);
+}
+
+TEST_F(GraphTest, creationFromFileParsesMappedBlob) {
+    char path[] = "/tmp/vpu_graph_test.XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    std::vector<uint8_t> blob(64, 0);
+    ASSERT_EQ(static_cast<ssize_t>(blob.size()), write(fd, blob.data(), blob.size()));
+
+    ze_graph_handle_t hGraph = nullptr;
+    ze_graph_desc_t desc = {};
+    desc.format = ZE_GRAPH_FORMAT_NATIVE;
+
+    // Blob is not a valid ELF, parser rejects it
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              Graph::createFromFd(context->toHandle(), device->toHandle(), &desc, fd, &hGraph));
+    EXPECT_EQ(ZE_RESULT_ERROR_INVALID_ARGUMENT,
+              Graph::createFromFile(context->toHandle(), device->toHandle(), &desc, path, &hGraph));
+    EXPECT_EQ(nullptr, hGraph);
+
+    close(fd);
+    unlink(path);
+}
+
+} // namespace ult
+} // namespace L0
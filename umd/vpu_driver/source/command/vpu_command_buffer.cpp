@@ -9,9 +9,13 @@
 
 #include "vpu_driver/source/device/vpu_device_context.hpp"
 #include "vpu_driver/source/command/vpu_command_buffer.hpp"
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
 #include "vpu_driver/source/command/vpu_copy_command.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
 
+#include <algorithm>
+#include <string.h>
+
 namespace VPU {
 
 VPUCommandBuffer::VPUCommandBuffer(VPUDeviceContext *ctx,
@@ -36,7 +40,8 @@ VPUCommandBuffer::allocateCommandBuffer(VPUDeviceContext *ctx,
                                         const std::vector<std::shared_ptr<VPUCommand>> &cmds,
                                         void **descPtr,
                                         void *descEnd,
-                                        VPUCommandBuffer::Target engineType) {
+                                        VPUCommandBuffer::Target engineType,
+                                        VPUCommandBuffer *recycled) {
     if (ctx == nullptr || cmds.empty()) {
         LOG_E("VPUDeviceContext is nullptr or command list is empty");
         return nullptr;
@@ -46,8 +51,19 @@ VPUCommandBuffer::allocateCommandBuffer(VPUDeviceContext *ctx,
     for (const auto &cmd : cmds)
         cmdSize += cmd->getCommitSize();
 
-    VPUBufferObject *buffer = ctx->createInternalBufferObject(sizeof(CommandHeader) + cmdSize,
-                                                              VPUBufferObject::Type::CachedLow);
+    // Command buffer needs own handle, KMD reports job completion through BO_WAIT on it
+    VPUBufferObject *buffer = nullptr;
+    if (recycled && recycled->buffer &&
+        recycled->buffer->getAllocSize() >= sizeof(CommandHeader) + cmdSize) {
+        buffer = recycled->buffer;
+        recycled->buffer = nullptr;
+        // Header and context save area start clean like in a new buffer object
+        memset(buffer->getBasePointer(), 0, offsetof(CommandHeader, cmds));
+    } else {
+        buffer = ctx->createInternalBufferObject(sizeof(CommandHeader) + cmdSize,
+                                                 VPUBufferObject::Type::CachedLow,
+                                                 false);
+    }
     if (buffer == nullptr) {
         LOG_E("Failed to allocate buffer object for command buffer for %s engine",
               targetEngineToStr(engineType));
@@ -85,6 +101,169 @@ VPUCommandBuffer::allocateCommandBuffer(VPUDeviceContext *ctx,
     return cmdBuffer;
 }
 
+std::unique_ptr<VPUCommandBuffer>
+VPUCommandBuffer::createShadowCopy(const VPUBufferObject *descriptor,
+                                   VPUBufferObject *newDescriptor) const {
+    if ((descriptor == nullptr) != (newDescriptor == nullptr)) {
+        LOG_E("Descriptor (%p) and its copy (%p) have to be passed together",
+              descriptor,
+              newDescriptor);
+        return nullptr;
+    }
+
+    VPUBufferObject *newBuffer = ctx->createInternalBufferObject(buffer->getAllocSize(),
+                                                                 VPUBufferObject::Type::CachedLow,
+                                                                 false);
+    if (newBuffer == nullptr) {
+        LOG_E("Failed to allocate buffer object for shadow of %s command buffer", getName());
+        return nullptr;
+    }
+
+    auto cmdBuffer = std::make_unique<VPUCommandBuffer>(ctx, newBuffer, cmdSize, targetEngine);
+    if (newBuffer->getVPUAddr() % 64 != 0) {
+        LOG_E("Failed to get buffer object that is aligned to 64 bytes");
+        return nullptr;
+    }
+
+    for (auto handle : bufferHandles) {
+        if (handle != buffer->getHandle() &&
+            std::find(cmdBuffer->bufferHandles.begin(), cmdBuffer->bufferHandles.end(), handle) ==
+                cmdBuffer->bufferHandles.end())
+            cmdBuffer->bufferHandles.emplace_back(handle);
+    }
+
+    memcpy(newBuffer->getBasePointer(), buffer->getBasePointer(), buffer->getAllocSize());
+
+    auto *bb = reinterpret_cast<vpu_cmd_buffer_header_t *>(newBuffer->getBasePointer());
+    bb->context_save_area_address =
+        newBuffer->getVPUAddr() + offsetof(CommandHeader, contextSaveArea);
+
+    if (descriptor == nullptr)
+        return cmdBuffer;
+
+    if (!cmdBuffer->addUniqueBufferHandler(newDescriptor->getBasePointer())) {
+        LOG_E("Failed to append descriptor handle to shadow of %s command buffer", getName());
+        return nullptr;
+    }
+
+    // Offsets to descriptors stay valid after moving the heap base by the same distance
+    uint64_t delta = newDescriptor->getVPUAddr() - descriptor->getVPUAddr();
+    bb->descriptor_heap_base_address += delta;
+
+    // Fences of internal events live in the descriptor, user fences are not moved
+    FenceRelocation relocation = {descriptor->getVPUAddr(),
+                                  descriptor->getAllocSize(),
+                                  newDescriptor->getVPUAddr()};
+    if (!cmdBuffer->relocateFences(bb->cmd_offset, bb->cmd_buffer_size, relocation)) {
+        LOG_E("Failed to relocate fences in shadow of %s command buffer", getName());
+        return nullptr;
+    }
+
+    return cmdBuffer;
+}
+
+std::unique_ptr<VPUCommandBuffer> VPUCommandBuffer::mergeCommandBuffers(
+    VPUDeviceContext *ctx,
+    const std::vector<std::pair<const VPUCommandBuffer *, FenceRelocation>> &sources,
+    VPUBufferObject *fenceBuffer,
+    Target engineType) {
+    if (ctx == nullptr || sources.empty()) {
+        LOG_E("VPUDeviceContext is nullptr or command buffer list is empty");
+        return nullptr;
+    }
+
+    size_t cmdSize = 0;
+    for (const auto &[source, relocation] : sources) {
+        if (source->targetEngine != engineType) {
+            LOG_E("Command buffer for %s engine cannot be merged to %s command buffer",
+                  source->getName(),
+                  targetEngineToStr(engineType));
+            return nullptr;
+        }
+        cmdSize += source->cmdSize;
+    }
+
+    VPUBufferObject *buffer = ctx->createInternalBufferObject(sizeof(CommandHeader) + cmdSize,
+                                                              VPUBufferObject::Type::CachedLow,
+                                                              false);
+    if (buffer == nullptr) {
+        LOG_E("Failed to allocate buffer object for merged command buffer for %s engine",
+              targetEngineToStr(engineType));
+        return nullptr;
+    }
+
+    if (buffer->getVPUAddr() % 64 != 0) {
+        LOG_E("Failed to get buffer object that is aligned to 64 bytes");
+        return nullptr;
+    }
+
+    auto cmdBuffer = std::make_unique<VPUCommandBuffer>(ctx, buffer, cmdSize, engineType);
+    if (!cmdBuffer->initHeader()) {
+        LOG_E("Failed to initialize VPUCommandBuffer - %s", cmdBuffer->getName());
+        return nullptr;
+    }
+
+    if (fenceBuffer && !cmdBuffer->addUniqueBufferHandler(fenceBuffer->getBasePointer())) {
+        LOG_E("Failed to append fence buffer handle to command buffer %s", cmdBuffer->getName());
+        return nullptr;
+    }
+
+    auto *bb = reinterpret_cast<vpu_cmd_buffer_header_t *>(buffer->getBasePointer());
+    uint64_t cmdOffset = bb->cmd_offset;
+    for (const auto &[source, relocation] : sources) {
+        auto *sourceHeader =
+            reinterpret_cast<const vpu_cmd_buffer_header_t *>(source->buffer->getBasePointer());
+        if (sourceHeader->descriptor_heap_base_address != bb->descriptor_heap_base_address ||
+            sourceHeader->fence_heap_base_address != bb->fence_heap_base_address) {
+            LOG_E("Command buffer with moved heap base address cannot be merged");
+            return nullptr;
+        }
+
+        memcpy(buffer->getBasePointer() + cmdOffset,
+               source->buffer->getBasePointer() + sourceHeader->cmd_offset,
+               source->cmdSize);
+        if (!cmdBuffer->relocateFences(cmdOffset, cmdOffset + source->cmdSize, relocation)) {
+            LOG_E("Failed to relocate fences in merged %s command buffer", cmdBuffer->getName());
+            return nullptr;
+        }
+        cmdOffset += source->cmdSize;
+
+        for (auto handle : source->bufferHandles) {
+            if (handle != source->buffer->getHandle() &&
+                std::find(cmdBuffer->bufferHandles.begin(),
+                          cmdBuffer->bufferHandles.end(),
+                          handle) == cmdBuffer->bufferHandles.end())
+                cmdBuffer->bufferHandles.emplace_back(handle);
+        }
+    }
+
+    return cmdBuffer;
+}
+
+bool VPUCommandBuffer::relocateFences(uint64_t offset,
+                                      uint64_t endOffset,
+                                      const FenceRelocation &relocation) {
+    auto *bb = reinterpret_cast<vpu_cmd_buffer_header_t *>(buffer->getBasePointer());
+    while (offset + sizeof(vpu_cmd_header_t) <= endOffset) {
+        auto *cmd = reinterpret_cast<vpu_cmd_header_t *>(buffer->getBasePointer() + offset);
+        if (cmd->size == 0) {
+            LOG_E("Invalid command size at offset %lu", offset);
+            return false;
+        }
+
+        if (cmd->type == VPU_CMD_FENCE_SIGNAL || cmd->type == VPU_CMD_FENCE_WAIT) {
+            auto *fence = reinterpret_cast<vpu_cmd_fence_t *>(cmd);
+            uint64_t fenceAddress = bb->fence_heap_base_address + fence->offset;
+            if (fenceAddress >= relocation.vpuAddr &&
+                fenceAddress < relocation.vpuAddr + relocation.size)
+                fence->offset += relocation.newVpuAddr - relocation.vpuAddr;
+        }
+        offset += cmd->size;
+    }
+
+    return true;
+}
+
 bool VPUCommandBuffer::initHeader() {
     if (buffer == nullptr) {
         LOG_E("Invalid command buffer pointer is passed");
@@ -199,8 +378,9 @@ bool VPUCommandBuffer::addCommand(VPUCommand *cmd,
 }
 
 bool VPUCommandBuffer::waitForCompletion(int64_t timeout_abs_ns) {
+    // Handle is kept when the buffer is taken over by recycling command buffer
     drm_ivpu_bo_wait args = {};
-    args.handle = buffer->getHandle();
+    args.handle = bufferHandles.front();
     args.timeout_ns = timeout_abs_ns;
     args.job_status = std::numeric_limits<uint32_t>::max();
 
@@ -213,215 +393,22 @@ bool VPUCommandBuffer::waitForCompletion(int64_t timeout_abs_ns) {
     return true;
 }
 
-void VPUCommandBuffer::printDesc(vpu_cmd_resource_descriptor_table_t *table,
-                                 boost::safe_numerics::safe<size_t> size,
-                                 const char *type) const {
-    if (table == nullptr) {
-        LOG_I("Descriptor base pointer is not provided, skip printing descriptors");
-        return;
-    }
-
-    LOG_I("Blob %s command descriptor table (table pointer: %p, size: %lu):",
-          type,
-          table,
-          static_cast<size_t>(size));
-
-    for (int i = 0; size > sizeof(vpu_cmd_resource_descriptor); i++) {
-        LOG_I("Table: %i:\n\ttype = %#x\n\tdesc_count = %i", i, table->type, table->desc_count);
-        size_t count = table->desc_count;
-        table++;
-
-        vpu_cmd_resource_descriptor *desc = reinterpret_cast<decltype(desc)>(table);
-        for (size_t j = 0; j < count; j++) {
-            LOG_I("Entry %lu:\n\taddress = %#lx\n\twidth = %#x", j, desc->address, desc->width);
-            desc++;
-        }
-
-        table = reinterpret_cast<vpu_cmd_resource_descriptor_table_t *>(desc);
-        size -= count * sizeof(vpu_cmd_resource_descriptor) +
-                sizeof(vpu_cmd_resource_descriptor_table_t);
-    }
-}
-
-void VPUCommandBuffer::printCommandBuffer(void *descPtr) const {
-    if (getLogLevel() >= LogLevel::INFO)
-        return;
-
-    vpu_cmd_buffer_header_t *bb =
-        reinterpret_cast<vpu_cmd_buffer_header_t *>(buffer->getBasePointer());
-    LOG_I("Start %s command buffer printing:\n"
-          "\tCommand buffer ptr = %p\n"
-          "\tSize = %u bytes, commands offset %u\n"
-          "\tKernel heap addr = %#lx\n"
-          "\tDescriptor heap addr = %#lx\n"
-          "\tFence heap addr = %#lx",
-          targetEngineToStr(targetEngine),
-          bb,
-          bb->cmd_buffer_size,
-          bb->cmd_offset,
-          bb->kernel_heap_base_address,
-          bb->descriptor_heap_base_address,
-          bb->fence_heap_base_address);
-
-    uint8_t *descBasePtr = nullptr;
-    uint64_t descOffset = 0u;
-    if (descPtr == nullptr) {
-        LOG_V("Null pointer on descPtr.");
-    } else {
-        auto bo = ctx->findBuffer(descPtr);
-        if (bo == nullptr) {
-            LOG_E("Failed to find buffer.");
-            return;
-        }
-
-        descBasePtr = bo->getBasePointer();
-        if (descBasePtr == nullptr) {
-            LOG_E("Failed to get base pointer.");
-            return;
-        }
-
-        descOffset = bo->getVPUAddr() - bb->descriptor_heap_base_address;
-    }
-
-    size_t bbSize = bb->cmd_buffer_size;
-    size_t cmdOffset = bb->cmd_offset;
-    int i = 0;
-    while (cmdOffset < bbSize) {
-        vpu_cmd_header_t *cmd =
-            reinterpret_cast<vpu_cmd_header_t *>(reinterpret_cast<uintptr_t>(bb) + cmdOffset);
-
-        if (cmd->size <= 0 || cmd->size >= bb->cmd_buffer_size) {
-            LOG_E("Invalid command size, stop command buffer printing");
-            return;
-        }
-
-        switch (cmd->type) {
-        case VPU_CMD_TIMESTAMP:
-            LOG_I("Command %i: Timestamp (size: %u bytes)\n"
-                  "\ttimestamp_address = %#lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_timestamp_t *>(cmd)->timestamp_address);
-            break;
-        case VPU_CMD_FENCE_WAIT:
-            LOG_I("Command %i: Fence Wait (size: %u bytes)\n"
-                  "\toffset = %#lx, value = %#lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_fence_t *>(cmd)->offset,
-                  reinterpret_cast<vpu_cmd_fence_t *>(cmd)->value);
-            break;
-        case VPU_CMD_FENCE_SIGNAL:
-            LOG_I("Command %i: Fence Signal (size: %u bytes)\n"
-                  "\toffset = %#lx, value = %#lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_fence_t *>(cmd)->offset,
-                  reinterpret_cast<vpu_cmd_fence_t *>(cmd)->value);
-            break;
-        case VPU_CMD_BARRIER:
-            LOG_I("Command %i: Barrier (size: %u bytes)", i, cmd->size);
-            break;
-        case VPU_CMD_METRIC_QUERY_BEGIN:
-            LOG_I("Command %i: Metric Query Begin (size: %u bytes)\n"
-                  "\tmetric_group_type = %u, metric_data_address = %#lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_metric_query_t *>(cmd)->metric_group_type,
-                  reinterpret_cast<vpu_cmd_metric_query_t *>(cmd)->metric_data_address);
-            break;
-        case VPU_CMD_METRIC_QUERY_END:
-            LOG_I("Command %i: Metric Query End (size: %u bytes)\n"
-                  "\tmetric_group_type = %u, metric_data_address = %#lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_metric_query_t *>(cmd)->metric_group_type,
-                  reinterpret_cast<vpu_cmd_metric_query_t *>(cmd)->metric_data_address);
-            break;
-        case VPU_CMD_COPY_SYSTEM_TO_SYSTEM:
-            LOG_I("Command %i: Copy System to System (size: %u bytes)\n"
-                  "\tdesc_start_offset = %#lx, desc_count = %u",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_start_offset,
-                  reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_count);
-            ctx->printCopyDescriptor(
-                descBasePtr + reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_start_offset -
-                    descOffset,
-                cmd);
-            break;
-        case VPU_CMD_COPY_LOCAL_TO_LOCAL:
-            LOG_I("Command %i: Copy Local to Local (size: %u bytes)\n"
-                  "\tdesc_start_offset = %#lx, desc_count = %u",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_start_offset,
-                  reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_count);
-            ctx->printCopyDescriptor(
-                descBasePtr + reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_start_offset -
-                    descOffset,
-                cmd);
-            break;
-        case VPU_CMD_OV_BLOB_INITIALIZE:
-            LOG_I("Command %i: OV Blob Initialize (size: %u bytes)\n"
-                  "\tkernel_size = %u, kernel_offset = %#lx, desc_table_size = %u, "
-                  " desc_table_offset = %#lx, blob_id = %lu",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->kernel_size,
-                  reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->kernel_offset,
-                  reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->desc_table_size,
-                  reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->desc_table_offset,
-                  reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->blob_id);
-            printDesc(reinterpret_cast<vpu_cmd_resource_descriptor_table_t *>(
-                          descBasePtr +
-                          reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->desc_table_offset -
-                          descOffset),
-                      reinterpret_cast<vpu_cmd_ov_blob_initialize_t *>(cmd)->desc_table_size,
-                      "Initialize");
-            break;
-        case VPU_CMD_OV_BLOB_EXECUTE:
-            LOG_I("Command %i: OV Blob Execute (size: %u bytes)\n"
-                  "\tdesc_table_size = %u, desc_table_offset = %#lx, blob_id = %lu",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_ov_blob_execute_t *>(cmd)->desc_table_size,
-                  reinterpret_cast<vpu_cmd_ov_blob_execute_t *>(cmd)->desc_table_offset,
-                  reinterpret_cast<vpu_cmd_ov_blob_execute_t *>(cmd)->blob_id);
-            printDesc(reinterpret_cast<vpu_cmd_resource_descriptor_table_t *>(
-                          descBasePtr +
-                          reinterpret_cast<vpu_cmd_ov_blob_execute_t *>(cmd)->desc_table_offset -
-                          descOffset),
-                      reinterpret_cast<vpu_cmd_ov_blob_execute_t *>(cmd)->desc_table_size,
-                      "Execute");
-            break;
-        case VPU_CMD_INFERENCE_EXECUTE:
-            LOG_I(
-                "Command %i: Inference Execute (size %u bytes)\n"
-                "\tinference_id = %lu, host_mapped_inference.address = %#lx, "
-                "host_mapped_inference.size = %#x",
-                i,
-                cmd->size,
-                reinterpret_cast<vpu_cmd_inference_execute_t *>(cmd)->inference_id,
-                reinterpret_cast<vpu_cmd_inference_execute_t *>(cmd)->host_mapped_inference.address,
-                reinterpret_cast<vpu_cmd_inference_execute_t *>(cmd)->host_mapped_inference.width);
-            break;
-        case VPU_CMD_MEMORY_FILL:
-            LOG_I("Command %i: Memory fill (size: %u bytes) pattern = 0x%x addr=0x%lx",
-                  i,
-                  cmd->size,
-                  reinterpret_cast<vpu_cmd_memory_fill_t *>(cmd)->fill_pattern,
-                  reinterpret_cast<vpu_cmd_memory_fill_t *>(cmd)->start_address);
-            break;
-
-        default:
-            LOG_E("Unknown command, stop command buffer printing");
-            return;
-        }
-        cmdOffset += cmd->size;
-        i++;
-    }
-    LOG_I("Stop %s command buffer printing", targetEngineToStr(targetEngine));
+bool VPUCommandBuffer::writeCapture(const std::string &path,
+                                    const std::vector<const VPUBufferObject *> &heaps) const {
+    auto *bb = reinterpret_cast<const vpu_cmd_buffer_header_t *>(buffer->getBasePointer());
+    // Size from the header is kept within the buffer, decoder reports the difference
+    size_t size = std::min<size_t>(bb->cmd_buffer_size, buffer->getAllocSize());
+
+    VPUCommandDecoder::Capture capture;
+    capture.engine = getEngine();
+    capture.cmdBuffer.vpuAddr = buffer->getVPUAddr();
+    capture.cmdBuffer.data.assign(buffer->getBasePointer(), buffer->getBasePointer() + size);
+    for (const auto *heap : heaps)
+        capture.heaps.push_back(
+            {heap->getVPUAddr(),
+             {heap->getBasePointer(), heap->getBasePointer() + heap->getAllocSize()}});
+
+    return VPUCommandDecoder::writeCapture(path, capture);
 }
 
 } // namespace VPU
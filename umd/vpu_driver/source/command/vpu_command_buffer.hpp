@@ -12,10 +12,12 @@
 
 #include <linux/kernel.h>
 #include <array>
+#include <atomic>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
-#include <boost/safe_numerics/safe_integer.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
 namespace VPU {
@@ -34,6 +36,13 @@ class VPUCommandBuffer {
         return "UNKNOWN";
     }
 
+    /* Fences in range [vpuAddr, vpuAddr + size) are moved by the distance to newVpuAddr */
+    struct FenceRelocation {
+        uint64_t vpuAddr = 0;
+        size_t size = 0;
+        uint64_t newVpuAddr = 0;
+    };
+
     VPUCommandBuffer(VPUDeviceContext *ctx, VPUBufferObject *buffer, size_t cmdSize, Target type);
     ~VPUCommandBuffer();
 
@@ -44,6 +53,8 @@ class VPUCommandBuffer {
      * @param descPtr[in|out]: Pointer at the tail of descriptor table
      * @param descEnd[in]: The end of descriptor table for validation
      * @param targetEngine[in]: Submit a job to passed engine
+     * @param recycled[in]: Optional completed command buffer, its buffer object is taken over
+     *                      when it is big enough
      * @return unique_ptr<VPUCommandBuffer> for success, nullptr for any allocation failures
      */
     static std::unique_ptr<VPUCommandBuffer>
@@ -51,7 +62,32 @@ class VPUCommandBuffer {
                           const std::vector<std::shared_ptr<VPUCommand>> &cmds,
                           void **descPtr,
                           void *descEnd,
-                          Target targetEngine);
+                          Target targetEngine,
+                          VPUCommandBuffer *recycled = nullptr);
+
+    /**
+     * Create a copy of the command buffer that can be submitted while this buffer is in flight.
+     * Descriptor heap and internal fences placed in the descriptor are moved to newDescriptor.
+     * @param descriptor[in]: Descriptor buffer used by this command buffer, can be nullptr
+     * @param newDescriptor[in]: Copy of descriptor buffer to be used by new command buffer
+     * @return unique_ptr<VPUCommandBuffer> for success, nullptr otherwise
+     */
+    std::unique_ptr<VPUCommandBuffer> createShadowCopy(const VPUBufferObject *descriptor,
+                                                       VPUBufferObject *newDescriptor) const;
+
+    /**
+     * Allocate VPUCommandBuffer with commands of already encoded command buffers chained in order
+     * @param ctx[in]: Memory manager for device interaction
+     * @param sources[in]: Command buffers and range of fences to be moved in each of them
+     * @param fenceBuffer[in]: Buffer that holds moved fences, can be nullptr
+     * @param targetEngine[in]: Submit a job to passed engine, sources have to use the same engine
+     * @return unique_ptr<VPUCommandBuffer> for success, nullptr otherwise
+     */
+    static std::unique_ptr<VPUCommandBuffer> mergeCommandBuffers(
+        VPUDeviceContext *ctx,
+        const std::vector<std::pair<const VPUCommandBuffer *, FenceRelocation>> &sources,
+        VPUBufferObject *fenceBuffer,
+        Target targetEngine);
 
     /**
      * Return true if job is finished
@@ -81,15 +117,13 @@ class VPUCommandBuffer {
     const char *getName() const { return targetEngineToStr(targetEngine); }
 
     /**
-     * Print the content of blob initialize or blob execute descriptor
-     */
-    void printDesc(vpu_cmd_resource_descriptor_table_t *table,
-                   boost::safe_numerics::safe<size_t> size,
-                   const char *type) const;
-    /**
-     * Print the content of command buffer
+     * Write the command buffer and the descriptor heaps to a file for offline decoding
+     * @param path[in]: Capture file, @see VPUCommandDecoder
+     * @param heaps[in]: Buffers referenced by descriptor offsets of commands
+     * @return true if the capture is written
      */
-    void printCommandBuffer(void *descPtr) const;
+    bool writeCapture(const std::string &path,
+                      const std::vector<const VPUBufferObject *> &heaps) const;
 
     /**
      * Return the pointer to buffer. Used only for testing
@@ -104,6 +138,7 @@ class VPUCommandBuffer {
 
     bool addCommand(VPUCommand *cmd, uint64_t &cmdOffset, void **desc, void *descEnd);
     bool addUniqueBufferHandler(const void *ptr);
+    bool relocateFences(uint64_t offset, uint64_t endOffset, const FenceRelocation &relocation);
     bool copyCommandStructures(const VPUCommand *cmd, uint64_t offset);
 
   public:
@@ -128,7 +163,8 @@ class VPUCommandBuffer {
     VPUBufferObject *buffer;
     size_t cmdSize;
     Target targetEngine;
-    uint32_t jobStatus;
+    /* Updated by any thread that waits for the job */
+    std::atomic<uint32_t> jobStatus;
 
     std::vector<uint32_t> bufferHandles;
 };
@@ -0,0 +1,521 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <api/vpu_jsm_job_cmd_api.h>
+#include <uapi/drm/ivpu_accel.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <unistd.h>
+
+namespace VPU {
+
+/* Capture file starts with the header followed by the command buffer and heaps regions */
+struct CaptureHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t engine;
+    uint32_t heapCount;
+    uint32_t reserved;
+};
+
+/* Region header is followed by size bytes of region data */
+struct CaptureRegionHeader {
+    uint64_t vpuAddr;
+    uint64_t size;
+};
+
+struct CommandInfo {
+    uint16_t type;
+    const char *name;
+    /* Minimal size of the command, including the header */
+    size_t size;
+};
+
+static const CommandInfo commandInfos[] = {
+    {VPU_CMD_NOP, "NOP", sizeof(vpu_cmd_header_t)},
+    {VPU_CMD_TIMESTAMP, "TIMESTAMP", sizeof(vpu_cmd_timestamp_t)},
+    {VPU_CMD_FENCE_WAIT, "FENCE_WAIT", sizeof(vpu_cmd_fence_t)},
+    {VPU_CMD_FENCE_SIGNAL, "FENCE_SIGNAL", sizeof(vpu_cmd_fence_t)},
+    {VPU_CMD_BARRIER, "BARRIER", sizeof(vpu_cmd_barrier_t)},
+    {VPU_CMD_METRIC_QUERY_BEGIN, "METRIC_QUERY_BEGIN", sizeof(vpu_cmd_metric_query_t)},
+    {VPU_CMD_METRIC_QUERY_END, "METRIC_QUERY_END", sizeof(vpu_cmd_metric_query_t)},
+    {VPU_CMD_COPY_SYSTEM_TO_LOCAL, "COPY_SYSTEM_TO_LOCAL", sizeof(vpu_cmd_copy_buffer_t)},
+    {VPU_CMD_COPY_LOCAL_TO_SYSTEM, "COPY_LOCAL_TO_SYSTEM", sizeof(vpu_cmd_copy_buffer_t)},
+    {VPU_CMD_MEMORY_FILL, "MEMORY_FILL", sizeof(vpu_cmd_memory_fill_t)},
+    {VPU_CMD_COPY_SYSTEM_TO_SYSTEM, "COPY_SYSTEM_TO_SYSTEM", sizeof(vpu_cmd_copy_buffer_t)},
+    {VPU_CMD_DXIL, "DXIL", sizeof(vpu_cmd_dxil_t)},
+    {VPU_CMD_JIT_MAPPED_INFERENCE_EXECUTE,
+     "JIT_MAPPED_INFERENCE_EXECUTE",
+     sizeof(vpu_cmd_jit_mapped_inference_execute_t)},
+    {VPU_CMD_COPY_LOCAL_TO_LOCAL, "COPY_LOCAL_TO_LOCAL", sizeof(vpu_cmd_copy_buffer_t)},
+    {VPU_CMD_CLEAR_BUFFER, "CLEAR_BUFFER", sizeof(vpu_cmd_clear_buffer_t)},
+    {VPU_CMD_OV_BLOB_INITIALIZE, "OV_BLOB_INITIALIZE", sizeof(vpu_cmd_ov_blob_initialize_t)},
+    {VPU_CMD_OV_BLOB_EXECUTE, "OV_BLOB_EXECUTE", sizeof(vpu_cmd_ov_blob_execute_t)},
+    {VPU_CMD_INFERENCE_EXECUTE, "INFERENCE_EXECUTE", sizeof(vpu_cmd_inference_execute_t)},
+    {VPU_CMD_DXIL_COPY, "DXIL_COPY", sizeof(vpu_cmd_header_t)},
+};
+
+/* Commands of 0x02xx range run only on copy engine and 0x03xx range only on compute engine */
+static constexpr uint16_t commandRangeMask = 0xff00;
+static constexpr uint16_t copyCommandRange = 0x0200;
+static constexpr uint16_t computeCommandRange = 0x0300;
+
+/* Descriptor tables of blob initialize are in 0x01xx range and of blob execute in 0x02xx */
+static constexpr uint16_t descTableRangeMask = 0xff00;
+
+/* Command list and copy descriptors have to be aligned to firmware cache line */
+static constexpr uint64_t fwCacheLineSize = 64;
+
+static const CommandInfo *findCommandInfo(uint16_t type) {
+    for (const auto &info : commandInfos)
+        if (info.type == type)
+            return &info;
+    return nullptr;
+}
+
+static const char *engineToStr(uint32_t engine) {
+    switch (engine) {
+    case DRM_IVPU_ENGINE_COMPUTE:
+        return "COMPUTE";
+    case DRM_IVPU_ENGINE_COPY:
+        return "COPY";
+    }
+    return "UNKNOWN";
+}
+
+static const char *descTableTypeToStr(uint16_t type) {
+    switch (type) {
+    case VPU_DESC_TABLE_ENTRY_TYPE_SCRATCH:
+        return "SCRATCH";
+    case VPU_DESC_TABLE_ENTRY_TYPE_METADATA:
+        return "METADATA";
+    case VPU_DESC_TABLE_ENTRY_TYPE_WEIGHTS:
+        return "WEIGHTS";
+    case VPU_DESC_TABLE_ENTRY_TYPE_KERNEL_DATA:
+        return "KERNEL_DATA";
+    case VPU_DESC_TABLE_ENTRY_TYPE_INPUT:
+        return "INPUT";
+    case VPU_DESC_TABLE_ENTRY_TYPE_OUTPUT:
+        return "OUTPUT";
+    case VPU_DESC_TABLE_ENTRY_TYPE_PROFILING_OUTPUT:
+        return "PROFILING_OUTPUT";
+    }
+    return "UNKNOWN";
+}
+
+__attribute__((format(printf, 1, 2))) static std::string format(const char *fmt, ...) {
+    char str[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(str, sizeof(str), fmt, args);
+    va_end(args);
+    return str;
+}
+
+/* Walks the command buffer once, builds the listing and collects rule violations */
+class CommandBufferWalker {
+  public:
+    explicit CommandBufferWalker(const VPUCommandDecoder::Capture &capture)
+        : capture(capture) {}
+
+    VPUCommandDecoder::Result walk();
+
+  private:
+    void print(const std::string &line) { result.listing += line + '\n'; }
+    void error(const std::string &message) {
+        result.listing += "        error: " + message + '\n';
+        result.errors.push_back(location + ": " + message);
+    }
+
+    const uint8_t *resolve(uint64_t vpuAddr, uint64_t size) const;
+    void decodeCommand(const vpu_cmd_header_t *cmd, const CommandInfo *info);
+    void decodeCopy(const vpu_cmd_copy_buffer_t *cmd);
+    void decodeDescriptorTables(uint64_t offset, uint32_t size, uint16_t tableRange);
+
+    const VPUCommandDecoder::Capture &capture;
+    const vpu_cmd_buffer_header_t *header = nullptr;
+    /* Offset and name of decoded command that prefixes error messages */
+    std::string location = "header";
+    VPUCommandDecoder::Result result;
+};
+
+const uint8_t *CommandBufferWalker::resolve(uint64_t vpuAddr, uint64_t size) const {
+    for (const auto &heap : capture.heaps) {
+        if (vpuAddr < heap.vpuAddr)
+            continue;
+
+        uint64_t offset = vpuAddr - heap.vpuAddr;
+        if (offset <= heap.data.size() && size <= heap.data.size() - offset)
+            return heap.data.data() + offset;
+    }
+    return nullptr;
+}
+
+VPUCommandDecoder::Result CommandBufferWalker::walk() {
+    const auto &buffer = capture.cmdBuffer.data;
+    if (buffer.size() < sizeof(vpu_cmd_buffer_header_t)) {
+        error(format("command buffer of %zu bytes is smaller than its header", buffer.size()));
+        return result;
+    }
+
+    header = reinterpret_cast<const vpu_cmd_buffer_header_t *>(buffer.data());
+    print(format("%s command buffer at %#lx, size %u bytes, commands at %#x",
+                 engineToStr(capture.engine),
+                 capture.cmdBuffer.vpuAddr,
+                 header->cmd_buffer_size,
+                 header->cmd_offset));
+    print(format("    kernel heap %#lx, descriptor heap %#lx, fence heap %#lx",
+                 header->kernel_heap_base_address,
+                 header->descriptor_heap_base_address,
+                 header->fence_heap_base_address));
+    print(format("    context save area %#lx", header->context_save_area_address));
+    for (const auto &heap : capture.heaps)
+        print(format("    captured heap %#lx, size %zu bytes", heap.vpuAddr, heap.data.size()));
+
+    if (capture.engine != DRM_IVPU_ENGINE_COMPUTE && capture.engine != DRM_IVPU_ENGINE_COPY)
+        error(format("unknown engine %u", capture.engine));
+
+    size_t end = header->cmd_buffer_size;
+    if (end > buffer.size()) {
+        error(format("command buffer size %zu exceeds %zu captured bytes", end, buffer.size()));
+        end = buffer.size();
+    }
+
+    size_t offset = header->cmd_offset;
+    if (offset < sizeof(vpu_cmd_buffer_header_t) || offset > end) {
+        error(format("commands offset %#zx is outside of command buffer", offset));
+        return result;
+    }
+    if (offset % fwCacheLineSize)
+        error(format("commands offset %#zx is not aligned to 64 bytes", offset));
+
+    size_t count = 0;
+    while (offset < end) {
+        location = format("+%#06zx", offset);
+        if (end - offset < sizeof(vpu_cmd_header_t)) {
+            error(format("truncated command header of %zu bytes", end - offset));
+            break;
+        }
+
+        auto *cmd = reinterpret_cast<const vpu_cmd_header_t *>(buffer.data() + offset);
+        const CommandInfo *info = findCommandInfo(cmd->type);
+        location += info ? format(" %s", info->name) : format(" type %#x", cmd->type);
+        print(format("%s (%u bytes)", location.c_str(), cmd->size));
+
+        if (cmd->size < sizeof(vpu_cmd_header_t) || cmd->size > end - offset) {
+            error(format("command size %u is outside of command buffer", cmd->size));
+            break;
+        }
+
+        decodeCommand(cmd, info);
+        offset += cmd->size;
+        count++;
+    }
+
+    location = "buffer";
+    print(format("%zu commands", count));
+    return result;
+}
+
+void CommandBufferWalker::decodeCommand(const vpu_cmd_header_t *cmd, const CommandInfo *info) {
+    if (info == nullptr) {
+        error(format("unknown command type %#x", cmd->type));
+        return;
+    }
+
+    if (cmd->size < info->size) {
+        error(format("command size %u is smaller than %zu", cmd->size, info->size));
+        return;
+    }
+
+    uint16_t range = cmd->type & commandRangeMask;
+    if ((range == copyCommandRange && capture.engine != DRM_IVPU_ENGINE_COPY) ||
+        (range == computeCommandRange && capture.engine != DRM_IVPU_ENGINE_COMPUTE))
+        error(format("command is not supported by %s engine", engineToStr(capture.engine)));
+
+    switch (cmd->type) {
+    case VPU_CMD_TIMESTAMP: {
+        auto *ts = reinterpret_cast<const vpu_cmd_timestamp_t *>(cmd);
+        print(format("        timestamp_address = %#lx", ts->timestamp_address));
+        if (ts->timestamp_address == 0)
+            error("timestamp address is null");
+        break;
+    }
+    case VPU_CMD_FENCE_WAIT:
+    case VPU_CMD_FENCE_SIGNAL: {
+        auto *fence = reinterpret_cast<const vpu_cmd_fence_t *>(cmd);
+        uint64_t address = header->fence_heap_base_address + fence->offset;
+        print(format("        offset = %#lx (address %#lx), value = %#lx",
+                     fence->offset,
+                     address,
+                     fence->value));
+        if (address % VPU_FENCE_SIZE)
+            error(format("fence address %#lx is not aligned to %u bytes", address, VPU_FENCE_SIZE));
+        break;
+    }
+    case VPU_CMD_METRIC_QUERY_BEGIN:
+    case VPU_CMD_METRIC_QUERY_END: {
+        auto *query = reinterpret_cast<const vpu_cmd_metric_query_t *>(cmd);
+        print(format("        metric_group_type = %u, metric_data_address = %#lx",
+                     query->metric_group_type,
+                     query->metric_data_address));
+        break;
+    }
+    case VPU_CMD_COPY_SYSTEM_TO_LOCAL:
+    case VPU_CMD_COPY_LOCAL_TO_SYSTEM:
+    case VPU_CMD_COPY_SYSTEM_TO_SYSTEM:
+    case VPU_CMD_COPY_LOCAL_TO_LOCAL:
+        decodeCopy(reinterpret_cast<const vpu_cmd_copy_buffer_t *>(cmd));
+        break;
+    case VPU_CMD_MEMORY_FILL: {
+        auto *fill = reinterpret_cast<const vpu_cmd_memory_fill_t *>(cmd);
+        print(format("        start_address = %#lx, size = %#lx, fill_pattern = %#x",
+                     fill->start_address,
+                     fill->size,
+                     fill->fill_pattern));
+        if (fill->start_address == 0 || fill->size == 0)
+            error("memory fill range is empty");
+        break;
+    }
+    case VPU_CMD_CLEAR_BUFFER: {
+        auto *clear = reinterpret_cast<const vpu_cmd_clear_buffer_t *>(cmd);
+        print(format("        start_address = %#lx, size = %#lx",
+                     clear->start_address,
+                     clear->size));
+        if (clear->start_address == 0 || clear->size == 0)
+            error("clear buffer range is empty");
+        break;
+    }
+    case VPU_CMD_OV_BLOB_INITIALIZE: {
+        auto *init = reinterpret_cast<const vpu_cmd_ov_blob_initialize_t *>(cmd);
+        print(format("        kernel_size = %u, kernel_offset = %#lx (address %#lx), blob_id = %lu",
+                     init->kernel_size,
+                     init->kernel_offset,
+                     header->kernel_heap_base_address + init->kernel_offset,
+                     init->blob_id));
+        decodeDescriptorTables(init->desc_table_offset,
+                               init->desc_table_size,
+                               VPU_DESC_TABLE_ENTRY_TYPE_SCRATCH & descTableRangeMask);
+        break;
+    }
+    case VPU_CMD_OV_BLOB_EXECUTE: {
+        auto *exe = reinterpret_cast<const vpu_cmd_ov_blob_execute_t *>(cmd);
+        print(format("        blob_id = %lu", exe->blob_id));
+        decodeDescriptorTables(exe->desc_table_offset,
+                               exe->desc_table_size,
+                               VPU_DESC_TABLE_ENTRY_TYPE_INPUT & descTableRangeMask);
+        break;
+    }
+    case VPU_CMD_INFERENCE_EXECUTE: {
+        auto *inference = reinterpret_cast<const vpu_cmd_inference_execute_t *>(cmd);
+        print(format("        inference_id = %lu, host_mapped_inference = %#lx (%u bytes)",
+                     inference->inference_id,
+                     inference->host_mapped_inference.address,
+                     inference->host_mapped_inference.width));
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void CommandBufferWalker::decodeCopy(const vpu_cmd_copy_buffer_t *cmd) {
+    uint64_t address = header->descriptor_heap_base_address + cmd->desc_start_offset;
+    print(format("        desc_start_offset = %#lx (address %#lx), desc_count = %u",
+                 cmd->desc_start_offset,
+                 address,
+                 cmd->desc_count));
+
+    if (cmd->desc_count == 0 || cmd->desc_count > VPU_CMD_COPY_DESC_COUNT_MAX) {
+        error(format("descriptor count %u is outside of [1, %u]",
+                     cmd->desc_count,
+                     VPU_CMD_COPY_DESC_COUNT_MAX));
+        return;
+    }
+    if (address % fwCacheLineSize)
+        error(format("descriptors address %#lx is not aligned to 64 bytes", address));
+
+    uint64_t size = cmd->desc_count * sizeof(vpu_cmd_copy_descriptor_mtl_t);
+    auto *desc = reinterpret_cast<const vpu_cmd_copy_descriptor_mtl_t *>(resolve(address, size));
+    if (desc == nullptr) {
+        error(format("descriptors [%#lx, %#lx) are outside of captured heaps",
+                     address,
+                     address + size));
+        return;
+    }
+
+    for (uint32_t i = 0; i < cmd->desc_count; i++, desc++) {
+        print(format("        [%u] src_address = %#lx, dst_address = %#lx, size = %u",
+                     i,
+                     desc->src_address,
+                     desc->dst_address,
+                     desc->size));
+        if (desc->src_address == 0 || desc->dst_address == 0 || desc->size == 0)
+            error(format("copy descriptor %u is empty", i));
+    }
+}
+
+void CommandBufferWalker::decodeDescriptorTables(uint64_t offset,
+                                                 uint32_t size,
+                                                 uint16_t tableRange) {
+    uint64_t address = header->descriptor_heap_base_address + offset;
+    print(format("        desc_table_offset = %#lx (address %#lx), desc_table_size = %u",
+                 offset,
+                 address,
+                 size));
+
+    const uint8_t *tables = resolve(address, size);
+    if (tables == nullptr) {
+        error(format("descriptor tables [%#lx, %#lx) are outside of captured heaps",
+                     address,
+                     address + size));
+        return;
+    }
+
+    size_t pos = 0;
+    while (pos < size) {
+        if (size - pos < sizeof(vpu_cmd_resource_descriptor_table_t)) {
+            error(format("truncated descriptor table at %#lx", address + pos));
+            return;
+        }
+
+        auto *table = reinterpret_cast<const vpu_cmd_resource_descriptor_table_t *>(tables + pos);
+        print(format("        table %s (%#x), desc_count = %u",
+                     descTableTypeToStr(table->type),
+                     table->type,
+                     table->desc_count));
+        if ((table->type & descTableRangeMask) != tableRange)
+            error(format("descriptor table type %#x is not valid for the command", table->type));
+
+        pos += sizeof(vpu_cmd_resource_descriptor_table_t);
+        size_t entriesSize = table->desc_count * sizeof(vpu_cmd_resource_descriptor_t);
+        if (entriesSize > size - pos) {
+            error(format("descriptors of table at %#lx exceed table size %u",
+                         address + pos - sizeof(vpu_cmd_resource_descriptor_table_t),
+                         size));
+            return;
+        }
+
+        auto *desc = reinterpret_cast<const vpu_cmd_resource_descriptor_t *>(tables + pos);
+        for (uint16_t i = 0; i < table->desc_count; i++, desc++)
+            print(format("          [%u] address = %#lx, width = %u",
+                         i,
+                         desc->address,
+                         desc->width));
+        pos += entriesSize;
+    }
+}
+
+VPUCommandDecoder::Result VPUCommandDecoder::decode(const Capture &capture) {
+    return CommandBufferWalker(capture).walk();
+}
+
+const char *VPUCommandDecoder::commandTypeToStr(uint16_t type) {
+    const CommandInfo *info = findCommandInfo(type);
+    return info ? info->name : "UNKNOWN";
+}
+
+static bool writeRegion(FILE *file, const VPUCommandDecoder::Region &region) {
+    CaptureRegionHeader header = {region.vpuAddr, region.data.size()};
+    return fwrite(&header, sizeof(header), 1, file) == 1 &&
+           fwrite(region.data.data(), 1, region.data.size(), file) == region.data.size();
+}
+
+bool VPUCommandDecoder::writeCapture(const std::string &path, const Capture &capture) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        LOG_E("Failed to open command buffer capture file %s", path.c_str());
+        return false;
+    }
+
+    CaptureHeader header = {};
+    memcpy(header.magic, captureMagic, sizeof(header.magic));
+    header.version = captureVersion;
+    header.engine = capture.engine;
+    header.heapCount = static_cast<uint32_t>(capture.heaps.size());
+
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   writeRegion(file, capture.cmdBuffer);
+    for (const auto &heap : capture.heaps)
+        success = success && writeRegion(file, heap);
+    if (fclose(file) != 0)
+        success = false;
+
+    if (!success)
+        LOG_E("Failed to write command buffer capture file %s", path.c_str());
+    return success;
+}
+
+static bool readRegion(FILE *file, size_t fileSize, VPUCommandDecoder::Region &region) {
+    CaptureRegionHeader header = {};
+    if (fread(&header, sizeof(header), 1, file) != 1)
+        return false;
+
+    // Size is checked against the file before allocation, capture may be corrupted
+    long pos = ftell(file);
+    if (pos < 0 || header.size > fileSize - static_cast<size_t>(pos))
+        return false;
+
+    region.vpuAddr = header.vpuAddr;
+    region.data.resize(header.size);
+    return fread(region.data.data(), 1, region.data.size(), file) == region.data.size();
+}
+
+bool VPUCommandDecoder::readCapture(const std::string &path, Capture &capture) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        LOG_E("Failed to open command buffer capture file %s", path.c_str());
+        return false;
+    }
+
+    long fileSize = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        fileSize = ftell(file);
+        rewind(file);
+    }
+
+    CaptureHeader header = {};
+    bool success = fileSize >= 0 && fread(&header, sizeof(header), 1, file) == 1 &&
+                   memcmp(header.magic, captureMagic, sizeof(header.magic)) == 0 &&
+                   header.version == captureVersion;
+    if (success) {
+        capture.engine = header.engine;
+        success = readRegion(file, static_cast<size_t>(fileSize), capture.cmdBuffer);
+    }
+    capture.heaps.clear();
+    for (uint32_t i = 0; success && i < header.heapCount; i++)
+        success = readRegion(file, static_cast<size_t>(fileSize), capture.heaps.emplace_back());
+    fclose(file);
+
+    if (!success)
+        LOG_E("File %s is not a valid command buffer capture", path.c_str());
+    return success;
+}
+
+static std::mutex captureMtx;
+static std::string captureDirectory;
+static uint64_t captureCount = 0;
+
+void VPUCommandDecoder::setCaptureDirectory(std::string_view dir) {
+    const std::lock_guard<std::mutex> lock(captureMtx);
+    captureDirectory = dir;
+    captureEnabled.store(!dir.empty(), std::memory_order_relaxed);
+}
+
+std::string VPUCommandDecoder::getNextCapturePath(uint32_t engine) {
+    const std::lock_guard<std::mutex> lock(captureMtx);
+    return captureDirectory +
+           format("/vpu_cmdbuf_%d_%06lu_%s.bin", getpid(), captureCount++, engineToStr(engine));
+}
+
+} // namespace VPU
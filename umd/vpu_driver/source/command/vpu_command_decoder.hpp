@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VPU {
+
+/**
+ * Offline disassembler and validator of command buffers.
+ *
+ * A capture holds the command buffer together with the descriptor heaps its commands refer to,
+ * each with the VPU address it had at submission. The driver writes captures only when a capture
+ * directory is set (VPU_DRV_CMDBUF_CAPTURE_DIR), the decoding is done by vpu-cmdbuf-decode tool
+ * or by tests, so the submission path does not walk the command buffer.
+ */
+class VPUCommandDecoder {
+  public:
+    static constexpr char captureMagic[8] = "VPUCMDB";
+    static constexpr uint32_t captureVersion = 1;
+
+    struct Region {
+        uint64_t vpuAddr = 0;
+        std::vector<uint8_t> data;
+    };
+
+    struct Capture {
+        /* Engine the command buffer was submitted to, @see VPUCommandBuffer::Target */
+        uint32_t engine = 0;
+        Region cmdBuffer;
+        /* Descriptor heaps referenced by the commands */
+        std::vector<Region> heaps;
+    };
+
+    struct Result {
+        std::string listing;
+        /* Rule violations, each starts with the offset of command in the command buffer */
+        std::vector<std::string> errors;
+
+        bool isValid() const { return errors.empty(); }
+    };
+
+    static bool writeCapture(const std::string &path, const Capture &capture);
+    static bool readCapture(const std::string &path, Capture &capture);
+
+    /**
+     * Decode the command buffer and validate its header, command sizes, engine of commands and
+     * ranges of descriptors referenced by the commands. Descriptors are decoded in MTL layout.
+     */
+    static Result decode(const Capture &capture);
+
+    static const char *commandTypeToStr(uint16_t type);
+
+    /**
+     * Set directory where submitted command buffers are captured, empty string disables capturing
+     */
+    static void setCaptureDirectory(std::string_view dir);
+    static bool isCaptureEnabled() { return captureEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Return unique path of the next capture file in the capture directory
+     */
+    static std::string getNextCapturePath(uint32_t engine);
+
+  private:
+    static inline std::atomic<bool> captureEnabled = false;
+};
+
+} // namespace VPU
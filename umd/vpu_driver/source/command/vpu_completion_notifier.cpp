@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_completion_notifier.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace VPU {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word has to be 32 bit");
+
+static uint32_t *futexWord(std::atomic<uint32_t> &value) {
+    return reinterpret_cast<uint32_t *>(&value);
+}
+
+VPUCompletionNotifier::~VPUCompletionNotifier() {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+
+    if (thread.joinable())
+        thread.join();
+}
+
+void VPUCompletionNotifier::trackJob(const std::shared_ptr<VPUJob> &job) {
+    bool completed = false;
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        completed = pruneJobs();
+
+        // Jobs of command lists are submitted again on every execute
+        auto [it, inserted] = submissions.insert_or_assign(job, ++lastSubmission);
+        if (inserted)
+            jobs.emplace_back(job);
+    }
+
+    if (completed)
+        notify();
+    cv.notify_all();
+}
+
+bool VPUCompletionNotifier::pruneJobs() {
+    bool completed = false;
+    while (!jobs.empty()) {
+        std::shared_ptr<VPUJob> job = jobs.front().lock();
+        JobRef weakJob = std::move(jobs.front());
+        jobs.pop_front();
+
+        if (job && !job->waitForCompletion(0)) {
+            jobs.emplace_back(std::move(weakJob));
+            break;
+        }
+
+        submissions.erase(weakJob);
+        completed = completed || job != nullptr;
+    }
+    return completed;
+}
+
+void VPUCompletionNotifier::untrack(const std::vector<std::pair<JobRef, uint64_t>> &completed) {
+    size_t count = submissions.size();
+    for (const auto &[weakJob, submission] : completed) {
+        // Job submitted again while it was checked stays tracked
+        auto it = submissions.find(weakJob);
+        if (it != submissions.end() && it->second == submission)
+            submissions.erase(it);
+    }
+
+    if (count == submissions.size())
+        return;
+
+    jobs.erase(std::remove_if(jobs.begin(),
+                              jobs.end(),
+                              [this](const JobRef &weakJob) {
+                                  return submissions.find(weakJob) == submissions.end();
+                              }),
+               jobs.end());
+}
+
+void VPUCompletionNotifier::notify() {
+    sequence++;
+    syscall(SYS_futex, futexWord(sequence), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+bool VPUCompletionNotifier::wait(uint32_t seq, int64_t timeout_abs_ns) {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        if (!thread.joinable())
+            thread = std::thread(&VPUCompletionNotifier::notificationThread, this);
+        waiters++;
+    }
+    cv.notify_all();
+
+    bool woken = true;
+    while (sequence.load() == seq) {
+        int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        if (now >= timeout_abs_ns) {
+            woken = false;
+            break;
+        }
+
+        struct timespec ts = {};
+        int64_t remaining = timeout_abs_ns - now;
+        ts.tv_sec = remaining / 1'000'000'000;
+        ts.tv_nsec = remaining % 1'000'000'000;
+        if (syscall(SYS_futex, futexWord(sequence), FUTEX_WAIT_PRIVATE, seq, &ts, nullptr, 0) ==
+                -1 &&
+            errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+            LOG_E("Failed to wait on completion sequence, errno: %d", errno);
+            woken = false;
+            break;
+        }
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        waiters--;
+    }
+    return woken;
+}
+
+size_t VPUCompletionNotifier::getTrackedJobCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return jobs.size();
+}
+
+void VPUCompletionNotifier::notificationThread() {
+    LOG_V("Completion notification thread started");
+
+    struct TrackedJob {
+        JobRef weakJob;
+        std::shared_ptr<VPUJob> job;
+        uint64_t submission;
+    };
+    std::vector<TrackedJob> tracked;
+    std::vector<std::pair<JobRef, uint64_t>> completed;
+
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!stop) {
+        cv.wait(lock, [this] { return stop || (waiters > 0 && !jobs.empty()); });
+        if (stop)
+            break;
+
+        for (const auto &weakJob : jobs)
+            tracked.push_back({weakJob, weakJob.lock(), submissions[weakJob]});
+        lock.unlock();
+
+        // All jobs are polled, the thread blocks in KMD only on one job and only when nothing
+        // has completed, so any completion is noticed within one wait slice
+        for (const auto &entry : tracked) {
+            if (!entry.job || entry.job->waitForCompletion(0))
+                completed.emplace_back(entry.weakJob, entry.submission);
+        }
+
+        const auto &first = tracked.front();
+        if (completed.empty() &&
+            first.job->waitForCompletion(getAbsoluteTimeoutNanoseconds(jobWaitSliceNs)))
+            completed.emplace_back(first.weakJob, first.submission);
+        tracked.clear();
+
+        lock.lock();
+        untrack(completed);
+        if (!completed.empty()) {
+            completed.clear();
+            lock.unlock();
+            notify();
+            lock.lock();
+        }
+    }
+
+    LOG_V("Completion notification thread stopped");
+}
+
+} // namespace VPU
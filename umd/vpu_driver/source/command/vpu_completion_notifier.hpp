@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VPU {
+
+class VPUJob;
+
+/**
+   Wakes up host waiters that do not know which job delivers their signal. Submitted jobs are
+   tracked and, while there is any waiter, a notification thread blocks in KMD on them. Every
+   job completion and every host signal increments the sequence and wakes the waiters through
+   a futex, so idle waiters do not consume CPU time.
+
+   Each round the thread polls all tracked jobs without blocking and then blocks on the oldest
+   one for at most jobWaitSliceNs, so a completion is noticed within one slice regardless of
+   the number of tracked jobs.
+ */
+class VPUCompletionNotifier {
+  public:
+    /* Time the notification thread blocks on the oldest job before it polls all jobs again */
+    static constexpr int64_t jobWaitSliceNs = 1'000'000;
+
+    VPUCompletionNotifier() = default;
+    ~VPUCompletionNotifier();
+
+    VPUCompletionNotifier(const VPUCompletionNotifier &) = delete;
+    VPUCompletionNotifier &operator=(const VPUCompletionNotifier &) = delete;
+
+    /**
+       Track submitted job, completion of the job wakes up the waiters. Job that is already
+       tracked is not added again. Each call checks tracked jobs from the head of the queue,
+       drops completed ones and moves the first busy one to the back, so the queue holds only
+       jobs that may be in flight without a full scan per submission.
+     */
+    void trackJob(const std::shared_ptr<VPUJob> &job);
+
+    /**
+       Increment the sequence and wake up all waiters.
+     */
+    void notify();
+
+    uint32_t getSequence() const { return sequence.load(); }
+
+    /**
+       Block until the sequence differs from given one or absolute timeout expires.
+       @param seq sequence observed by the caller before it checked its condition
+       @param timeout_abs_ns absolute steady clock timeout
+       @return false if timeout expired or the wait failed, true otherwise
+     */
+    bool wait(uint32_t seq, int64_t timeout_abs_ns);
+
+    size_t getTrackedJobCount() const;
+
+  private:
+    using JobRef = std::weak_ptr<VPUJob>;
+
+    void notificationThread();
+    /* Following helpers require the lock to be held */
+    bool pruneJobs();
+    void untrack(const std::vector<std::pair<JobRef, uint64_t>> &completed);
+
+    std::atomic<uint32_t> sequence = 0;
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    /* Tracked jobs, each one once */
+    std::deque<JobRef> jobs;
+    /* Last submission of tracked job, completion of older submission does not untrack it */
+    std::map<JobRef, uint64_t, std::owner_less<JobRef>> submissions;
+    uint64_t lastSubmission = 0;
+    uint32_t waiters = 0;
+    bool stop = false;
+    std::thread thread;
+};
+
+} // namespace VPU
@@ -12,6 +12,7 @@
 #include "vpu_driver/source/utilities/log.hpp"
 
 #include <boost/numeric/conversion/cast.hpp>
+#include <algorithm>
 #include <cstdint>
 
 namespace VPU {
@@ -36,19 +37,123 @@ VPUCopyCommand::create(VPUDeviceContext *ctx, const void *srcPtr, void *dstPtr,
     return std::make_shared<VPUCopyCommand>(ctx, srcPtr, dstPtr, size, copyDirection, descriptor);
 }
 
+std::vector<std::shared_ptr<VPUCopyCommand>>
+VPUCopyCommand::createRegion(VPUDeviceContext *ctx,
+                             const void *srcPtr,
+                             const Region &srcRegion,
+                             void *dstPtr,
+                             const Region &dstRegion,
+                             size_t width,
+                             size_t height,
+                             size_t depth) {
+    if (ctx == nullptr || srcPtr == nullptr || dstPtr == nullptr) {
+        LOG_E("Invalid context(%p), source(%p) or destination(%p)", ctx, srcPtr, dstPtr);
+        return {};
+    }
+
+    if (width == 0 || height == 0 || depth == 0 || width > maxDescriptorCopySize) {
+        LOG_E("Invalid copy region size %lux%lux%lu", width, height, depth);
+        return {};
+    }
+
+    for (const auto *region : {&srcRegion, &dstRegion}) {
+        if ((height > 1 && region->pitch < width) ||
+            (depth > 1 && region->slicePitch < region->pitch * (height - 1) + width)) {
+            LOG_E("Pitch %lu or slice pitch %lu is too small for region %lux%lu",
+                  region->pitch,
+                  region->slicePitch,
+                  width,
+                  height);
+            return {};
+        }
+    }
+
+    auto *src = static_cast<const uint8_t *>(srcPtr);
+    auto *dst = static_cast<uint8_t *>(dstPtr);
+    auto lastByte = [&](const Region &region) {
+        return region.offset + (depth - 1) * region.slicePitch + (height - 1) * region.pitch +
+               width - 1;
+    };
+    if (ctx->findBuffer(src + lastByte(srcRegion)) != ctx->findBuffer(srcPtr) ||
+        ctx->findBuffer(dst + lastByte(dstRegion)) != ctx->findBuffer(dstPtr)) {
+        LOG_E("Copy region exceeds source or destination allocation");
+        return {};
+    }
+
+    auto copyDirection = ctx->getCopyDirection(dstPtr, srcPtr);
+    if (copyDirection == COPY_INVALID) {
+        LOG_E("Wrong memory type assigned during srcptr/dstptr allocation.");
+        return {};
+    }
+
+    // Contiguous rows and slices are copied by single descriptor
+    size_t rowSize = width;
+    size_t rows = height * depth;
+    bool rowsContiguous = height == 1 || (srcRegion.pitch == width && dstRegion.pitch == width);
+    if (rowsContiguous && width * height <= maxDescriptorCopySize) {
+        rowSize = width * height;
+        rows = depth;
+        bool slicesContiguous = depth == 1 || (srcRegion.slicePitch == rowSize &&
+                                               dstRegion.slicePitch == rowSize);
+        if (slicesContiguous && rowSize * depth <= maxDescriptorCopySize) {
+            rowSize *= depth;
+            rows = 1;
+        }
+    }
+
+    auto rowOffset = [&](const Region &region, size_t row) {
+        if (rowSize >= width * height)
+            return region.offset + row * region.slicePitch;
+        return region.offset + (row / height) * region.slicePitch + (row % height) * region.pitch;
+    };
+
+    std::vector<std::shared_ptr<VPUCopyCommand>> commands;
+    for (size_t first = 0; first < rows; first += VPU_CMD_COPY_DESC_COUNT_MAX) {
+        size_t count = std::min<size_t>(rows - first, VPU_CMD_COPY_DESC_COUNT_MAX);
+
+        VPUDescriptor descriptor;
+        for (size_t row = first; row < first + count; row++) {
+            if (!ctx->getCopyCommandDescriptor(src + rowOffset(srcRegion, row),
+                                               dst + rowOffset(dstRegion, row),
+                                               rowSize,
+                                               descriptor))
+                return {};
+        }
+
+        auto cmd = std::make_shared<VPUCopyCommand>(ctx,
+                                                    srcPtr,
+                                                    dstPtr,
+                                                    rowSize * count,
+                                                    copyDirection,
+                                                    descriptor,
+                                                    boost::numeric_cast<uint32_t>(count));
+        commands.emplace_back(std::move(cmd));
+    }
+
+    LOG_I("Region %lux%lux%lu is copied by %lu commands with %lu descriptors of %lu bytes",
+          width,
+          height,
+          depth,
+          commands.size(),
+          rows,
+          rowSize);
+    return commands;
+}
+
 VPUCopyCommand::VPUCopyCommand(VPUDeviceContext *ctx,
                                const void *srcPtr,
                                void *dstPtr,
                                size_t size,
                                CopyDirection direction,
-                               VPUDescriptor &descriptor)
+                               VPUDescriptor &descriptor,
+                               uint32_t descriptorCount)
     : VPUCommand(direction == COPY_LOCAL_TO_LOCAL ? EngineSupport::Compute : EngineSupport::Copy) {
     vpu_cmd_copy_buffer_t cmd = {};
 
     cmd.header.type = direction;
     cmd.header.size = sizeof(vpu_cmd_copy_buffer_t);
     cmd.desc_start_offset = 0u;
-    cmd.desc_count = 1u;
+    cmd.desc_count = descriptorCount;
     command.emplace<vpu_cmd_copy_buffer_t>(cmd);
 
     descriptor.commandOffset = &(std::any_cast<vpu_cmd_copy_buffer_t>(&command)->desc_start_offset);
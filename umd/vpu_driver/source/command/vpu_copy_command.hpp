@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace VPU {
 
@@ -19,16 +20,42 @@ class VPUDeviceContext;
 
 class VPUCopyCommand : public VPUCommand {
   public:
+    /* Layout of 3D region in memory, offset points to the first byte of the region */
+    struct Region {
+        size_t offset = 0;
+        size_t pitch = 0;
+        size_t slicePitch = 0;
+    };
+
+    /* Max number of bytes copied by single descriptor */
+    static constexpr size_t maxDescriptorCopySize = 16 * 1024 * 1024;
+
     VPUCopyCommand(VPUDeviceContext *ctx,
                    const void *srcPtr,
                    void *dstPtr,
                    size_t size,
                    CopyDirection direction,
-                   VPUDescriptor &descriptor);
+                   VPUDescriptor &descriptor,
+                   uint32_t descriptorCount = 1);
 
     static std::shared_ptr<VPUCopyCommand>
     create(VPUDeviceContext *ctx, const void *srcPtr, void *dstPtr, size_t size);
 
+    /**
+     * Create copy commands of 3D region of width bytes, height rows and depth slices. Each
+     * command copies up to VPU_CMD_COPY_DESC_COUNT_MAX rows or blocks of contiguous rows using
+     * separate descriptors.
+     * @return copy commands, empty vector on failure
+     */
+    static std::vector<std::shared_ptr<VPUCopyCommand>> createRegion(VPUDeviceContext *ctx,
+                                                                     const void *srcPtr,
+                                                                     const Region &srcRegion,
+                                                                     void *dstPtr,
+                                                                     const Region &dstRegion,
+                                                                     size_t width,
+                                                                     size_t height,
+                                                                     size_t depth);
+
     const vpu_cmd_header_t *getHeader() const {
         return reinterpret_cast<const vpu_cmd_header_t *>(
             std::any_cast<vpu_cmd_copy_buffer_t>(&command));
@@ -45,9 +72,11 @@ class VPUCopyCommand : public VPUCommand {
             return false;
         }
 
-        descriptor.data.resize(sizeof(T), 0);
+        // Descriptor is appended to descriptors already filled for the command
+        size_t offset = descriptor.data.size();
+        descriptor.data.resize(offset + sizeof(T), 0);
 
-        T *copyDescPtr = reinterpret_cast<T *>(descriptor.data.data());
+        T *copyDescPtr = reinterpret_cast<T *>(descriptor.data.data() + offset);
         copyDescPtr->src_address = ctx->getBufferVPUAddress(srcPtr);
         if (copyDescPtr->src_address == 0) {
             LOG_E("Failed to get vpu address for copy descriptor");
@@ -69,25 +98,6 @@ class VPUCopyCommand : public VPUCommand {
 
         return true;
     }
-
-    template <class T>
-    static void printCopyDesc(void *descBasePtr, vpu_cmd_header_t *cmd) {
-        if (descBasePtr == nullptr || cmd == nullptr) {
-            LOG_W("Passed descriptor or cmd header as nullptr");
-            return;
-        }
-
-        T *desc = reinterpret_cast<T *>(descBasePtr);
-        for (uint32_t i = 0; i < reinterpret_cast<vpu_cmd_copy_buffer_t *>(cmd)->desc_count; i++) {
-            LOG_I("Desc %u:\n\tsrc_address = %#lx\n"
-                  "\tdst_address = %#lx\n\tsize = %u bytes",
-                  i,
-                  desc->src_address,
-                  desc->dst_address,
-                  desc->size);
-            desc++;
-        }
-    }
 };
 
 } // namespace VPU
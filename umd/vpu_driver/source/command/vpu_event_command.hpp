@@ -27,7 +27,9 @@ class VPUEventCommand : public VPUCommand {
 
     struct JsmEventData {
         uint64_t event;       /**< enum KMDEventDataType */
-        uint64_t reserved[7]; /**< Unused */
+        uint64_t kernelStart; /**< Timestamp before the command of kernel timestamp event */
+        uint64_t kernelEnd;   /**< Timestamp after the command of kernel timestamp event */
+        uint64_t reserved[5]; /**< Unused */
     };
     static_assert(sizeof(JsmEventData) % 64 == 0, "JsmEventData is misaligned");
 
@@ -47,43 +47,66 @@ std::shared_ptr<VPUGraphInitCommand> VPUGraphInitCommand::create(VPUDeviceContex
         return nullptr;
     }
 
-    auto kernelBuffer = ctx->createInternalBufferObject(ctx->getPageAlignedSize(blobSize),
-                                                        VPUBufferObject::Type::WriteCombineLow);
+    // Graphs initialized from the same blob share the kernel heap
+    auto kernelBuffer = ctx->acquireSharedBufferObject(blobData,
+                                                       blobSize,
+                                                       VPUBufferObject::Type::WriteCombineLow,
+                                                       false);
     if (kernelBuffer == nullptr) {
         LOG_E("Failed to allocate kernel heap for graph data.");
         return nullptr;
     }
 
-    if (!kernelBuffer->copyToBuffer(blobData, blobSize, 0)) {
-        LOG_E("Failed to copy kernel buffer");
-        return nullptr;
-    }
-
-    auto scratchBuffer = ctx->createInternalBufferObject(ctx->getPageAlignedSize(scratchSize) * 4,
-                                                         VPUBufferObject::Type::WriteCombineHigh);
-    if (scratchBuffer == nullptr) {
-        LOG_E("Failed to allocate memory for scratch pointer!");
-        return nullptr;
-    }
+    // Each of the heaps holds a copy per graph instance
+    VPUScratchPool::Region heaps;
+    size_t scratchHeapSize = ctx->getPageAlignedSize(scratchSize) * 4;
+    size_t metadataHeapSize = ctx->getPageAlignedSize(metadataSize) * 4;
+    bool pooled = ctx->acquireScratchRegion(scratchHeapSize, metadataHeapSize, heaps);
+
+    // Buffers acquired before a failing step are given back
+    auto releaseBuffers = [&]() {
+        if (!ctx->releaseSharedBufferObject(kernelBuffer))
+            LOG_E("Failed to free kernel heap");
+
+        if (pooled) {
+            if (!ctx->releaseScratchRegion(heaps))
+                LOG_E("Failed to release scratch pool region");
+        } else {
+            if (heaps.scratch && !ctx->freeMemAlloc(heaps.scratch))
+                LOG_E("Failed to free scratch heap");
+            if (heaps.metadata && !ctx->freeMemAlloc(heaps.metadata))
+                LOG_E("Failed to free metadata heap");
+        }
+    };
+
+    if (!pooled) {
+        heaps.scratch = ctx->createInternalBufferObject(scratchHeapSize,
+                                                        VPUBufferObject::Type::WriteCombineHigh);
+        if (heaps.scratch == nullptr) {
+            LOG_E("Failed to allocate memory for scratch pointer!");
+            releaseBuffers();
+            return nullptr;
+        }
 
-    auto metadataBuffer = ctx->createInternalBufferObject(ctx->getPageAlignedSize(metadataSize) * 4,
-                                                          VPUBufferObject::Type::WriteCombineLow);
-    if (metadataBuffer == nullptr) {
-        LOG_E("Failed to allocate memory for metadata pointer!");
-        return nullptr;
+        heaps.metadata = ctx->createInternalBufferObject(metadataHeapSize,
+                                                         VPUBufferObject::Type::WriteCombineLow);
+        if (heaps.metadata == nullptr) {
+            LOG_E("Failed to allocate memory for metadata pointer!");
+            releaseBuffers();
+            return nullptr;
+        }
     }
 
     VPUBufferObject *actKernelBuffer = nullptr;
     if (kernelData != nullptr && kernelDataSize != 0) {
-        actKernelBuffer = ctx->createInternalBufferObject(ctx->getPageAlignedSize(kernelDataSize),
-                                                          VPUBufferObject::Type::WriteCombineHigh);
+        actKernelBuffer =
+            ctx->acquireSharedBufferObject(kernelData,
+                                           kernelDataSize,
+                                           VPUBufferObject::Type::WriteCombineHigh,
+                                           false);
         if (actKernelBuffer == nullptr) {
             LOG_E("Failed to allocate kernel data pointer!");
-            return nullptr;
-        }
-
-        if (!actKernelBuffer->copyToBuffer(kernelData, kernelDataSize, 0)) {
-            LOG_E("Failed to copy activation kernel buffer");
+            releaseBuffers();
             return nullptr;
         }
     }
@@ -92,8 +115,8 @@ std::shared_ptr<VPUGraphInitCommand> VPUGraphInitCommand::create(VPUDeviceContex
                                                  umdBlobId,
                                                  blobSize,
                                                  kernelBuffer,
-                                                 scratchBuffer,
-                                                 metadataBuffer,
+                                                 heaps.scratch,
+                                                 heaps.metadata,
                                                  actKernelBuffer,
                                                  scratchSize,
                                                  metadataSize);
@@ -153,10 +176,17 @@ VPUGraphInitCommand::~VPUGraphInitCommand() {
         return;
     }
 
-    if (kernelBuffer && !ctx->freeMemAlloc(kernelBuffer)) {
+    if (kernelBuffer && !ctx->releaseSharedBufferObject(kernelBuffer)) {
         LOG_E("Failed to free kernel heap");
     }
 
+    // Heaps of scratch pool region go back to the pool for the next graph
+    if (scratchBuffer && metadataBuffer &&
+        ctx->releaseScratchRegion({scratchBuffer, metadataBuffer})) {
+        scratchBuffer = nullptr;
+        metadataBuffer = nullptr;
+    }
+
     if (scratchBuffer && !ctx->freeMemAlloc(scratchBuffer)) {
         LOG_E("Failed to free scratch heap");
     }
@@ -165,7 +195,7 @@ VPUGraphInitCommand::~VPUGraphInitCommand() {
         LOG_E("Failed to free metadata heap");
     }
 
-    if (actKernelBuffer && !ctx->freeMemAlloc(actKernelBuffer)) {
+    if (actKernelBuffer && !ctx->releaseSharedBufferObject(actKernelBuffer)) {
         LOG_E("Failed to free kernel data heap");
     }
 }
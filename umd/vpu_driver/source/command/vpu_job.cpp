@@ -7,10 +7,14 @@
 
 #include "umd_common.hpp"
 #include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
 #include "vpu_driver/source/device/vpu_device_context.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
 
+#include <algorithm>
 #include <assert.h>
+#include <limits>
+#include <string.h>
 
 namespace VPU {
 
@@ -21,9 +25,21 @@ VPUJob::VPUJob(VPUDeviceContext *ctx, bool isCopyOnly)
 VPUJob::~VPUJob() {
     LOG_V("Destroying VPUJob - %p", this);
 
+    if (ctx)
+        ctx->endScratchLeases(this);
+
+    if (VPUJobTracer::isEnabled())
+        VPUJobTracer::getInstance().jobDestroyed(this);
+
     if (ctx && descriptor && !ctx->freeMemAlloc(descriptor)) {
         LOG_E("Failed to free event sync pointer");
     }
+
+    for (auto &shadow : shadows) {
+        shadow.cmdBuffers.clear();
+        if (ctx && shadow.descriptor && !ctx->freeMemAlloc(shadow.descriptor))
+            LOG_E("Failed to free descriptor of shadow instance");
+    }
 }
 
 bool VPUJob::updateInternalEventBuffer(std::shared_ptr<VPUCommand> cmd) {
@@ -44,6 +60,8 @@ bool VPUJob::updateInternalEventBuffer(std::shared_ptr<VPUCommand> cmd) {
 }
 
 bool VPUJob::closeCommands() {
+    VPUJobTracer::Scope traceScope("closeCommands", this);
+
     if (ctx == nullptr) {
         LOG_E("VPUDeviceContext is nullptr");
         return false;
@@ -102,8 +120,66 @@ bool VPUJob::closeCommands() {
     return true;
 }
 
+bool VPUJob::closeCommands(const std::vector<std::shared_ptr<VPUCommand>> &cmds,
+                           VPUCommandBuffer::Target target,
+                           VPUJob *recycled) {
+    VPUJobTracer::Scope traceScope("closeCommands", this);
+
+    if (ctx == nullptr) {
+        LOG_E("VPUDeviceContext is nullptr");
+        return false;
+    }
+
+    if (isClosed() || getNumCommands() || descriptor || cmdBuffers.size()) {
+        LOG_E("Failed to close the VPUJob because of dirty state");
+        return false;
+    }
+
+    if (isCopyOnly && target == VPUCommandBuffer::Target::COMPUTE) {
+        LOG_E("Copy-only VPUJob cannot be closed for COMPUTE engine");
+        return false;
+    }
+
+    size_t descriptorSize = 0;
+    for (const auto &cmd : cmds)
+        descriptorSize += getFwDataCacheAlign(cmd->getDescriptorSize());
+
+    if (descriptorSize > 0 && recycled && recycled->descriptor &&
+        recycled->descriptor->getAllocSize() >= descriptorSize) {
+        descriptor = recycled->descriptor;
+        recycled->descriptor = nullptr;
+        descriptorPtr = descriptor->getBasePointer();
+        // Descriptors start clean like in a new buffer object
+        memset(descriptorPtr, 0, descriptorSize);
+    } else if (descriptorSize > 0) {
+        descriptor =
+            ctx->createInternalBufferObject(descriptorSize, VPUBufferObject::Type::CachedLow);
+        if (descriptor == nullptr) {
+            LOG_E("Failed to allocate descriptor buffer");
+            return false;
+        }
+        descriptorPtr = descriptor->getBasePointer();
+    }
+
+    VPUCommandBuffer *recycledBuffer = nullptr;
+    if (recycled && !recycled->cmdBuffers.empty())
+        recycledBuffer = recycled->cmdBuffers.front().get();
+
+    auto &targetCmds = target == VPUCommandBuffer::Target::COMPUTE ? nnCmds : cpCmds;
+    targetCmds = cmds;
+    if (!createCommandBuffer(targetCmds, target, recycledBuffer)) {
+        LOG_E("Failed to initialize %s VPUCommandBuffer",
+              target == VPUCommandBuffer::Target::COMPUTE ? "COMPUTE" : "COPY");
+        return false;
+    }
+
+    closed = true;
+    return true;
+}
+
 bool VPUJob::createCommandBuffer(const std::vector<std::shared_ptr<VPUCommand>> &cmds,
-                                 VPUCommandBuffer::Target cmdType) {
+                                 VPUCommandBuffer::Target cmdType,
+                                 VPUCommandBuffer *recycled) {
     if (cmds.size() == 0)
         return true;
 
@@ -111,8 +187,12 @@ bool VPUJob::createCommandBuffer(const std::vector<std::shared_ptr<VPUCommand>>
     if (descriptor)
         descriptorEnd = descriptor->getBasePointer() + descriptor->getAllocSize();
 
-    auto cmdBuffer =
-        VPUCommandBuffer::allocateCommandBuffer(ctx, cmds, &descriptorPtr, descriptorEnd, cmdType);
+    auto cmdBuffer = VPUCommandBuffer::allocateCommandBuffer(ctx,
+                                                             cmds,
+                                                             &descriptorPtr,
+                                                             descriptorEnd,
+                                                             cmdType,
+                                                             recycled);
     if (cmdBuffer == nullptr) {
         LOG_E("Failed to allocate VPUCommandBuffer");
         return false;
@@ -122,19 +202,196 @@ bool VPUJob::createCommandBuffer(const std::vector<std::shared_ptr<VPUCommand>>
     return true;
 }
 
+std::shared_ptr<VPUJob> VPUJob::createBatch(VPUDeviceContext *ctx,
+                                            const std::vector<std::shared_ptr<VPUJob>> &jobs) {
+    if (ctx == nullptr || jobs.empty()) {
+        LOG_E("VPUDeviceContext is nullptr or job list is empty");
+        return nullptr;
+    }
+
+    bool isCopyOnly = true;
+    for (const auto &job : jobs) {
+        if (!job->isClosed()) {
+            LOG_E("VPUJob %p is not closed", job.get());
+            return nullptr;
+        }
+        isCopyOnly = isCopyOnly && job->isCopyOnly;
+    }
+
+    auto batch = std::make_shared<VPUJob>(ctx, isCopyOnly);
+
+    // Each job gets own internal events, so jobs do not signal each other
+    batch->descriptor = ctx->createInternalBufferObject(eventPoolSize * jobs.size(),
+                                                        VPUBufferObject::Type::CachedLow);
+    if (batch->descriptor == nullptr) {
+        LOG_E("Failed to allocate descriptor buffer for batch of %lu jobs", jobs.size());
+        return nullptr;
+    }
+    memset(batch->descriptor->getBasePointer(), 0, batch->descriptor->getAllocSize());
+
+    for (auto target : {VPUCommandBuffer::Target::COMPUTE, VPUCommandBuffer::Target::COPY}) {
+        std::vector<std::pair<const VPUCommandBuffer *, VPUCommandBuffer::FenceRelocation>> sources;
+        for (size_t i = 0; i < jobs.size(); i++) {
+            VPUCommandBuffer::FenceRelocation relocation;
+            if (jobs[i]->eventBasePtr) {
+                relocation.vpuAddr = ctx->getBufferVPUAddress(jobs[i]->eventBasePtr);
+                relocation.size = eventPoolSize;
+                relocation.newVpuAddr = batch->descriptor->getVPUAddr() + i * eventPoolSize;
+            }
+
+            for (const auto &cmdBuffer : jobs[i]->cmdBuffers)
+                if (cmdBuffer->getEngine() == static_cast<uint32_t>(target))
+                    sources.emplace_back(cmdBuffer.get(), relocation);
+        }
+
+        if (sources.empty())
+            continue;
+
+        auto cmdBuffer =
+            VPUCommandBuffer::mergeCommandBuffers(ctx, sources, batch->descriptor, target);
+        if (cmdBuffer == nullptr) {
+            LOG_E("Failed to merge %s command buffers of %lu jobs",
+                  VPUCommandBuffer::targetEngineToStr(target),
+                  jobs.size());
+            return nullptr;
+        }
+        batch->cmdBuffers.emplace_back(std::move(cmdBuffer));
+    }
+
+    for (const auto &job : jobs) {
+        auto expired = [](const auto &weakBatch) { return weakBatch.expired(); };
+        job->batches.erase(std::remove_if(job->batches.begin(), job->batches.end(), expired),
+                           job->batches.end());
+        job->batches.emplace_back(batch);
+    }
+
+    batch->batchedJobs = jobs;
+    batch->closed = true;
+    LOG_I("VPUJob %p created as batch of %lu jobs", batch.get(), jobs.size());
+    return batch;
+}
+
 bool VPUJob::waitForCompletion(int64_t timeout_abs_ns) {
-    for (const auto &cmdBuffer : cmdBuffers)
-        if (!cmdBuffer->waitForCompletion(timeout_abs_ns))
+    // Polls close in-flight slices as well, only blocking waits are recorded as host stage
+    bool tracing = VPUJobTracer::isEnabled();
+    uint64_t traceStartNs = tracing && timeout_abs_ns != 0 ? VPUJobTracer::getTimestampNs() : 0;
+
+    for (size_t i = 0; i < getInstanceCount(); i++)
+        for (const auto &cmdBuffer : getInstanceCommandBuffers(i))
+            if (!cmdBuffer->waitForCompletion(timeout_abs_ns))
+                return false;
+
+    for (const auto &weakBatch : batches) {
+        auto batch = weakBatch.lock();
+        if (batch && !batch->waitForCompletion(timeout_abs_ns))
             return false;
+    }
 
     printResult();
+    if (tracing)
+        VPUJobTracer::getInstance().jobCompleted(this, traceStartNs);
+    return true;
+}
+
+bool VPUJob::createShadowInstance() {
+    size_t count = shadowCount.load(std::memory_order_relaxed);
+    if (count == shadows.size()) {
+        LOG_E("All %lu shadow instances of VPUJob %p are created", count, this);
+        return false;
+    }
+
+    ShadowInstance &shadow = shadows[count];
+    if (descriptor) {
+        shadow.descriptor =
+            ctx->createInternalBufferObject(descriptor->getAllocSize(), descriptor->getType());
+        if (shadow.descriptor == nullptr) {
+            LOG_E("Failed to allocate descriptor buffer for shadow instance");
+            return false;
+        }
+
+        // Internal events of the copy start from initial state
+        size_t eventPoolOffset = descriptor->getAllocSize() - eventPoolSize;
+        memcpy(shadow.descriptor->getBasePointer(), descriptor->getBasePointer(), eventPoolOffset);
+        memset(shadow.descriptor->getBasePointer() + eventPoolOffset, 0, eventPoolSize);
+    }
+
+    for (const auto &cmdBuffer : cmdBuffers) {
+        auto shadowBuffer = cmdBuffer->createShadowCopy(descriptor, shadow.descriptor);
+        if (shadowBuffer == nullptr) {
+            LOG_E("Failed to create shadow of %s command buffer", cmdBuffer->getName());
+            shadow.cmdBuffers.clear();
+            if (shadow.descriptor)
+                ctx->freeMemAlloc(shadow.descriptor);
+            shadow.descriptor = nullptr;
+            return false;
+        }
+        shadow.cmdBuffers.emplace_back(std::move(shadowBuffer));
+    }
+
+    // Publish the shadow to waiters only when it is complete
+    shadowCount.store(count + 1, std::memory_order_release);
+    LOG_I("Shadow instance %lu of VPUJob %p created", count + 1, this);
+    return true;
+}
+
+void VPUJob::getDescriptorBuffers(std::vector<const VPUBufferObject *> &buffers) const {
+    size_t instance = activeInstance.load(std::memory_order_relaxed);
+    const VPUBufferObject *active = instance == 0 ? descriptor : shadows[instance - 1].descriptor;
+    if (active)
+        buffers.push_back(active);
+
+    for (const auto &job : batchedJobs) {
+        if (job->descriptor)
+            buffers.push_back(job->descriptor);
+        for (const auto &nestedJob : job->batchedJobs)
+            nestedJob->getDescriptorBuffers(buffers);
+    }
+}
+
+bool VPUJob::prepareSubmission() {
+    if (!isClosed()) {
+        LOG_E("VPUJob is not closed");
+        return false;
+    }
+
+    // Instances are used in a ring, the next one was submitted the earliest
+    size_t next = (activeInstance.load(std::memory_order_relaxed) + 1) % getInstanceCount();
+    bool isIdle = true;
+    for (const auto &cmdBuffer : getInstanceCommandBuffers(next))
+        isIdle = isIdle && cmdBuffer->waitForCompletion(0);
+
+    if (!isIdle && getInstanceCount() < maxInstances) {
+        if (!createShadowInstance())
+            return false;
+
+        activeInstance.store(getInstanceCount() - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (!isIdle) {
+        LOG_W("All %lu instances of VPUJob %p are in flight, waiting for the oldest",
+              getInstanceCount(),
+              this);
+        for (const auto &cmdBuffer : getInstanceCommandBuffers(next))
+            if (!cmdBuffer->waitForCompletion(std::numeric_limits<int64_t>::max()))
+                return false;
+    }
+
+    activeInstance.store(next, std::memory_order_relaxed);
     return true;
 }
 
 bool VPUJob::isSuccess() const {
-    for (const auto &cmdBuffer : cmdBuffers)
-        if (!cmdBuffer->isSuccess())
+    for (size_t i = 0; i < getInstanceCount(); i++)
+        for (const auto &cmdBuffer : getInstanceCommandBuffers(i))
+            if (!cmdBuffer->isSuccess())
+                return false;
+
+    for (const auto &weakBatch : batches) {
+        auto batch = weakBatch.lock();
+        if (batch && !batch->isSuccess())
             return false;
+    }
 
     return true;
 }
@@ -11,7 +11,10 @@
 #include "vpu_driver/source/command/vpu_command_buffer.hpp"
 #include "vpu_driver/source/command/vpu_event_command.hpp"
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace VPU {
@@ -27,17 +30,59 @@ class VPUJob {
      */
     bool closeCommands();
 
+    /**
+     * @brief Close the job with commands encoded in the given order into single command buffer
+     * for the target engine. Commands are not classified and no internal events are added, the
+     * caller is responsible that all commands can be executed by the target engine.
+     * @param cmds[in]: Commands to be encoded into the command buffer
+     * @param target[in]: Engine that executes the command buffer
+     * @param recycled[in]: Optional completed job closed the same way. Its descriptor and command
+     *                      buffer objects are taken over when they are big enough, the recycled
+     *                      job must not be submitted again.
+     * @return true on successful closing
+     */
+    bool closeCommands(const std::vector<std::shared_ptr<VPUCommand>> &cmds,
+                       VPUCommandBuffer::Target target,
+                       VPUJob *recycled = nullptr);
+
+    /**
+     * @brief Create closed job that executes the given closed jobs in order. Commands of the jobs
+     * are chained into one command buffer per engine and internal events of each job are moved to
+     * the descriptor of the new job. Batched jobs are kept alive by the batch and take it into
+     * account in waitForCompletion() and isSuccess().
+     * @param ctx[in]: Device context used for allocations
+     * @param jobs[in]: Closed jobs to be executed by the batch
+     * @return shared_ptr<VPUJob> on success, nullptr otherwise
+     */
+    static std::shared_ptr<VPUJob> createBatch(VPUDeviceContext *ctx,
+                                               const std::vector<std::shared_ptr<VPUJob>> &jobs);
+
     /**
      * Return true if the command buffers execution is completed with success
      */
     bool isSuccess() const;
 
     /**
-     * @brief Returns true if the job has completed by the specified time.
+     * @brief Returns true if all submissions of the job have completed by the specified time.
      * @param timeout_abs_ns[in]: Absolute timeout in nanoseconds
      */
     bool waitForCompletion(int64_t timeout_abs_ns);
 
+    /**
+     * @brief Select command buffers for the next submission of the job. When previous submission
+     * is still in flight, shadow copy of command buffers and descriptor is used. Up to
+     * maxInstances copies are kept in a ring, when all of them are in flight the call blocks until
+     * the oldest submission is completed. The caller holds getSubmissionMutex() until the selected
+     * command buffers are submitted.
+     * @return true if command buffers returned by getCommandBuffers() are ready for submission
+     */
+    bool prepareSubmission();
+
+    /**
+     * Serializes selection and submission of job instances between threads submitting the job
+     */
+    std::mutex &getSubmissionMutex() { return submissionMtx; }
+
     /**
      * Print job result to the terminal
      */
@@ -47,9 +92,17 @@ class VPUJob {
      * Return collection of VPUCommandBuffers
      */
     const std::vector<std::unique_ptr<VPUCommandBuffer>> &getCommandBuffers() const {
-        return cmdBuffers;
+        return getInstanceCommandBuffers(activeInstance.load(std::memory_order_relaxed));
     }
 
+    /**
+     * Return number of job instances, including the original one
+     */
+    size_t getInstanceCount() const { return shadowCount.load(std::memory_order_acquire) + 1; }
+
+    /* Limit of concurrently submitted instances of the same job */
+    static constexpr size_t maxInstances = 8;
+
     void *getDescriptorPtr() const { return descriptorPtr; }
 
     /**
@@ -76,6 +129,13 @@ class VPUJob {
 
     const std::vector<std::shared_ptr<VPUCommand>> &getNNCommands() const { return nnCmds; }
     const std::vector<std::shared_ptr<VPUCommand>> &getCopyCommands() const { return cpCmds; }
+    const std::vector<std::shared_ptr<VPUJob>> &getBatchedJobs() const { return batchedJobs; }
+
+    /**
+     * Collect descriptor buffers referenced by command buffers of the last submission, batch
+     * refers to descriptors of the original instance of batched jobs
+     */
+    void getDescriptorBuffers(std::vector<const VPUBufferObject *> &buffers) const;
 
     /* Job is closed, no more append commands is allowed. Job is ready for submission */
     bool isClosed() const { return closed; }
@@ -115,7 +175,8 @@ class VPUJob {
      * @return true when successfully added, false otherwise.
      */
     bool createCommandBuffer(const std::vector<std::shared_ptr<VPUCommand>> &cmds,
-                             VPUCommandBuffer::Target cmdtype);
+                             VPUCommandBuffer::Target cmdtype,
+                             VPUCommandBuffer *recycled = nullptr);
 
     /**
      * Update buffer of VPUEventCommand used as internal event
@@ -124,6 +185,17 @@ class VPUJob {
      */
     bool updateInternalEventBuffer(std::shared_ptr<VPUCommand> cmd);
 
+    /**
+     * Create a copy of descriptor and command buffers that is used as new instance of the job
+     * @return true when successfully created, false otherwise.
+     */
+    bool createShadowInstance();
+
+    const std::vector<std::unique_ptr<VPUCommandBuffer>> &
+    getInstanceCommandBuffers(size_t index) const {
+        return index == 0 ? cmdBuffers : shadows[index - 1].cmdBuffers;
+    }
+
     VPUDeviceContext *ctx = nullptr;
     bool isCopyOnly = false;
 
@@ -135,6 +207,23 @@ class VPUJob {
     /* Collection of VPUCommandBuffer that later will be pushed for submission */
     std::vector<std::unique_ptr<VPUCommandBuffer>> cmdBuffers;
 
+    /* Copies of descriptor and command buffers for concurrent submissions of the job */
+    struct ShadowInstance {
+        VPUBufferObject *descriptor = nullptr;
+        std::vector<std::unique_ptr<VPUCommandBuffer>> cmdBuffers;
+    };
+    /* Slots never move, waiters read the first shadowCount of them while new one is created */
+    std::array<ShadowInstance, maxInstances - 1> shadows;
+    std::atomic<size_t> shadowCount = 0;
+    /* Instance used in the last submission, 0 refers to the original buffers */
+    std::atomic<size_t> activeInstance = 0;
+    std::mutex submissionMtx;
+
+    /* Jobs executed by this batch job */
+    std::vector<std::shared_ptr<VPUJob>> batchedJobs;
+    /* Batch jobs that execute commands of this job */
+    std::vector<std::weak_ptr<VPUJob>> batches;
+
     /* Commands collection */
     std::vector<std::shared_ptr<VPUCommand>> cpCmds;
     std::vector<std::shared_ptr<VPUCommand>> nnCmds;
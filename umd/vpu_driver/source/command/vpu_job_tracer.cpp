@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace VPU {
+
+static uint64_t getThreadId() {
+    static thread_local uint64_t tid = static_cast<uint64_t>(syscall(SYS_gettid));
+    return tid;
+}
+
+static std::string getJobArgs(const void *job) {
+    char args[64];
+    snprintf(args, sizeof(args), "\"job\":\"%p\"", job);
+    return args;
+}
+
+static std::string getQueueName(uint32_t queue) {
+    return "Queue " + std::to_string(queue);
+}
+
+static uint64_t getTrackEngine(uint64_t tid) {
+    return tid - VPUJobTracer::engineTrackBase;
+}
+
+VPUJobTracer &VPUJobTracer::getInstance() {
+    // Never destroyed, jobs may complete until the very end of the process
+    static VPUJobTracer *instance = new VPUJobTracer;
+    return *instance;
+}
+
+uint64_t VPUJobTracer::getTimestampNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void VPUJobTracer::addEvent(Event &&event) {
+    if (events.size() >= maxEvents) {
+        droppedEvents++;
+        return;
+    }
+    events.emplace_back(std::move(event));
+}
+
+void VPUJobTracer::addStage(const char *name, const void *job, uint64_t startNs) {
+    uint64_t endNs = getTimestampNs();
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    addEvent({'X', name, getThreadId(), startNs, endNs - startNs, 0, getJobArgs(job)});
+}
+
+void VPUJobTracer::jobSubmitted(const VPUJob *job, const void *queue) {
+    uint64_t submitNs = getTimestampNs();
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto it = queues.try_emplace(queue, static_cast<uint32_t>(queues.size())).first;
+    uint64_t id = nextSubmissionId++;
+    pending[job].push_back({id, it->second, submitNs});
+    addEvent({'b', getQueueName(it->second), getThreadId(), submitNs, 0, id, getJobArgs(job)});
+}
+
+void VPUJobTracer::jobCompleted(const VPUJob *job, uint64_t waitStartNs) {
+    uint64_t endNs = getTimestampNs();
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto it = pending.find(job);
+    if (it == pending.end())
+        return;
+
+    for (const auto &submission : it->second)
+        addEvent({'e', getQueueName(submission.queue), getThreadId(), endNs, 0, submission.id, ""});
+    if (waitStartNs)
+        addEvent({'X',
+                  "waitForCompletion",
+                  getThreadId(),
+                  waitStartNs,
+                  endNs - waitStartNs,
+                  0,
+                  getJobArgs(job)});
+
+    // All submissions write the same timestamp buffers, values belong to the last one
+    addDeviceEvents(job, it->second.back().submitNs);
+    pending.erase(it);
+}
+
+void VPUJobTracer::jobDestroyed(const VPUJob *job) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    pending.erase(job);
+}
+
+static void collectTimestamps(const VPUJob *job,
+                              std::vector<std::pair<uint64_t, uint64_t>> &timestamps) {
+    auto collect = [&timestamps](const auto &cmds, VPUCommandBuffer::Target target) {
+        for (const auto &cmd : cmds) {
+            if (cmd->getCommandType() != VPU_CMD_TIMESTAMP)
+                continue;
+
+            auto *tsCmd = static_cast<const VPUTimeStampCommand *>(cmd.get());
+            uint64_t ticks = *tsCmd->getTimestampPtr();
+            if (ticks != 0)
+                timestamps.emplace_back(static_cast<uint64_t>(target), ticks);
+        }
+    };
+
+    collect(job->getNNCommands(), VPUCommandBuffer::Target::COMPUTE);
+    collect(job->getCopyCommands(), VPUCommandBuffer::Target::COPY);
+    for (const auto &batchedJob : job->getBatchedJobs())
+        collectTimestamps(batchedJob.get(), timestamps);
+}
+
+void VPUJobTracer::addDeviceEvents(const VPUJob *job, uint64_t submitNs) {
+    // Pairs of engine and device ticks
+    std::vector<std::pair<uint64_t, uint64_t>> timestamps;
+    collectTimestamps(job, timestamps);
+    if (timestamps.empty())
+        return;
+
+    auto toDeviceNs = [](uint64_t ticks) {
+        return static_cast<int64_t>(ticks / deviceTimerFrequency * 1'000'000'000 +
+                                    ticks % deviceTimerFrequency * 1'000'000'000 /
+                                        deviceTimerFrequency);
+    };
+
+    if (!deviceClockAligned) {
+        uint64_t firstTicks = std::min_element(timestamps.begin(),
+                                               timestamps.end(),
+                                               [](const auto &a, const auto &b) {
+                                                   return a.second < b.second;
+                                               })
+                                  ->second;
+        deviceClockOffsetNs = static_cast<int64_t>(submitNs) - toDeviceNs(firstTicks);
+        deviceClockAligned = true;
+    }
+
+    std::map<uint64_t, std::pair<uint64_t, uint64_t>> engineRanges;
+    for (const auto &[engine, ticks] : timestamps) {
+        uint64_t tsNs = static_cast<uint64_t>(toDeviceNs(ticks) + deviceClockOffsetNs);
+        char args[64];
+        snprintf(args, sizeof(args), "\"ticks\":%" PRIu64, ticks);
+        addEvent({'i', "timestamp", engineTrackBase + engine, tsNs, 0, 0, args});
+
+        auto range = engineRanges.try_emplace(engine, tsNs, tsNs).first;
+        range->second.first = std::min(range->second.first, tsNs);
+        range->second.second = std::max(range->second.second, tsNs);
+    }
+
+    for (const auto &[engine, range] : engineRanges) {
+        if (range.first == range.second)
+            continue;
+
+        char name[64];
+        snprintf(name, sizeof(name), "Job %p", static_cast<const void *>(job));
+        addEvent({'X',
+                  name,
+                  engineTrackBase + engine,
+                  range.first,
+                  range.second - range.first,
+                  0,
+                  getJobArgs(job)});
+    }
+}
+
+std::vector<VPUJobTracer::Event> VPUJobTracer::getEvents() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return events;
+}
+
+std::string VPUJobTracer::getJson() const {
+    auto traceEvents = getEvents();
+    int pid = getpid();
+    std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    char line[512];
+
+    snprintf(line,
+             sizeof(line),
+             "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%d,\"tid\":0,"
+             "\"args\":{\"name\":\"VPU UMD\"}}",
+             pid);
+    json += line;
+
+    std::set<uint64_t> engineTracks;
+    for (const auto &event : traceEvents)
+        if (event.tid >= engineTrackBase)
+            engineTracks.insert(event.tid);
+    for (uint64_t tid : engineTracks) {
+        auto target = static_cast<VPUCommandBuffer::Target>(getTrackEngine(tid));
+        snprintf(line,
+                 sizeof(line),
+                 ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%" PRIu64
+                 ",\"args\":{\"name\":\"VPU %s engine\"}}",
+                 pid,
+                 tid,
+                 VPUCommandBuffer::targetEngineToStr(target));
+        json += line;
+    }
+
+    for (const auto &event : traceEvents) {
+        int len = snprintf(line,
+                           sizeof(line),
+                           ",\n{\"ph\":\"%c\",\"name\":\"%s\",\"cat\":\"vpu\",\"pid\":%d,"
+                           "\"tid\":%" PRIu64 ",\"ts\":%" PRIu64 ".%03" PRIu64,
+                           event.phase,
+                           event.name.c_str(),
+                           pid,
+                           event.tid,
+                           event.tsNs / 1000,
+                           event.tsNs % 1000);
+        std::string entry(line, static_cast<size_t>(std::max(len, 0)));
+
+        if (event.phase == 'X') {
+            snprintf(line,
+                     sizeof(line),
+                     ",\"dur\":%" PRIu64 ".%03" PRIu64,
+                     event.durNs / 1000,
+                     event.durNs % 1000);
+            entry += line;
+        } else if (event.phase == 'b' || event.phase == 'e') {
+            snprintf(line, sizeof(line), ",\"id\":\"%#" PRIx64 "\"", event.id);
+            entry += line;
+        } else if (event.phase == 'i') {
+            entry += ",\"s\":\"t\"";
+        }
+
+        entry += ",\"args\":{" + event.args + "}}";
+        json += entry;
+    }
+
+    json += "\n]}\n";
+    return json;
+}
+
+bool VPUJobTracer::writeJson(const std::string &path) const {
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        LOG_E("Failed to open job trace file %s", path.c_str());
+        return false;
+    }
+
+    std::string json = getJson();
+    bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+    if (fclose(file) != 0)
+        success = false;
+    if (!success)
+        LOG_E("Failed to write job trace file %s", path.c_str());
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    if (droppedEvents)
+        LOG_W("Job trace is limited to %zu events, %zu events dropped", maxEvents, droppedEvents);
+    return success;
+}
+
+void VPUJobTracer::clear() {
+    const std::lock_guard<std::mutex> lock(mtx);
+    events.clear();
+    droppedEvents = 0;
+    queues.clear();
+    pending.clear();
+    deviceClockAligned = false;
+}
+
+void VPUJobTracer::enableDumpAtExit(std::string_view path) {
+    enable();
+    std::call_once(dumpAtExitOnce, [this, path] {
+        dumpPath = path;
+        std::atexit([] {
+            auto &tracer = VPUJobTracer::getInstance();
+            tracer.writeJson(tracer.dumpPath);
+        });
+    });
+}
+
+} // namespace VPU
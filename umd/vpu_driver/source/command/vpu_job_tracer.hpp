@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VPU {
+
+class VPUJob;
+
+/**
+ * Timeline of job lifecycle exported in Chrome trace event format.
+ *
+ * Host stages (graph append, closing, submission and blocking completion wait) are recorded as
+ * slices on the track of the calling thread. Each submission is an async slice on the track of its
+ * queue, from the submission until the completion is seen. Device timestamps written by
+ * timestamp commands of a completed job are placed on the track of the engine that wrote them.
+ * The device clock has no known relation to the host clock, so it is aligned once to the
+ * submission time of the first job that reports timestamps.
+ */
+class VPUJobTracer {
+  public:
+    /* Frequency of the VPU timestamp counter */
+    static constexpr uint64_t deviceTimerFrequency = 38'400'000;
+    /* Track ids of engines are above any thread id */
+    static constexpr uint64_t engineTrackBase = 1ull << 32;
+    /* Events above the limit are dropped */
+    static constexpr size_t maxEvents = 1 << 20;
+
+    struct Event {
+        /* Chrome trace phase: X - complete, b/e - async begin/end, i - instant */
+        char phase;
+        std::string name;
+        uint64_t tid;
+        uint64_t tsNs;
+        uint64_t durNs;
+        /* Pairs async begin with its end */
+        uint64_t id;
+        /* Members of JSON object with event arguments */
+        std::string args;
+    };
+
+    /**
+     * Records host stage of a job from construction to destruction of the scope.
+     */
+    class Scope {
+      public:
+        Scope(const char *name, const void *job)
+            : name(name)
+            , job(job)
+            , startNs(isEnabled() ? getTimestampNs() : 0) {}
+        ~Scope() {
+            if (startNs)
+                getInstance().addStage(name, job, startNs);
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        const char *name;
+        const void *job;
+        uint64_t startNs;
+    };
+
+    VPUJobTracer(const VPUJobTracer &) = delete;
+    VPUJobTracer &operator=(const VPUJobTracer &) = delete;
+
+    static VPUJobTracer &getInstance();
+    static uint64_t getTimestampNs();
+
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+    void enable() { enabled.store(true, std::memory_order_relaxed); }
+    void disable() { enabled.store(false, std::memory_order_relaxed); }
+
+    /**
+     * Enable tracing and write the trace to the given file when the process exits.
+     */
+    void enableDumpAtExit(std::string_view path);
+
+    void addStage(const char *name, const void *job, uint64_t startNs);
+
+    /**
+     * @brief Open in-flight slice of the job on the queue track.
+     * @param job[in]: Submitted job
+     * @param queue[in]: Object identifying the queue, tracks are numbered in order of first use
+     */
+    void jobSubmitted(const VPUJob *job, const void *queue);
+
+    /**
+     * @brief Close in-flight slices of the job and record its device timestamps. Called by
+     * every wait or poll that sees the completion, nothing is recorded if the job has no
+     * submission in flight.
+     * @param waitStartNs[in]: Time the completed blocking wait was started, 0 for a poll
+     */
+    void jobCompleted(const VPUJob *job, uint64_t waitStartNs);
+
+    /**
+     * Forget submissions of destroyed job, its address may be reused by next job.
+     */
+    void jobDestroyed(const VPUJob *job);
+
+    std::vector<Event> getEvents() const;
+    std::string getJson() const;
+    bool writeJson(const std::string &path) const;
+    void clear();
+
+  private:
+    struct Submission {
+        uint64_t id;
+        uint32_t queue;
+        uint64_t submitNs;
+    };
+
+    VPUJobTracer() = default;
+
+    /* Following helpers require the lock to be held */
+    void addEvent(Event &&event);
+    void addDeviceEvents(const VPUJob *job, uint64_t submitNs);
+
+    static inline std::atomic<bool> enabled = false;
+
+    mutable std::mutex mtx;
+    std::vector<Event> events;
+    size_t droppedEvents = 0;
+    std::map<const void *, uint32_t> queues;
+    std::map<const VPUJob *, std::vector<Submission>> pending;
+    uint64_t nextSubmissionId = 1;
+    bool deviceClockAligned = false;
+    int64_t deviceClockOffsetNs = 0;
+    std::once_flag dumpAtExitOnce;
+    std::string dumpPath;
+};
+
+} // namespace VPU
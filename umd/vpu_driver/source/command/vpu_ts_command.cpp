@@ -14,8 +14,8 @@
 
 namespace VPU {
 
-std::shared_ptr<VPUTimeStampCommand> VPUTimeStampCommand::create(VPUDeviceContext *ctx,
-                                                                 uint64_t *dstPtr) {
+std::shared_ptr<VPUTimeStampCommand>
+VPUTimeStampCommand::create(VPUDeviceContext *ctx, uint64_t *dstPtr, EngineSupport engine) {
     if (!ctx) {
         LOG_E("Context is nullptr in Timestamp command");
         return nullptr;
@@ -26,11 +26,14 @@ std::shared_ptr<VPUTimeStampCommand> VPUTimeStampCommand::create(VPUDeviceContex
         return nullptr;
     }
 
-    return std::make_shared<VPUTimeStampCommand>(ctx, dstPtr);
+    return std::make_shared<VPUTimeStampCommand>(ctx, dstPtr, engine);
 }
 
-VPUTimeStampCommand::VPUTimeStampCommand(VPUDeviceContext *ctx, uint64_t *dstPtr)
-    : VPUCommand(EngineSupport::Backward) {
+VPUTimeStampCommand::VPUTimeStampCommand(VPUDeviceContext *ctx,
+                                         uint64_t *dstPtr,
+                                         EngineSupport engine)
+    : VPUCommand(engine)
+    , dstPtr(dstPtr) {
     vpu_cmd_timestamp_t cmd = {};
 
     cmd.header.type = VPU_CMD_TIMESTAMP;
@@ -16,13 +16,28 @@ namespace VPU {
 
 class VPUTimeStampCommand : public VPUCommand {
   public:
-    VPUTimeStampCommand(VPUDeviceContext *ctx, uint64_t *dstPtr);
+    VPUTimeStampCommand(VPUDeviceContext *ctx,
+                        uint64_t *dstPtr,
+                        EngineSupport engine = EngineSupport::Backward);
 
-    static std::shared_ptr<VPUTimeStampCommand> create(VPUDeviceContext *ctx, uint64_t *dstPtr);
+    /**
+     * Create timestamp command, by default it runs on engine of preceding command. Timestamp that
+     * opens measurement of next command should use EngineSupport::Forward.
+     */
+    static std::shared_ptr<VPUTimeStampCommand>
+    create(VPUDeviceContext *ctx,
+           uint64_t *dstPtr,
+           EngineSupport engine = EngineSupport::Backward);
     const vpu_cmd_header_t *getHeader() const {
         return reinterpret_cast<const vpu_cmd_header_t *>(
             std::any_cast<vpu_cmd_timestamp_t>(&command));
     }
+
+    /* Host pointer of the memory the timestamp is written to */
+    uint64_t *getTimestampPtr() const { return dstPtr; }
+
+  private:
+    uint64_t *dstPtr;
 };
 
 } // namespace VPU
@@ -20,7 +20,6 @@ constexpr uint16_t INTEL_PCI_VENDOR_ID = 0x8086;
 namespace VPU {
 
 using GetCopyCommand = bool(VPUDeviceContext *, const void *, void *, size_t, VPUDescriptor &);
-using PrintCopyDescriptor = void(void *, vpu_cmd_header_t *);
 
 struct VPUHwInfo {
     uint32_t deviceId = 0u;
@@ -46,7 +45,6 @@ struct VPUHwInfo {
     uint64_t baseLowAddres = 0;
 
     GetCopyCommand *getCopyCommand = nullptr;
-    PrintCopyDescriptor *printCopyDescriptor = nullptr;
 };
 
 #ifndef VPU_NEXT_GEN_HW
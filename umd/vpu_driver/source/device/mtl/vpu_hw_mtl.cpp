@@ -22,14 +22,9 @@ static bool getCopyCommandDescriptorMTL(VPUDeviceContext *ctx,
     return VPUCopyCommand::fillDescriptor<vpu_cmd_copy_descriptor_mtl_t>(ctx, src, dst, size, desc);
 }
 
-static void printCopyDescriptorMTL(void *desc, vpu_cmd_header_t *cmd) {
-    VPUCopyCommand::printCopyDesc<vpu_cmd_copy_descriptor_mtl_t>(desc, cmd);
-}
-
 struct VPUHwInfo mtlHwInfo = {.deviceId = 0x7D1D,
                               .nExecUnits = 4096,
                               .numSubslicesPerSlice = 2,
-                              .getCopyCommand = &getCopyCommandDescriptorMTL,
-                              .printCopyDescriptor = printCopyDescriptorMTL};
+                              .getCopyCommand = &getCopyCommandDescriptorMTL};
 
 } // namespace VPU
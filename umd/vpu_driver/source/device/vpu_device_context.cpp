@@ -7,12 +7,16 @@
 
 #include "umd_common.hpp"
 
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
 #include "vpu_driver/source/command/vpu_copy_command.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
 #include "vpu_driver/source/device/hw_info.hpp"
 #include "vpu_driver/source/device/vpu_device.hpp"
 #include "vpu_driver/source/device/vpu_device_context.hpp"
 #include "vpu_driver/source/memory/vpu_buffer_object.hpp"
 #include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
 
 #include <cassert>
 #include <memory>
@@ -24,19 +28,42 @@ namespace VPU {
 
 VPUDeviceContext::VPUDeviceContext(std::unique_ptr<VPUDriverApi> drvApi, VPUHwInfo *info)
     : drvApi(std::move(drvApi))
-    , hwInfo(info) {
+    , hwInfo(info)
+    , slabAllocator(*this->drvApi) {
     LOG_I("VPUDeviceContext is created");
 }
 
 VPUBufferObject *VPUDeviceContext::createBufferObject(const size_t size,
                                                       const VPUBufferObject::Type type,
                                                       const VPUBufferObject::Location loc) {
-    std::unique_ptr<VPUBufferObject> bo = VPUBufferObject::create(*drvApi, loc, type, size);
+    // Recycled user allocations are matched by page aligned size
+    bool recycle = loc != VPUBufferObject::Location::Internal && bufferCache.isEnabled();
+    size_t allocSize = recycle ? getPageAlignedSize(size) : size;
+
+    std::unique_ptr<VPUBufferObject> bo = nullptr;
+    if (recycle) {
+        bo = bufferCache.take(type, allocSize);
+        if (bo != nullptr) {
+            bo->setLocation(loc);
+            return trackBufferObject(std::move(bo));
+        }
+    }
+
+    bo = VPUBufferObject::create(*drvApi, loc, type, allocSize);
+    if (bo == nullptr && bufferCache.trim() > 0) {
+        LOG_W("Buffer cache trimmed on allocation failure, retrying allocation");
+        bo = VPUBufferObject::create(*drvApi, loc, type, allocSize);
+    }
+
     if (bo == nullptr) {
         LOG_E("Failed to create VPUBufferObject");
         return nullptr;
     }
 
+    return trackBufferObject(std::move(bo));
+}
+
+VPUBufferObject *VPUDeviceContext::trackBufferObject(std::unique_ptr<VPUBufferObject> bo) {
     void *ptr = bo->getBasePointer();
     if (ptr == nullptr) {
         LOG_E("Failed to received base pointer from new VPUBufferObject");
@@ -47,6 +74,16 @@ VPUBufferObject *VPUDeviceContext::createBufferObject(const size_t size,
     auto [it, success] = trackedBuffers.try_emplace(ptr, std::move(bo));
     if (!success) {
         LOG_E("Failed to add buffer object to trackedBuffers");
+        if (bo->getParent() != nullptr)
+            slabAllocator.free(bo.get());
+        return nullptr;
+    }
+
+    if (!bufferIndex.insert(it->second.get())) {
+        LOG_E("Failed to add buffer object to bufferIndex");
+        if (it->second->getParent() != nullptr)
+            slabAllocator.free(it->second.get());
+        trackedBuffers.erase(it);
         return nullptr;
     }
 
@@ -75,12 +112,31 @@ bool VPUDeviceContext::freeMemAlloc(VPUBufferObject *bo) {
         return false;
     }
 
-    const std::lock_guard<std::mutex> lock(mtx);
-    if (trackedBuffers.erase(bo->getBasePointer()) == 0) {
-        LOG_E("Failed to remove VPUBufferObject from trackedBuffers!");
-        return false;
+    std::unique_ptr<VPUBufferObject> released = nullptr;
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        auto it = trackedBuffers.find(bo->getBasePointer());
+        if (it == trackedBuffers.end() || it->second.get() != bo) {
+            LOG_E("Failed to remove VPUBufferObject from trackedBuffers!");
+            return false;
+        }
+
+        // Block has to return to slab before the pointer is free'd for tracking
+        if (bo->getParent() != nullptr && !slabAllocator.free(bo)) {
+            LOG_E("Failed to return VPUBufferObject to slab");
+            return false;
+        }
+
+        bufferIndex.erase(bo);
+        released = std::move(it->second);
+        trackedBuffers.erase(it);
     }
 
+    if (released->getParent() == nullptr &&
+        released->getLocation() != VPUBufferObject::Location::Internal &&
+        bufferCache.isEnabled())
+        bufferCache.put(std::move(released));
+
     return true;
 }
 
@@ -90,14 +146,12 @@ VPUBufferObject *VPUDeviceContext::findBuffer(const void *ptr) const {
         return nullptr;
     }
 
-    const std::lock_guard<std::mutex> lock(mtx);
-    auto it = trackedBuffers.lower_bound(ptr);
-    if (it == trackedBuffers.end()) {
+    auto *bo = bufferIndex.find(ptr);
+    if (bo == nullptr) {
         LOG_E("Failed to find pointer %p in device context!", ptr);
         return nullptr;
     }
 
-    auto &bo = it->second;
     if (!bo->isInRange(ptr)) {
         LOG_E("Pointer is not within the range");
         return nullptr;
@@ -107,16 +161,29 @@ VPUBufferObject *VPUDeviceContext::findBuffer(const void *ptr) const {
           ptr,
           static_cast<int>(bo->getLocation()),
           static_cast<int>(bo->getType()));
-    return bo.get();
+    return bo;
 }
 
 VPUBufferObject *VPUDeviceContext::createInternalBufferObject(size_t size,
-                                                              VPUBufferObject::Type range) {
+                                                              VPUBufferObject::Type range,
+                                                              bool suballocate) {
     if (size == 0) {
         LOG_E("Invalid size - %lu", size);
         return nullptr;
     }
 
+    if (suballocate && VPUSlabAllocator::isSupportedSize(size)) {
+        auto bo = slabAllocator.allocate(size, range);
+        if (bo == nullptr) {
+            LOG_E("Failed to suballocate memory, size = %lu, type = %i",
+                  size,
+                  static_cast<int>(range));
+            return nullptr;
+        }
+
+        return trackBufferObject(std::move(bo));
+    }
+
     VPUBufferObject *bo = createBufferObject(size, range, VPUBufferObject::Location::Internal);
     if (bo == nullptr) {
         LOG_E("Failed to allocate shared memory, size = %lu, type = %i",
@@ -128,6 +195,84 @@ VPUBufferObject *VPUDeviceContext::createInternalBufferObject(size_t size,
     return bo;
 }
 
+VPUBufferObject *VPUDeviceContext::acquireSharedBufferObject(const void *data,
+                                                             size_t size,
+                                                             VPUBufferObject::Type type,
+                                                             bool suballocate) {
+    if (data == nullptr || size == 0) {
+        LOG_E("Invalid shared buffer content, data: %p, size: %lu", data, size);
+        return nullptr;
+    }
+
+    return sharedBuffers.acquire(data, size, type, suballocate, [&]() -> VPUBufferObject * {
+        VPUBufferObject *bo = createInternalBufferObject(size, type, suballocate);
+        if (bo == nullptr)
+            return nullptr;
+
+        if (!bo->copyToBuffer(data, size, 0)) {
+            LOG_E("Failed to copy shared buffer content");
+            freeMemAlloc(bo);
+            return nullptr;
+        }
+        return bo;
+    });
+}
+
+bool VPUDeviceContext::releaseSharedBufferObject(VPUBufferObject *bo) {
+    bool lastReference = false;
+    if (!sharedBuffers.release(bo, lastReference)) {
+        LOG_E("Buffer object %p is not shared", bo);
+        return false;
+    }
+
+    return !lastReference || freeMemAlloc(bo);
+}
+
+bool VPUDeviceContext::acquireScratchRegion(size_t scratchSize,
+                                            size_t metadataSize,
+                                            VPUScratchPool::Region &region) {
+    return scratchPool.acquire(
+        scratchSize,
+        metadataSize,
+        region,
+        [this](size_t scratchSize, size_t metadataSize, VPUScratchPool::Region &newRegion) {
+            // Jobs are matched with the region by handle, so heaps are not suballocated
+            newRegion.scratch = createInternalBufferObject(scratchSize,
+                                                           VPUBufferObject::Type::WriteCombineHigh,
+                                                           false);
+            if (newRegion.scratch == nullptr)
+                return false;
+
+            newRegion.metadata = createInternalBufferObject(metadataSize,
+                                                            VPUBufferObject::Type::WriteCombineLow,
+                                                            false);
+            if (newRegion.metadata == nullptr) {
+                freeMemAlloc(newRegion.scratch);
+                return false;
+            }
+            return true;
+        });
+}
+
+bool VPUDeviceContext::releaseScratchRegion(const VPUScratchPool::Region &region) {
+    bool removed = false;
+    if (!scratchPool.release(region, removed))
+        return false;
+
+    if (!removed)
+        return true;
+
+    bool freed = freeMemAlloc(region.scratch);
+    return freeMemAlloc(region.metadata) && freed;
+}
+
+void VPUDeviceContext::setScratchPoolRegions(size_t count) {
+    for (const auto &region : scratchPool.setMaxRegions(count)) {
+        if (!freeMemAlloc(region.scratch) || !freeMemAlloc(region.metadata))
+            LOG_E("Failed to free heaps of scratch pool region");
+    }
+}
+
 CopyDirection VPUDeviceContext::getCopyDirection(void *dstPtr, const void *srcPtr) {
     auto dstBO = findBuffer(dstPtr);
     auto srcBO = findBuffer(srcPtr);
@@ -192,7 +337,9 @@ bool VPUDeviceContext::submitCommandBuffer(const VPUCommandBuffer *cmdBuffer) {
     return true;
 }
 
-bool VPUDeviceContext::submitJob(const VPUJob *job) {
+bool VPUDeviceContext::submitJob(VPUJob *job, const void *queue) {
+    VPUJobTracer::Scope traceScope("submitJob", job);
+
     if (job == nullptr) {
         LOG_W("Invalid argument - job is nullptr");
         return false;
@@ -203,18 +350,67 @@ bool VPUDeviceContext::submitJob(const VPUJob *job) {
         return false;
     }
 
+    if (VPUCommandDecoder::isCaptureEnabled())
+        captureCommandBuffers(job);
+
+    // Other job must not find the lease idle before the job is submitted
+    std::unique_lock<std::mutex> leaseLock;
+    if (scratchPool.getRegionCount() > 0) {
+        leaseLock = std::unique_lock<std::mutex>(scratchLeaseMtx);
+        leaseScratchRegions(job, leaseLock);
+    }
+
     for (const auto &cmdBuffer : job->getCommandBuffers()) {
-        cmdBuffer->printCommandBuffer(job->getDescriptorPtr());
         if (!submitCommandBuffer(cmdBuffer.get())) {
             LOG_E("Failed to submit job using cmdBuffer: %p", cmdBuffer.get());
             return false;
         }
     }
 
+    if (VPUJobTracer::isEnabled())
+        VPUJobTracer::getInstance().jobSubmitted(job, queue ? queue : this);
+
     LOG_V("Buffer execution successfully triggered.");
     return true;
 }
 
+void VPUDeviceContext::leaseScratchRegions(VPUJob *job, std::unique_lock<std::mutex> &lock) {
+    std::vector<uint32_t> handles;
+    for (const auto &cmdBuffer : job->getCommandBuffers())
+        handles.insert(handles.end(),
+                       cmdBuffer->getBufferHandles().begin(),
+                       cmdBuffer->getBufferHandles().end());
+
+    auto isCompleted = [](void *holder) {
+        return static_cast<VPUJob *>(holder)->waitForCompletion(0);
+    };
+
+    uint32_t seq = completionNotifier.getSequence();
+    while (!scratchPool.lease(handles, job, isCompleted)) {
+        LOG_V("Job %p waits for scratch pool region used by other job", job);
+        lock.unlock();
+        completionNotifier.wait(
+            seq,
+            getAbsoluteTimeoutNanoseconds(VPUCompletionNotifier::jobWaitSliceNs));
+        lock.lock();
+        seq = completionNotifier.getSequence();
+    }
+}
+
+void VPUDeviceContext::captureCommandBuffers(const VPUJob *job) {
+    std::vector<const VPUBufferObject *> heaps;
+    job->getDescriptorBuffers(heaps);
+
+    for (const auto &cmdBuffer : job->getCommandBuffers()) {
+        auto path = VPUCommandDecoder::getNextCapturePath(cmdBuffer->getEngine());
+        if (cmdBuffer->writeCapture(path, heaps))
+            LOG_I("%s command buffer of job %p captured to %s",
+                  cmdBuffer->getName(),
+                  job,
+                  path.c_str());
+    }
+}
+
 bool VPUDeviceContext::getCopyCommandDescriptor(const void *src,
                                                 void *dst,
                                                 size_t size,
@@ -227,13 +423,4 @@ bool VPUDeviceContext::getCopyCommandDescriptor(const void *src,
     return hwInfo->getCopyCommand(this, src, dst, size, desc);
 }
 
-void VPUDeviceContext::printCopyDescriptor(void *desc, vpu_cmd_header_t *cmd) {
-    if (hwInfo->printCopyDescriptor == nullptr) {
-        LOG_W("Failed to print copy descriptor");
-        return;
-    }
-
-    hwInfo->printCopyDescriptor(desc, cmd);
-}
-
 } // namespace VPU
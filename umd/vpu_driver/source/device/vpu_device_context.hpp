@@ -8,9 +8,15 @@
 #pragma once
 
 #include "vpu_driver/source/command/vpu_command.hpp"
+#include "vpu_driver/source/command/vpu_completion_notifier.hpp"
 #include "vpu_driver/source/device/hw_info.hpp"
 #include "vpu_driver/source/device/vpu_device.hpp"
+#include "vpu_driver/source/memory/vpu_buffer_cache.hpp"
+#include "vpu_driver/source/memory/vpu_buffer_index.hpp"
 #include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+#include "vpu_driver/source/memory/vpu_scratch_pool.hpp"
+#include "vpu_driver/source/memory/vpu_shared_buffer_registry.hpp"
+#include "vpu_driver/source/memory/vpu_slab_allocator.hpp"
 
 #include <memory>
 #include <mutex>
@@ -94,17 +100,86 @@ class VPUDeviceContext {
      * @brief Submit given command buffer to KMD.
      *
      * @param job    VPUJob that contains command buffers for execution
+     * @param queue  Queue that submits the job, used to group submissions in job traces. The
+     *               context itself is used when not given.
      * @return true if job submitted successfully
+     *
+     * Job that uses scratch pool region of other job in flight waits for its completion before
+     * it is submitted.
      */
-    bool submitJob(const VPUJob *job);
+    bool submitJob(VPUJob *job, const void *queue = nullptr);
 
     /**
-       Allocates VPUBufferObject for internal usage of driver.
+       Allocates VPUBufferObject for internal usage of driver. Small buffers are suballocated
+       from shared slab, such buffer reports handle of the slab.
        @param size[in]: Size of the buffer.
        @param type[in]: Type of buffer range.
+       @param suballocate[in]: Allow to place the buffer in slab.
        @return pointer to buffer object
      */
-    VPUBufferObject *createInternalBufferObject(size_t size, VPUBufferObject::Type type);
+    VPUBufferObject *createInternalBufferObject(size_t size,
+                                                VPUBufferObject::Type type,
+                                                bool suballocate = true);
+
+    /**
+       Returns internal buffer object holding a copy of immutable data. Buffer is shared by all
+       callers that pass the same data, type and suballocation, every acquired buffer has to be
+       released with releaseSharedBufferObject.
+       @param data[in]: Content of the buffer, it must not be modified by the device.
+       @param size[in]: Size of the content.
+       @param type[in]: Type of buffer range.
+       @param suballocate[in]: Allow to place the buffer in slab.
+       @return pointer to buffer object
+     */
+    VPUBufferObject *acquireSharedBufferObject(const void *data,
+                                               size_t size,
+                                               VPUBufferObject::Type type,
+                                               bool suballocate = true);
+
+    /**
+       Drop reference of shared buffer object, buffer is freed with its last reference.
+       @return false if the buffer object is not shared or failed to be freed.
+     */
+    bool releaseSharedBufferObject(VPUBufferObject *bo);
+
+    /**
+     * Return number of distinct shared buffer objects
+     */
+    size_t getSharedBufferCount() const { return sharedBuffers.getCount(); }
+
+    /**
+       Bind graph to scratch and metadata heaps of the context scratch pool.
+       @param scratchSize[in]: Size of the scratch heap.
+       @param metadataSize[in]: Size of the metadata heap.
+       @param region[out]: Heaps the graph is bound to.
+       @return false if the pool is disabled or has no idle region for the graph, heaps have to
+       be allocated by the caller then.
+     */
+    bool acquireScratchRegion(size_t scratchSize,
+                              size_t metadataSize,
+                              VPUScratchPool::Region &region);
+
+    /**
+       Unbind graph from scratch pool region, the region is kept for the next graph.
+       @return false if the region is not in the pool.
+     */
+    bool releaseScratchRegion(const VPUScratchPool::Region &region);
+
+    /**
+       End scratch pool region leases of destroyed job.
+     */
+    void endScratchLeases(const VPUJob *job) { scratchPool.endLeases(job); }
+
+    /**
+     * Set number of scratch pool regions, the pool is disabled when count is 0. Heaps of
+     * regions without graphs above the limit are freed.
+     */
+    void setScratchPoolRegions(size_t count);
+
+    /**
+     * Return number of scratch pool regions, idle or in use
+     */
+    size_t getScratchRegionCount() const { return scratchPool.getRegionCount(); }
 
     int getFd() const { return drvApi->getFd(); }
     /**
@@ -127,8 +202,33 @@ class VPUDeviceContext {
      */
     size_t getBuffersCount() const { return trackedBuffers.size(); }
 
+    /**
+     * Set limits of the cache that recycles released user allocations, the cache is disabled
+     * when maxBytes is 0.
+     */
+    void setBufferCacheLimits(const VPUBufferCache::Limits &limits) {
+        bufferCache.setLimits(limits);
+    }
+
+    /**
+     * Release buffer objects held by the cache of user allocations.
+     * @return number of released bytes
+     */
+    size_t trimBufferCache() { return bufferCache.trim(); }
+
+    /**
+     * Return the cache of user allocations
+     */
+    const VPUBufferCache &getBufferCache() const { return bufferCache; }
+
+    VPUCompletionNotifier &getCompletionNotifier() { return completionNotifier; }
+
+    /**
+     * Return number of slabs used for internal buffer objects
+     */
+    size_t getSlabCount() const { return slabAllocator.getSlabCount(); }
+
     bool getCopyCommandDescriptor(const void *src, void *dst, size_t size, VPUDescriptor &desc);
-    void printCopyDescriptor(void *desc, vpu_cmd_header_t *cmd);
 
   private:
     /**
@@ -142,15 +242,46 @@ class VPUDeviceContext {
                                         const VPUBufferObject::Type range,
                                         const VPUBufferObject::Location location);
 
+    /**
+       Assign VPUBufferObject to tracking structure
+       @param bo buffer object to track
+       @return pointer to VPUBufferObject, on failure return nullptr
+     */
+    VPUBufferObject *trackBufferObject(std::unique_ptr<VPUBufferObject> bo);
+
     bool submitCommandBuffer(const VPUCommandBuffer *cmdBuffer);
 
+    /**
+       Write command buffers of the job with its descriptors to the capture directory
+       @see VPUCommandDecoder
+     */
+    void captureCommandBuffers(const VPUJob *job);
+
+    /**
+       Lease scratch pool regions used by the job, the lock is released while other job holding
+       a region executes.
+     */
+    void leaseScratchRegions(VPUJob *job, std::unique_lock<std::mutex> &lock);
+
   private:
     std::unique_ptr<VPUDriverApi> drvApi;
     VPUHwInfo *hwInfo;
 
+    VPUSlabAllocator slabAllocator;
+    VPUBufferCache bufferCache;
+    VPUSharedBufferRegistry sharedBuffers;
+    VPUScratchPool scratchPool;
+    /* Held from lease of scratch pool regions until the job is submitted */
+    std::mutex scratchLeaseMtx;
+
     std::map<const void *, std::unique_ptr<VPUBufferObject>, std::greater<const void *>>
         trackedBuffers;
+    /* Lock-free lookup of trackedBuffers, modified under mtx */
+    VPUBufferIndex bufferIndex;
     mutable std::mutex mtx;
+
+    /* Destroyed first, the notification thread may still wait on jobs using the context */
+    VPUCompletionNotifier completionNotifier;
 };
 
 } // namespace VPU
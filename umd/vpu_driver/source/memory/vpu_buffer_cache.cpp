@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_buffer_cache.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+namespace VPU {
+
+void VPUBufferCache::setLimits(const Limits &newLimits) {
+    List evicted;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    limits = newLimits;
+    trimLocked(limits.maxBytes, evicted);
+    LOG_I("Buffer cache limits set to %lu bytes, %lu buffers per size",
+          limits.maxBytes,
+          limits.maxBuffersPerSize);
+}
+
+bool VPUBufferCache::isEnabled() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return limits.maxBytes > 0 && limits.maxBuffersPerSize > 0;
+}
+
+void VPUBufferCache::evict(List::iterator it, List &evicted) {
+    auto [begin, end] = lookup.equal_range(Key((*it)->getType(), (*it)->getAllocSize()));
+    for (auto lookupIt = begin; lookupIt != end; lookupIt++) {
+        if (lookupIt->second == it) {
+            lookup.erase(lookupIt);
+            break;
+        }
+    }
+
+    cachedBytes -= (*it)->getAllocSize();
+    evicted.splice(evicted.end(), buffers, it);
+}
+
+void VPUBufferCache::trimLocked(size_t targetBytes, List &evicted) {
+    while (cachedBytes > targetBytes && !buffers.empty())
+        evict(std::prev(buffers.end()), evicted);
+}
+
+std::unique_ptr<VPUBufferObject> VPUBufferCache::take(VPUBufferObject::Type type, size_t size) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto [begin, end] = lookup.equal_range(Key(type, size));
+    if (begin == end)
+        return nullptr;
+
+    auto lookupIt = std::prev(end);
+    auto it = lookupIt->second;
+    auto bo = std::move(*it);
+    lookup.erase(lookupIt);
+    buffers.erase(it);
+    cachedBytes -= size;
+
+    LOG_I("Buffer object %p taken from cache, cached bytes: %lu", bo->getBasePointer(), cachedBytes);
+    return bo;
+}
+
+void VPUBufferCache::put(std::unique_ptr<VPUBufferObject> bo) {
+    if (bo == nullptr)
+        return;
+
+    // Buffers released by cache are unmapped after the lock is dropped
+    List evicted;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    size_t size = bo->getAllocSize();
+    if (size > limits.maxBytes || limits.maxBuffersPerSize == 0) {
+        evicted.emplace_back(std::move(bo));
+        return;
+    }
+
+    Key key(bo->getType(), size);
+    if (lookup.count(key) >= limits.maxBuffersPerSize)
+        evict(lookup.lower_bound(key)->second, evicted);
+
+    buffers.emplace_front(std::move(bo));
+    lookup.emplace(key, buffers.begin());
+    cachedBytes += size;
+
+    trimLocked(limits.maxBytes, evicted);
+}
+
+size_t VPUBufferCache::trim(size_t targetBytes) {
+    List evicted;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    size_t prevBytes = cachedBytes;
+    trimLocked(targetBytes, evicted);
+    return prevBytes - cachedBytes;
+}
+
+size_t VPUBufferCache::getCachedBytes() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return cachedBytes;
+}
+
+size_t VPUBufferCache::getCachedCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return buffers.size();
+}
+
+} // namespace VPU
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace VPU {
+
+/**
+   Bounded cache of released buffer objects that are still mapped. Buffers are recycled by
+   matching type and page aligned size, the least recently released buffer is dropped first.
+   Cache is disabled until non zero limit of bytes is set.
+ */
+class VPUBufferCache {
+  public:
+    struct Limits {
+        /* High-water mark of cached bytes, 0 disables the cache */
+        size_t maxBytes = 0;
+        /* Maximum number of cached buffers of the same type and size */
+        size_t maxBuffersPerSize = 8;
+    };
+
+    VPUBufferCache() = default;
+    ~VPUBufferCache() = default;
+
+    VPUBufferCache(const VPUBufferCache &) = delete;
+    VPUBufferCache &operator=(const VPUBufferCache &) = delete;
+
+    /**
+       Set new limits, cached buffers above limits are released.
+     */
+    void setLimits(const Limits &newLimits);
+    bool isEnabled() const;
+
+    /**
+       Take cached buffer object of given type and size.
+       @return buffer object or nullptr if cache does not hold matching buffer.
+     */
+    std::unique_ptr<VPUBufferObject> take(VPUBufferObject::Type type, size_t size);
+
+    /**
+       Store buffer object in the cache, buffer is released if it does not fit in the limits.
+     */
+    void put(std::unique_ptr<VPUBufferObject> bo);
+
+    /**
+       Release least recently cached buffers until cached size is not greater than targetBytes.
+       @return number of released bytes.
+     */
+    size_t trim(size_t targetBytes = 0);
+
+    size_t getCachedBytes() const;
+    size_t getCachedCount() const;
+
+  private:
+    using Key = std::pair<VPUBufferObject::Type, size_t>;
+    using List = std::list<std::unique_ptr<VPUBufferObject>>;
+
+    void evict(List::iterator it, List &evicted);
+    void trimLocked(size_t targetBytes, List &evicted);
+
+    Limits limits;
+    size_t cachedBytes = 0;
+    /* Front is the most recently cached buffer */
+    List buffers;
+    std::multimap<Key, List::iterator> lookup;
+    mutable std::mutex mtx;
+};
+
+} // namespace VPU
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "umd_common.hpp"
+
+#include "vpu_driver/source/memory/vpu_buffer_index.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <algorithm>
+
+namespace VPU {
+
+std::atomic<uintptr_t> *VPUBufferIndex::getPageEntry(uintptr_t addr) {
+    uintptr_t page = addr >> pageShift;
+    auto &middle = root[(page >> (2 * levelShift)) & (levelSize - 1)];
+    if (middle.load(std::memory_order_relaxed) == nullptr) {
+        middles.emplace_back(std::make_unique<Middle>());
+        middle.store(middles.back().get(), std::memory_order_release);
+    }
+
+    auto &leaf = (*middle.load(std::memory_order_relaxed))[(page >> levelShift) & (levelSize - 1)];
+    if (leaf.load(std::memory_order_relaxed) == nullptr) {
+        leaves.emplace_back(std::make_unique<Leaf>());
+        leaf.store(leaves.back().get(), std::memory_order_release);
+    }
+
+    return &(*leaf.load(std::memory_order_relaxed))[page & (levelSize - 1)];
+}
+
+VPUBufferIndex::Block *VPUBufferIndex::getBlock(std::atomic<uintptr_t> &entry) {
+    uintptr_t value = entry.load(std::memory_order_relaxed);
+    if (value & blockTag)
+        return reinterpret_cast<Block *>(value & ~blockTag);
+
+    // Page claimed so far as a whole is split, all blocks inherit the current owner
+    blocks.emplace_back(std::make_unique<Block>());
+    Block *block = blocks.back().get();
+    for (auto &b : *block)
+        b.store(reinterpret_cast<VPUBufferObject *>(value), std::memory_order_relaxed);
+
+    entry.store(reinterpret_cast<uintptr_t>(block) | blockTag, std::memory_order_release);
+    return block;
+}
+
+bool VPUBufferIndex::update(const VPUBufferObject *bo, VPUBufferObject *value) {
+    uintptr_t begin = reinterpret_cast<uintptr_t>(bo->getBasePointer());
+    uintptr_t end = begin + bo->getAllocSize();
+    // Buffer that owns the memory is mapped with page granularity
+    end = bo->getParent() == nullptr ? ALIGN(end, pageSize) : ALIGN(end, blockSize);
+
+    if (begin % blockSize != 0 || end > maxAddress || end <= begin) {
+        LOG_E("Buffer range %#lx - %#lx can not be indexed", begin, end);
+        return false;
+    }
+
+    uintptr_t addr = begin;
+    while (addr < end) {
+        auto *entry = getPageEntry(addr);
+        uintptr_t pageEnd = ALIGN(addr + 1, pageSize);
+
+        if (addr % pageSize == 0 && pageEnd <= end &&
+            !(entry->load(std::memory_order_relaxed) & blockTag)) {
+            entry->store(reinterpret_cast<uintptr_t>(value), std::memory_order_release);
+            addr = pageEnd;
+            continue;
+        }
+
+        Block *block = getBlock(*entry);
+        for (; addr < std::min(pageEnd, end); addr += blockSize)
+            (*block)[(addr % pageSize) >> blockShift].store(value, std::memory_order_release);
+    }
+
+    return true;
+}
+
+bool VPUBufferIndex::insert(VPUBufferObject *bo) {
+    if (bo == nullptr) {
+        LOG_E("VPUBufferObject is nullptr");
+        return false;
+    }
+
+    return update(bo, bo);
+}
+
+void VPUBufferIndex::erase(const VPUBufferObject *bo) {
+    if (bo == nullptr) {
+        LOG_E("VPUBufferObject is nullptr");
+        return;
+    }
+
+    update(bo, nullptr);
+}
+
+VPUBufferObject *VPUBufferIndex::find(const void *ptr) const {
+    uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    if (addr >= maxAddress)
+        return nullptr;
+
+    uintptr_t page = addr >> pageShift;
+    Middle *middle = root[page >> (2 * levelShift)].load(std::memory_order_acquire);
+    if (middle == nullptr)
+        return nullptr;
+
+    Leaf *leaf = (*middle)[(page >> levelShift) & (levelSize - 1)].load(std::memory_order_acquire);
+    if (leaf == nullptr)
+        return nullptr;
+
+    uintptr_t value = (*leaf)[page & (levelSize - 1)].load(std::memory_order_acquire);
+    if (value & blockTag) {
+        auto *block = reinterpret_cast<Block *>(value & ~blockTag);
+        return (*block)[(addr % pageSize) >> blockShift].load(std::memory_order_acquire);
+    }
+
+    return reinterpret_cast<VPUBufferObject *>(value);
+}
+
+} // namespace VPU
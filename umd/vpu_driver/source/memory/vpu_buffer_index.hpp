@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace VPU {
+
+/**
+   Address range index that maps CPU pointers to buffer objects. It is a three level radix table
+   with page granularity, pages shared by several suballocated buffers point to a node with
+   64 byte granularity. Lookup is wait-free, insert and erase have to be serialized by caller.
+   Table nodes are released only on destruction.
+ */
+class VPUBufferIndex {
+  public:
+    VPUBufferIndex() = default;
+    ~VPUBufferIndex() = default;
+
+    VPUBufferIndex(const VPUBufferIndex &) = delete;
+    VPUBufferIndex &operator=(const VPUBufferIndex &) = delete;
+
+    /**
+       Map memory range of the buffer object to the buffer object. Buffer object that owns
+       the memory claims whole pages, sub buffer claims 64 byte blocks.
+       @return true on success, false if the range can not be indexed.
+     */
+    bool insert(VPUBufferObject *bo);
+
+    /**
+       Remove memory range of the buffer object from index.
+     */
+    void erase(const VPUBufferObject *bo);
+
+    /**
+       Find buffer object that claims the given pointer.
+       @param ptr[in]: Pointer to find object.
+       @return : Found VPUBufferObject, nullptr otherwise.
+     */
+    VPUBufferObject *find(const void *ptr) const;
+
+  private:
+    static constexpr size_t blockShift = 6;
+    static constexpr size_t pageShift = 12;
+    static constexpr size_t levelShift = 12;
+    static constexpr size_t levelSize = 1 << levelShift;
+    static constexpr size_t blockCount = 1 << (pageShift - blockShift);
+    static constexpr uintptr_t pageSize = 1 << pageShift;
+    static constexpr uintptr_t blockSize = 1 << blockShift;
+    static constexpr uintptr_t maxAddress = 1ul << (pageShift + 3 * levelShift);
+    /* Page entry with this bit set points to Block node */
+    static constexpr uintptr_t blockTag = 1;
+
+    using Block = std::array<std::atomic<VPUBufferObject *>, blockCount>;
+    using Leaf = std::array<std::atomic<uintptr_t>, levelSize>;
+    using Middle = std::array<std::atomic<Leaf *>, levelSize>;
+
+    std::atomic<uintptr_t> *getPageEntry(uintptr_t addr);
+    Block *getBlock(std::atomic<uintptr_t> &entry);
+    bool update(const VPUBufferObject *bo, VPUBufferObject *value);
+
+    std::array<std::atomic<Middle *>, levelSize> root = {};
+
+    std::vector<std::unique_ptr<Middle>> middles;
+    std::vector<std::unique_ptr<Leaf>> leaves;
+    std::vector<std::unique_ptr<Block>> blocks;
+};
+
+} // namespace VPU
@@ -31,6 +31,9 @@ VPUBufferObject::VPUBufferObject(const VPUDriverApi &drvApi,
     , handle(handle) {}
 
 VPUBufferObject::~VPUBufferObject() {
+    if (parent != nullptr)
+        return;
+
     if (drvApi.unmap(basePtr, allocSize) != 0) {
         LOG_E("Failed to unmap handle %d", handle);
     }
@@ -66,6 +69,27 @@ VPUBufferObject::create(const VPUDriverApi &drvApi, Location type, Type range, s
     return std::make_unique<VPUBufferObject>(drvApi, type, range, ptr, size, handle, vpuAddr);
 }
 
+std::unique_ptr<VPUBufferObject>
+VPUBufferObject::createSubBuffer(const VPUBufferObject &parent, size_t offset, size_t size) {
+    if (size == 0 || offset > parent.allocSize || size > parent.allocSize - offset) {
+        LOG_E("Sub buffer (offset: %lu, size: %lu) exceeds parent buffer (size: %lu)",
+              offset,
+              size,
+              parent.allocSize);
+        return nullptr;
+    }
+
+    auto bo = std::make_unique<VPUBufferObject>(parent.drvApi,
+                                                parent.location,
+                                                parent.type,
+                                                parent.basePtr + offset,
+                                                size,
+                                                parent.handle,
+                                                parent.vpuAddr + offset);
+    bo->parent = &parent;
+    return bo;
+}
+
 bool VPUBufferObject::copyToBuffer(const void *data, size_t size, uint64_t offset) {
     if (offset > allocSize) {
         LOG_E("Invalid offset value");
@@ -41,6 +41,17 @@ class VPUBufferObject {
     static std::unique_ptr<VPUBufferObject>
     create(const VPUDriverApi &drvApi, Location type, Type range, size_t size);
 
+    /**
+       Create buffer object that covers a part of the parent buffer object. The sub buffer shares
+       handle with parent and does not own the memory, parent has to outlive the sub buffer.
+       @param parent[in]: Buffer object that backs the memory.
+       @param offset[in]: Offset in bytes from the base of the parent buffer object.
+       @param size[in]: Size in bytes of the sub buffer.
+       @return pointer to buffer object, nullptr on failure.
+     */
+    static std::unique_ptr<VPUBufferObject>
+    createSubBuffer(const VPUBufferObject &parent, size_t offset, size_t size);
+
     VPUBufferObject(const VPUDriverApi &drvApi,
                     Location memoryType,
                     Type range,
@@ -60,6 +71,11 @@ class VPUBufferObject {
      */
     Location getLocation() const { return location; }
 
+    /**
+      Change memory usage type, used when released buffer object is recycled.
+     */
+    void setLocation(Location loc) { location = loc; }
+
     /**
       Returns current range.
      */
@@ -75,6 +91,11 @@ class VPUBufferObject {
      */
     uint32_t getHandle() const { return handle; }
 
+    /**
+       Returns buffer object that backs the memory, nullptr if the object owns the memory.
+     */
+    const VPUBufferObject *getParent() const { return parent; }
+
     /**
       Returns buffer object's virtual address.
      */
@@ -114,6 +135,8 @@ class VPUBufferObject {
 
     uint64_t vpuAddr;
     uint32_t handle;
+
+    const VPUBufferObject *parent = nullptr;
 };
 
 } // namespace VPU
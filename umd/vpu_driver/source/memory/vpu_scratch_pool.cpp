@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_scratch_pool.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <algorithm>
+
+namespace VPU {
+
+std::vector<VPUScratchPool::Region> VPUScratchPool::setMaxRegions(size_t count) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    maxRegions = count;
+    LOG_I("Scratch pool limited to %lu regions", maxRegions);
+
+    std::vector<Region> removed;
+    for (auto it = entries.begin(); it != entries.end() && entries.size() > maxRegions;) {
+        if (it->graphCount > 0) {
+            it++;
+            continue;
+        }
+        removed.push_back(it->region);
+        it = entries.erase(it);
+    }
+    return removed;
+}
+
+bool VPUScratchPool::isEnabled() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return maxRegions > 0;
+}
+
+bool VPUScratchPool::acquire(size_t scratchSize,
+                             size_t metadataSize,
+                             Region &region,
+                             const CreateFunction &create) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    if (maxRegions == 0)
+        return false;
+
+    // Graphs of one region take turns through leases, spread them over the regions
+    Entry *best = nullptr;
+    for (auto &entry : entries) {
+        if (entry.region.scratch->getAllocSize() < scratchSize ||
+            entry.region.metadata->getAllocSize() < metadataSize)
+            continue;
+
+        if (best == nullptr || entry.graphCount < best->graphCount ||
+            (entry.graphCount == best->graphCount &&
+             entry.region.scratch->getAllocSize() < best->region.scratch->getAllocSize()))
+            best = &entry;
+    }
+
+    if ((best == nullptr || best->graphCount > 0) && entries.size() < maxRegions) {
+        Region newRegion;
+        if (create(scratchSize, metadataSize, newRegion)) {
+            best = &entries.emplace_back(Entry{newRegion, 0, nullptr});
+            LOG_I("Scratch pool region %lu created, scratch: %lu, metadata: %lu",
+                  entries.size(),
+                  scratchSize,
+                  metadataSize);
+        }
+    }
+
+    if (best == nullptr) {
+        LOG_W("No scratch pool region fits scratch: %lu, metadata: %lu",
+              scratchSize,
+              metadataSize);
+        return false;
+    }
+
+    best->graphCount++;
+    region = best->region;
+    return true;
+}
+
+bool VPUScratchPool::release(const Region &region, bool &removed) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (it->graphCount == 0 || it->region.scratch != region.scratch ||
+            it->region.metadata != region.metadata)
+            continue;
+
+        it->graphCount--;
+        removed = it->graphCount == 0 && entries.size() > maxRegions;
+        if (removed)
+            entries.erase(it);
+        return true;
+    }
+
+    return false;
+}
+
+bool VPUScratchPool::lease(const std::vector<uint32_t> &handles,
+                           void *holder,
+                           const CompletedFunction &isCompleted) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    std::vector<Entry *> leased;
+    for (auto &entry : entries) {
+        if (std::find(handles.begin(), handles.end(), entry.region.scratch->getHandle()) ==
+            handles.end())
+            continue;
+
+        if (entry.holder != nullptr && entry.holder != holder && !isCompleted(entry.holder))
+            return false;
+
+        leased.push_back(&entry);
+    }
+
+    for (auto *entry : leased)
+        entry->holder = holder;
+    return true;
+}
+
+void VPUScratchPool::endLeases(const void *holder) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (auto &entry : entries) {
+        if (entry.holder == holder)
+            entry.holder = nullptr;
+    }
+}
+
+size_t VPUScratchPool::getRegionCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+} // namespace VPU
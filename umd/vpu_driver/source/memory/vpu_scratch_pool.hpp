@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace VPU {
+
+/**
+   Scratch and metadata heaps shared by OV blob graphs of a device context. Firmware takes the
+   heap addresses when the graph is initialized, so a graph stays bound to its region until it
+   is destroyed, and many graphs are bound to one region once the limit of regions is reached.
+   Graphs of a region take turns: a job using the region leases it at submission and the lease
+   ends when the job completes. Region without graphs stays in the pool for the next graph.
+   The pool is disabled until non zero number of regions is set.
+ */
+class VPUScratchPool {
+  public:
+    struct Region {
+        VPUBufferObject *scratch = nullptr;
+        VPUBufferObject *metadata = nullptr;
+    };
+    using CreateFunction =
+        std::function<bool(size_t scratchSize, size_t metadataSize, Region &region)>;
+    using CompletedFunction = std::function<bool(void *holder)>;
+
+    VPUScratchPool() = default;
+    ~VPUScratchPool() = default;
+
+    VPUScratchPool(const VPUScratchPool &) = delete;
+    VPUScratchPool &operator=(const VPUScratchPool &) = delete;
+
+    /**
+       Set maximum number of regions. Regions without graphs above the limit are removed, other
+       ones are removed when their last graph is released.
+       @return removed regions, their buffers have to be freed.
+     */
+    std::vector<Region> setMaxRegions(size_t count);
+    bool isEnabled() const;
+
+    /**
+       Bind to the region with the least graphs that fits the heap sizes. New region is created
+       by the function when every region that fits has graphs and the limit is not reached.
+       @return false if the pool is disabled or has no region for the heaps.
+     */
+    bool acquire(size_t scratchSize,
+                 size_t metadataSize,
+                 Region &region,
+                 const CreateFunction &create);
+
+    /**
+       Unbind graph from the region.
+       @param removed[out]: Set when the region has no graph left and it is above the limit, its
+       buffers have to be freed.
+       @return false if the region is not bound.
+     */
+    bool release(const Region &region, bool &removed);
+
+    /**
+       Lease regions whose scratch heap is among the buffer handles of a job. Region leased by
+       other holder is taken over once the function reports that the holder has completed.
+       Either all regions are leased or none of them.
+       @return false if a region is leased by other holder that has not completed yet.
+     */
+    bool lease(const std::vector<uint32_t> &handles,
+               void *holder,
+               const CompletedFunction &isCompleted);
+
+    /**
+       End leases of the holder, it is called before the holder is destroyed.
+     */
+    void endLeases(const void *holder);
+
+    size_t getRegionCount() const;
+
+  private:
+    struct Entry {
+        Region region;
+        size_t graphCount;
+        /* Job that executes on the region, nullptr if the region is not leased */
+        void *holder;
+    };
+
+    size_t maxRegions = 0;
+    std::vector<Entry> entries;
+    mutable std::mutex mtx;
+};
+
+} // namespace VPU
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_shared_buffer_registry.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+namespace VPU {
+
+VPUBufferObject *VPUSharedBufferRegistry::acquire(const void *data,
+                                                  size_t size,
+                                                  VPUBufferObject::Type type,
+                                                  bool suballocate,
+                                                  const CreateFunction &create) {
+    const Key key = {VPUSha256::hash(data, size), size, type, suballocate};
+
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = entries.find(key);
+    while (it != entries.end() && it->second.bo == nullptr) {
+        created.wait(lock);
+        it = entries.find(key);
+    }
+
+    if (it != entries.end()) {
+        it->second.refCount++;
+        LOG_I("Shared buffer %p reused, references: %lu", it->second.bo, it->second.refCount);
+        return it->second.bo;
+    }
+
+    // Placeholder holds concurrent requests of the content until the buffer is filled
+    it = entries.emplace(key, Entry{nullptr, 1}).first;
+    lock.unlock();
+    VPUBufferObject *bo = create();
+    lock.lock();
+
+    if (bo == nullptr) {
+        entries.erase(it);
+        created.notify_all();
+        LOG_E("Failed to create shared buffer of size %lu", size);
+        return nullptr;
+    }
+
+    it->second.bo = bo;
+    index.emplace(bo, it);
+    created.notify_all();
+    LOG_I("Shared buffer %p created, size: %lu", bo, bo->getAllocSize());
+    return bo;
+}
+
+bool VPUSharedBufferRegistry::release(VPUBufferObject *bo, bool &lastReference) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto indexIt = index.find(bo);
+    if (indexIt == index.end())
+        return false;
+
+    auto it = indexIt->second;
+    lastReference = --it->second.refCount == 0;
+    if (lastReference) {
+        entries.erase(it);
+        index.erase(indexIt);
+    }
+    return true;
+}
+
+size_t VPUSharedBufferRegistry::getCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return entries.size();
+}
+
+} // namespace VPU
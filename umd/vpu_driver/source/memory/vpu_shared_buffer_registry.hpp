@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+#include "vpu_driver/source/utilities/sha256.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace VPU {
+
+/**
+   Reference counted registry of buffer objects with immutable content. Content is identified
+   by its SHA-256 digest and size, so graphs created from the same blob use one copy of their
+   constant sections and lookups never read back device memory. The digest is computed and the
+   buffer is created and filled outside the registry lock.
+ */
+class VPUSharedBufferRegistry {
+  public:
+    using CreateFunction = std::function<VPUBufferObject *()>;
+
+    VPUSharedBufferRegistry() = default;
+    ~VPUSharedBufferRegistry() = default;
+
+    VPUSharedBufferRegistry(const VPUSharedBufferRegistry &) = delete;
+    VPUSharedBufferRegistry &operator=(const VPUSharedBufferRegistry &) = delete;
+
+    /**
+       Take reference of buffer object holding the content. Buffer is created by the function,
+       which has to fill it with the content, and registered when no buffer matches. Concurrent
+       requests of the content being created wait for it.
+       @return buffer object or nullptr if creation failed.
+     */
+    VPUBufferObject *acquire(const void *data,
+                             size_t size,
+                             VPUBufferObject::Type type,
+                             bool suballocate,
+                             const CreateFunction &create);
+
+    /**
+       Drop reference of buffer object.
+       @param lastReference[out]: Set when the buffer is unregistered and has to be freed.
+       @return false if the buffer is not registered.
+     */
+    bool release(VPUBufferObject *bo, bool &lastReference);
+
+    size_t getCount() const;
+
+  private:
+    /* Content digest, content size, buffer type and suballocation */
+    using Key = std::tuple<VPUSha256::Digest, size_t, VPUBufferObject::Type, bool>;
+
+    struct Entry {
+        /* nullptr while the buffer is created, the entry is a placeholder then */
+        VPUBufferObject *bo;
+        size_t refCount;
+    };
+
+    std::map<Key, Entry> entries;
+    std::map<const VPUBufferObject *, std::map<Key, Entry>::iterator> index;
+    mutable std::mutex mtx;
+    /* Notified when placeholder is filled or removed */
+    std::condition_variable created;
+};
+
+} // namespace VPU
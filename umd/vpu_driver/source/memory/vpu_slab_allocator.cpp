@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_slab_allocator.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <string.h>
+
+namespace VPU {
+
+static_assert(VPUSlabAllocator::minBlockSize % 64 == 0,
+              "Slab blocks have to keep firmware data cache alignment");
+static_assert(VPUSlabAllocator::maxBlockSize <= VPUSlabAllocator::slabSize,
+              "Largest block has to fit in slab");
+
+VPUSlabAllocator::VPUSlabAllocator(const VPUDriverApi &drvApi)
+    : drvApi(drvApi) {}
+
+size_t VPUSlabAllocator::getBlockOrder(size_t size) {
+    size_t order = 0;
+    while ((minBlockSize << order) < size)
+        order++;
+    return order;
+}
+
+VPUSlabAllocator::Slab *VPUSlabAllocator::createSlab(VPUBufferObject::Type type) {
+    auto bo = VPUBufferObject::create(drvApi, VPUBufferObject::Location::Internal, type, slabSize);
+    if (bo == nullptr) {
+        LOG_E("Failed to create slab buffer object, type = %i", static_cast<int>(type));
+        return nullptr;
+    }
+
+    auto slab = std::make_unique<Slab>();
+    slab->bo = std::move(bo);
+    slab->freeBlocks.resize(getBlockOrder(slabSize) + 1);
+    slab->freeBlocks.back().insert(0);
+
+    auto &typeSlabs = slabs[type];
+    typeSlabs.emplace_back(std::move(slab));
+    LOG_I("Slab %p created, type = %i, slabs = %lu",
+          typeSlabs.back()->bo->getBasePointer(),
+          static_cast<int>(type),
+          typeSlabs.size());
+    return typeSlabs.back().get();
+}
+
+bool VPUSlabAllocator::allocateBlock(Slab &slab, size_t order, size_t &offset) {
+    size_t freeOrder = order;
+    while (freeOrder < slab.freeBlocks.size() && slab.freeBlocks[freeOrder].empty())
+        freeOrder++;
+
+    if (freeOrder == slab.freeBlocks.size())
+        return false;
+
+    auto it = slab.freeBlocks[freeOrder].begin();
+    offset = *it;
+    slab.freeBlocks[freeOrder].erase(it);
+
+    // Split the block, the upper halves stay free
+    while (freeOrder > order) {
+        freeOrder--;
+        slab.freeBlocks[freeOrder].insert(offset + (minBlockSize << freeOrder));
+    }
+    return true;
+}
+
+void VPUSlabAllocator::freeBlock(Slab &slab, size_t order, size_t offset) {
+    // Merge with the buddy as long as it is free
+    while (order + 1 < slab.freeBlocks.size()) {
+        size_t buddy = offset ^ (minBlockSize << order);
+        if (slab.freeBlocks[order].erase(buddy) == 0)
+            break;
+
+        offset = std::min(offset, buddy);
+        order++;
+    }
+    slab.freeBlocks[order].insert(offset);
+}
+
+bool VPUSlabAllocator::isEmpty(const Slab &slab) const {
+    return !slab.freeBlocks.back().empty();
+}
+
+std::unique_ptr<VPUBufferObject> VPUSlabAllocator::allocate(size_t size,
+                                                            VPUBufferObject::Type type) {
+    if (!isSupportedSize(size)) {
+        LOG_E("Invalid size - %lu", size);
+        return nullptr;
+    }
+
+    size_t order = getBlockOrder(size);
+    size_t offset = 0;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    Slab *slab = nullptr;
+    for (auto &s : slabs[type]) {
+        if (allocateBlock(*s, order, offset)) {
+            slab = s.get();
+            break;
+        }
+    }
+
+    if (slab == nullptr) {
+        slab = createSlab(type);
+        if (slab == nullptr || !allocateBlock(*slab, order, offset))
+            return nullptr;
+    }
+
+    auto bo = VPUBufferObject::createSubBuffer(*slab->bo, offset, size);
+    if (bo == nullptr) {
+        freeBlock(*slab, order, offset);
+        return nullptr;
+    }
+
+    // Fresh buffer objects from KMD are zeroed, keep the same behavior for reused blocks
+    memset(bo->getBasePointer(), 0, size);
+    return bo;
+}
+
+bool VPUSlabAllocator::free(const VPUBufferObject *bo) {
+    if (bo == nullptr || bo->getParent() == nullptr) {
+        LOG_E("Buffer object is not suballocated");
+        return false;
+    }
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto it = slabs.find(bo->getType());
+    if (it == slabs.end()) {
+        LOG_E("No slab for buffer object type %i", static_cast<int>(bo->getType()));
+        return false;
+    }
+
+    auto &typeSlabs = it->second;
+    for (auto slabIt = typeSlabs.begin(); slabIt != typeSlabs.end(); slabIt++) {
+        Slab &slab = **slabIt;
+        if (slab.bo.get() != bo->getParent())
+            continue;
+
+        size_t offset = static_cast<size_t>(bo->getBasePointer() - slab.bo->getBasePointer());
+        freeBlock(slab, getBlockOrder(bo->getAllocSize()), offset);
+
+        // Keep at least one slab of each type to avoid reallocation on every job
+        if (isEmpty(slab) && typeSlabs.size() > 1) {
+            LOG_I("Slab %p released", slab.bo->getBasePointer());
+            typeSlabs.erase(slabIt);
+        }
+        return true;
+    }
+
+    LOG_E("Failed to find slab for buffer object %p", bo->getBasePointer());
+    return false;
+}
+
+size_t VPUSlabAllocator::getSlabCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    size_t count = 0;
+    for (const auto &[type, typeSlabs] : slabs)
+        count += typeSlabs.size();
+    return count;
+}
+
+} // namespace VPU
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/memory/vpu_buffer_object.hpp"
+#include "vpu_driver/source/os_interface/vpu_driver_api.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace VPU {
+
+/**
+   Suballocator for small internal buffer objects. Allocations are carved out of large pre-mapped
+   buffer objects (slabs) using power of two blocks, so creation and release of a buffer does not
+   require any ioctl or mmap call once the slab exists.
+ */
+class VPUSlabAllocator {
+  public:
+    /**
+       Size of a single slab buffer object.
+     */
+    static constexpr size_t slabSize = 1024 * 1024;
+
+    /**
+       Smallest block handed out by allocator, keeps firmware data cache alignment.
+     */
+    static constexpr size_t minBlockSize = 64;
+
+    /**
+       Largest request that is served from the slab.
+     */
+    static constexpr size_t maxBlockSize = 64 * 1024;
+
+    VPUSlabAllocator(const VPUDriverApi &drvApi);
+    ~VPUSlabAllocator() = default;
+
+    VPUSlabAllocator(const VPUSlabAllocator &) = delete;
+    VPUSlabAllocator &operator=(const VPUSlabAllocator &) = delete;
+
+    /**
+       Returns true if the request of given size can be served by allocator.
+     */
+    static bool isSupportedSize(size_t size) { return size > 0 && size <= maxBlockSize; }
+
+    /**
+       Allocate sub buffer object of given type. Memory of the returned buffer is zeroed.
+       @param size[in]: Size of the buffer.
+       @param type[in]: Type of the slab to allocate from.
+       @return sub buffer object that shares handle with the slab, nullptr on failure.
+     */
+    std::unique_ptr<VPUBufferObject> allocate(size_t size, VPUBufferObject::Type type);
+
+    /**
+       Return memory of the sub buffer object back to the slab. The object itself is not destroyed.
+       @return true on success, false if the buffer object does not come from allocator.
+     */
+    bool free(const VPUBufferObject *bo);
+
+    /**
+       Return number of slab buffer objects allocated from KMD.
+     */
+    size_t getSlabCount() const;
+
+  private:
+    struct Slab {
+        std::unique_ptr<VPUBufferObject> bo;
+        /* Offsets of free blocks, indexed by block order */
+        std::vector<std::set<size_t>> freeBlocks;
+    };
+
+    static size_t getBlockOrder(size_t size);
+    Slab *createSlab(VPUBufferObject::Type type);
+    bool allocateBlock(Slab &slab, size_t order, size_t &offset);
+    void freeBlock(Slab &slab, size_t order, size_t offset);
+    bool isEmpty(const Slab &slab) const;
+
+    const VPUDriverApi &drvApi;
+    std::map<VPUBufferObject::Type, std::vector<std::unique_ptr<Slab>>> slabs;
+    mutable std::mutex mtx;
+};
+
+} // namespace VPU
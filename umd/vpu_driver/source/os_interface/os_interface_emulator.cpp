@@ -0,0 +1,648 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "umd_common.hpp"
+
+#include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/os_interface/os_interface_emulator.hpp"
+#include "vpu_driver/source/os_interface/os_interface_imp.hpp"
+
+#include <api/vpu_jsm_api.h>
+#include <api/vpu_jsm_job_cmd_api.h>
+#include <uapi/drm/ivpu_accel.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace VPU {
+
+static const char *emulatedDevnodes[] = {"/dev/accel/accel0", "/dev/dri/renderD128"};
+static const char emulatedDeviceName[] = "intel_vpu";
+static constexpr uint64_t emulatedCoreClockRate = 1'300'000'000;
+static constexpr uint64_t fenceWaitPollNs = 10'000;
+
+static int64_t getSteadyNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/* VPU timestamps are ticks of 38.4 MHz clock */
+static uint64_t getTimestampTicks() {
+    return static_cast<uint64_t>(getSteadyNanoseconds()) * 48 / 1250;
+}
+
+template <class T>
+static const T *getCommand(const vpu_cmd_header_t *cmd) {
+    if (cmd->size < sizeof(T)) {
+        LOG_E("Command %#x is too small (size: %u)", cmd->type, cmd->size);
+        return nullptr;
+    }
+    return reinterpret_cast<const T *>(cmd);
+}
+
+OsInterfaceEmulator &OsInterfaceEmulator::getInstance() {
+    static OsInterfaceEmulator instance;
+    return instance;
+}
+
+OsInterfaceEmulator::~OsInterfaceEmulator() {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    for (auto &engine : engines) {
+        engine.cv.notify_all();
+        if (engine.thread.joinable())
+            engine.thread.join();
+    }
+
+    for (auto &[handle, bo] : buffers)
+        munmap(bo.ptr, bo.size);
+}
+
+void OsInterfaceEmulator::setLatencyModel(const LatencyModel &model) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    latencyModel = model;
+}
+
+OsInterfaceEmulator::LatencyModel OsInterfaceEmulator::getLatencyModel() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return latencyModel;
+}
+
+size_t OsInterfaceEmulator::getBufferCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return buffers.size();
+}
+
+bool OsInterfaceEmulator::isEmulatedFd(int fd) const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return emulatedFds.count(fd) != 0;
+}
+
+int OsInterfaceEmulator::osiOpen(const char *pathname, int flags, mode_t mode) {
+    std::string path(pathname);
+    if (std::find(std::begin(emulatedDevnodes), std::end(emulatedDevnodes), path) ==
+        std::end(emulatedDevnodes))
+        return OsInterfaceImp::getInstance().osiOpen(pathname, flags, mode);
+
+    // Real descriptor keeps numbers unique among the files opened by the process
+    int fd = open("/dev/null", O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_E("Failed to reserve file descriptor for emulated device '%s'", pathname);
+        return -1;
+    }
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    emulatedFds.insert(fd);
+    LOG_I("Opened emulated device '%s', fd: %d", pathname, fd);
+    return fd;
+}
+
+int OsInterfaceEmulator::osiClose(int fildes) {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        if (emulatedFds.erase(fildes)) {
+            // Closing the file closes all its buffer handles
+            std::vector<uint32_t> handles;
+            for (auto &[handle, bo] : buffers) {
+                if (bo.fd == fildes && bo.handleOpen)
+                    handles.push_back(handle);
+            }
+            for (auto handle : handles) {
+                buffers.at(handle).handleOpen = false;
+                releaseBufferIfUnused(handle);
+            }
+        }
+    }
+    return OsInterfaceImp::getInstance().osiClose(fildes);
+}
+
+int OsInterfaceEmulator::osiFcntl(int fd, int cmd) {
+    return OsInterfaceImp::getInstance().osiFcntl(fd, cmd);
+}
+
+int OsInterfaceEmulator::osiIoctl(int fd, unsigned long request, void *arg) {
+    if (!isEmulatedFd(fd))
+        return OsInterfaceImp::getInstance().osiIoctl(fd, request, arg);
+
+    switch (request) {
+    case DRM_IOCTL_VERSION: {
+        auto *version = static_cast<drm_version_t *>(arg);
+        version->version_major = DRM_IVPU_DRIVER_MAJOR;
+        version->version_minor = DRM_IVPU_DRIVER_MINOR;
+        version->version_patchlevel = 0;
+        if (version->name != nullptr && version->name_len != 0)
+            memcpy(version->name,
+                   emulatedDeviceName,
+                   std::min(version->name_len, sizeof(emulatedDeviceName) - 1));
+        version->name_len = sizeof(emulatedDeviceName) - 1;
+        version->date_len = 0;
+        version->desc_len = 0;
+        return 0;
+    }
+    case DRM_IOCTL_IVPU_GET_PARAM:
+        return getParam(arg);
+    case DRM_IOCTL_IVPU_SET_PARAM:
+        return 0;
+    case DRM_IOCTL_IVPU_BO_CREATE:
+        return createBuffer(fd, arg);
+    case DRM_IOCTL_IVPU_BO_INFO:
+        return getBufferInfo(arg);
+    case DRM_IOCTL_GEM_CLOSE:
+        return closeBuffer(arg);
+    case DRM_IOCTL_IVPU_SUBMIT:
+        return submit(static_cast<drm_ivpu_submit *>(arg));
+    case DRM_IOCTL_IVPU_BO_WAIT:
+        return wait(static_cast<drm_ivpu_bo_wait *>(arg));
+    default:
+        LOG_W("Ioctl %#lx is not supported by emulated device", request);
+        errno = ENOTTY;
+        return -1;
+    }
+}
+
+void *OsInterfaceEmulator::osiAlloc(size_t size) {
+    return OsInterfaceImp::getInstance().osiAlloc(size);
+}
+
+int OsInterfaceEmulator::osiFree(void *ptr) {
+    return OsInterfaceImp::getInstance().osiFree(ptr);
+}
+
+size_t OsInterfaceEmulator::osiGetSystemPageSize() {
+    return OsInterfaceImp::getInstance().osiGetSystemPageSize();
+}
+
+void *
+OsInterfaceEmulator::osiMmap(void *addr, size_t size, int prot, int flags, int fd, off_t offset) {
+    if (!isEmulatedFd(fd))
+        return OsInterfaceImp::getInstance().osiMmap(addr, size, prot, flags, fd, offset);
+
+    // Buffer is mapped using its VPU address as mmap offset
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto it = vpuAddressMap.find(static_cast<uint64_t>(offset));
+    if (it == vpuAddressMap.end()) {
+        LOG_E("No emulated buffer at mmap offset %#lx", offset);
+        errno = EINVAL;
+        return MAP_FAILED;
+    }
+
+    BufferObject &bo = buffers.at(it->second);
+    if (size > bo.size) {
+        LOG_E("Mapping size %#lx exceeds buffer size %#lx", size, bo.size);
+        errno = EINVAL;
+        return MAP_FAILED;
+    }
+
+    bo.mappings++;
+    return bo.ptr;
+}
+
+int OsInterfaceEmulator::osiMunmap(void *addr, size_t size) {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        auto it = cpuAddressMap.find(addr);
+        if (it != cpuAddressMap.end()) {
+            BufferObject &bo = buffers.at(it->second);
+            if (bo.mappings == 0) {
+                errno = EINVAL;
+                return -1;
+            }
+            bo.mappings--;
+            releaseBufferIfUnused(it->second);
+            return 0;
+        }
+    }
+    return OsInterfaceImp::getInstance().osiMunmap(addr, size);
+}
+
+bool OsInterfaceEmulator::fileExists(std::string &p) {
+    if (std::find(std::begin(emulatedDevnodes), std::end(emulatedDevnodes), p) !=
+        std::end(emulatedDevnodes))
+        return true;
+    return OsInterfaceImp::getInstance().fileExists(p);
+}
+
+int OsInterfaceEmulator::getParam(void *arg) {
+    auto *param = static_cast<drm_ivpu_param *>(arg);
+    switch (param->param) {
+    case DRM_IVPU_PARAM_DEVICE_ID:
+        param->value = deviceId;
+        break;
+    case DRM_IVPU_PARAM_DEVICE_REVISION:
+        param->value = 0;
+        break;
+    case DRM_IVPU_PARAM_PLATFORM_TYPE:
+        param->value = DRM_IVPU_PLATFORM_TYPE_SILICON;
+        break;
+    case DRM_IVPU_PARAM_CORE_CLOCK_RATE:
+        param->value = emulatedCoreClockRate;
+        break;
+    case DRM_IVPU_PARAM_NUM_CONTEXTS:
+        param->value = 64;
+        break;
+    case DRM_IVPU_PARAM_CONTEXT_BASE_ADDRESS:
+        param->value = lowRangeBase;
+        break;
+    case DRM_IVPU_PARAM_UNIQUE_INFERENCE_ID: {
+        const std::lock_guard<std::mutex> lock(mtx);
+        param->value = nextInferenceId++;
+        break;
+    }
+    case DRM_IVPU_PARAM_CAPABILITIES:
+        // Metric streamer is not emulated
+        param->value = 0;
+        break;
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+uint64_t OsInterfaceEmulator::allocateVpuAddress(size_t size,
+                                                 uint64_t rangeBase,
+                                                 uint64_t rangeEnd) const {
+    // First fit between buffers placed in the range
+    uint64_t candidate = rangeBase;
+    for (auto it = vpuAddressMap.lower_bound(rangeBase);
+         it != vpuAddressMap.end() && it->first < rangeEnd;
+         ++it) {
+        if (it->first - candidate >= size)
+            return candidate;
+        candidate = it->first + buffers.at(it->second).size;
+    }
+
+    if (rangeEnd - candidate >= size)
+        return candidate;
+    return 0;
+}
+
+int OsInterfaceEmulator::createBuffer(int fd, void *arg) {
+    auto *args = static_cast<drm_ivpu_bo_create *>(arg);
+    if (args->size == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    size_t size = ALIGN(args->size, osiGetSystemPageSize());
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    uint64_t vpuAddr = (args->flags & DRM_IVPU_BO_HIGH_MEM)
+                           ? allocateVpuAddress(size, highRangeBase, highRangeEnd)
+                           : allocateVpuAddress(size, lowRangeBase, lowRangeEnd);
+    if (vpuAddr == 0) {
+        munmap(ptr, size);
+        errno = ENOSPC;
+        return -1;
+    }
+
+    uint32_t handle = nextHandle++;
+    buffers[handle] = {.fd = fd,
+                       .ptr = ptr,
+                       .size = size,
+                       .vpuAddr = vpuAddr,
+                       .flags = args->flags,
+                       .handleOpen = true,
+                       .mappings = 0,
+                       .pendingJobs = 0,
+                       .jobStatus = DRM_IVPU_JOB_STATUS_SUCCESS};
+    vpuAddressMap[vpuAddr] = handle;
+    cpuAddressMap[ptr] = handle;
+
+    args->handle = handle;
+    args->vpu_addr = vpuAddr;
+    LOG_V("Emulated buffer created, handle: %u, vpu address: %#lx, size: %#lx",
+          handle,
+          vpuAddr,
+          size);
+    return 0;
+}
+
+int OsInterfaceEmulator::closeBuffer(void *arg) {
+    auto *args = static_cast<drm_gem_close *>(arg);
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    BufferObject *bo = getBuffer(args->handle);
+    if (bo == nullptr || !bo->handleOpen) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    bo->handleOpen = false;
+    releaseBufferIfUnused(args->handle);
+    return 0;
+}
+
+int OsInterfaceEmulator::getBufferInfo(void *arg) {
+    auto *args = static_cast<drm_ivpu_bo_info *>(arg);
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    BufferObject *bo = getBuffer(args->handle);
+    if (bo == nullptr || !bo->handleOpen) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    args->flags = bo->flags;
+    args->vpu_addr = bo->vpuAddr;
+    args->mmap_offset = bo->vpuAddr;
+    args->size = bo->size;
+    return 0;
+}
+
+OsInterfaceEmulator::BufferObject *OsInterfaceEmulator::getBuffer(uint32_t handle) {
+    auto it = buffers.find(handle);
+    return it == buffers.end() ? nullptr : &it->second;
+}
+
+void OsInterfaceEmulator::releaseBufferIfUnused(uint32_t handle) {
+    BufferObject *bo = getBuffer(handle);
+    if (bo == nullptr || bo->handleOpen || bo->mappings || bo->pendingJobs)
+        return;
+
+    LOG_V("Emulated buffer released, handle: %u, vpu address: %#lx", handle, bo->vpuAddr);
+    munmap(bo->ptr, bo->size);
+    vpuAddressMap.erase(bo->vpuAddr);
+    cpuAddressMap.erase(bo->ptr);
+    buffers.erase(handle);
+}
+
+int OsInterfaceEmulator::submit(drm_ivpu_submit *arg) {
+    if (arg->engine >= engineCount || arg->buffer_count == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    Job job = {};
+    auto *handles = reinterpret_cast<const uint32_t *>(arg->buffers_ptr);
+    job.handles.assign(handles, handles + arg->buffer_count);
+    job.startNs = getSteadyNanoseconds();
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (auto handle : job.handles) {
+        BufferObject *bo = getBuffer(handle);
+        if (bo == nullptr || !bo->handleOpen) {
+            LOG_E("Submitted buffer handle %u does not exist", handle);
+            errno = ENOENT;
+            return -1;
+        }
+    }
+
+    BufferObject *cmdBo = getBuffer(job.handles[0]);
+    if (arg->commands_offset >= cmdBo->size) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    // Buffers of the job are kept alive until the job completes
+    for (auto handle : job.handles)
+        buffers.at(handle).pendingJobs++;
+
+    job.cmdBuffer = static_cast<uint8_t *>(cmdBo->ptr) + arg->commands_offset;
+    job.cmdBufferSize = cmdBo->size - arg->commands_offset;
+    job.startNs += static_cast<int64_t>(latencyModel.jobNs);
+
+    Engine &engine = engines[arg->engine];
+    engine.queue.push_back(std::move(job));
+    if (!engine.thread.joinable())
+        engine.thread = std::thread(&OsInterfaceEmulator::engineThread, this, arg->engine);
+    engine.cv.notify_all();
+    return 0;
+}
+
+int OsInterfaceEmulator::wait(drm_ivpu_bo_wait *arg) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (getBuffer(arg->handle) == nullptr) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    auto timeout = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(arg->timeout_ns));
+    bool idle = jobDoneCv.wait_until(lock, timeout, [this, arg] {
+        BufferObject *bo = getBuffer(arg->handle);
+        return bo == nullptr || bo->pendingJobs == 0;
+    });
+    if (!idle) {
+        errno = ETIMEDOUT;
+        return -1;
+    }
+
+    BufferObject *bo = getBuffer(arg->handle);
+    arg->job_status = bo == nullptr ? DRM_IVPU_JOB_STATUS_SUCCESS : bo->jobStatus;
+    return 0;
+}
+
+void *OsInterfaceEmulator::translate(uint64_t vpuAddr, size_t size) {
+    const std::lock_guard<std::mutex> lock(mtx);
+    auto it = vpuAddressMap.upper_bound(vpuAddr);
+    if (it == vpuAddressMap.begin())
+        return nullptr;
+    --it;
+
+    const BufferObject &bo = buffers.at(it->second);
+    uint64_t offset = vpuAddr - bo.vpuAddr;
+    if (offset > bo.size || size > bo.size - offset)
+        return nullptr;
+    return static_cast<uint8_t *>(bo.ptr) + offset;
+}
+
+void OsInterfaceEmulator::delay(uint64_t ns) const {
+    if (ns == 0)
+        return;
+    std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+}
+
+void OsInterfaceEmulator::engineThread(uint32_t engineIndex) {
+    LOG_V("Emulated engine %u started", engineIndex);
+
+    Engine &engine = engines[engineIndex];
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!stop) {
+        engine.cv.wait(lock, [this, &engine] { return stop || !engine.queue.empty(); });
+        if (stop)
+            break;
+
+        Job job = std::move(engine.queue.front());
+        engine.queue.pop_front();
+        LatencyModel latency = latencyModel;
+
+        auto start = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(job.startNs));
+        engine.cv.wait_until(lock, start, [this] { return stop.load(); });
+        if (stop)
+            break;
+
+        lock.unlock();
+        uint32_t status = toJobStatus(executeJob(job, latency));
+        lock.lock();
+
+        // Every buffer of the job reports its status, not only the command buffer
+        for (auto handle : job.handles) {
+            buffers.at(handle).jobStatus = status;
+            buffers.at(handle).pendingJobs--;
+            releaseBufferIfUnused(handle);
+        }
+        jobDoneCv.notify_all();
+    }
+
+    LOG_V("Emulated engine %u stopped", engineIndex);
+}
+
+uint32_t OsInterfaceEmulator::executeJob(const Job &job, const LatencyModel &latency) {
+    if (job.cmdBufferSize < sizeof(vpu_cmd_buffer_header_t)) {
+        LOG_E("Command buffer is too small (size: %#lx)", job.cmdBufferSize);
+        return VPU_JSM_STATUS_PARSING_ERR;
+    }
+
+    const auto *bb = reinterpret_cast<const vpu_cmd_buffer_header_t *>(job.cmdBuffer);
+    if (bb->cmd_buffer_size > job.cmdBufferSize || bb->cmd_offset < sizeof(*bb)) {
+        LOG_E("Invalid command buffer header (size: %u, commands offset: %u)",
+              bb->cmd_buffer_size,
+              bb->cmd_offset);
+        return VPU_JSM_STATUS_PARSING_ERR;
+    }
+
+    size_t cmdOffset = bb->cmd_offset;
+    while (cmdOffset < bb->cmd_buffer_size) {
+        const auto *cmd = reinterpret_cast<const vpu_cmd_header_t *>(job.cmdBuffer + cmdOffset);
+        if (cmdOffset + sizeof(*cmd) > bb->cmd_buffer_size || cmd->size < sizeof(*cmd) ||
+            cmdOffset + cmd->size > bb->cmd_buffer_size) {
+            LOG_E("Invalid command size at offset %#lx", cmdOffset);
+            return VPU_JSM_STATUS_PARSING_ERR;
+        }
+
+        switch (cmd->type) {
+        case VPU_CMD_NOP:
+        case VPU_CMD_BARRIER:
+        case VPU_CMD_METRIC_QUERY_BEGIN:
+        case VPU_CMD_METRIC_QUERY_END:
+        case VPU_CMD_OV_BLOB_INITIALIZE:
+            // Commands are executed in order, so barrier has nothing to wait for
+            break;
+        case VPU_CMD_OV_BLOB_EXECUTE:
+        case VPU_CMD_INFERENCE_EXECUTE:
+        case VPU_CMD_JIT_MAPPED_INFERENCE_EXECUTE:
+            delay(latency.inferenceNs);
+            break;
+        case VPU_CMD_TIMESTAMP: {
+            const auto *ts = getCommand<vpu_cmd_timestamp_t>(cmd);
+            if (ts == nullptr)
+                return VPU_JSM_STATUS_PARSING_ERR;
+
+            auto *dst = static_cast<uint64_t *>(translate(ts->timestamp_address, sizeof(uint64_t)));
+            if (dst == nullptr) {
+                LOG_E("Invalid timestamp address %#lx", ts->timestamp_address);
+                return VPU_JSM_STATUS_PROCESSING_ERR;
+            }
+            __atomic_store_n(dst, getTimestampTicks(), __ATOMIC_RELEASE);
+            break;
+        }
+        case VPU_CMD_FENCE_SIGNAL:
+        case VPU_CMD_FENCE_WAIT: {
+            const auto *fence = getCommand<vpu_cmd_fence_t>(cmd);
+            if (fence == nullptr)
+                return VPU_JSM_STATUS_PARSING_ERR;
+
+            uint64_t fenceAddress = bb->fence_heap_base_address + fence->offset;
+            auto *value = static_cast<uint64_t *>(translate(fenceAddress, sizeof(uint64_t)));
+            if (value == nullptr) {
+                LOG_E("Invalid fence address %#lx", fenceAddress);
+                return VPU_JSM_STATUS_PROCESSING_ERR;
+            }
+
+            if (cmd->type == VPU_CMD_FENCE_SIGNAL) {
+                __atomic_store_n(value, fence->value, __ATOMIC_RELEASE);
+                break;
+            }
+
+            while (__atomic_load_n(value, __ATOMIC_ACQUIRE) < fence->value) {
+                if (stop)
+                    return VPU_JSM_STATUS_ABORTED;
+                delay(fenceWaitPollNs);
+            }
+            break;
+        }
+        case VPU_CMD_COPY_SYSTEM_TO_SYSTEM:
+        case VPU_CMD_COPY_SYSTEM_TO_LOCAL:
+        case VPU_CMD_COPY_LOCAL_TO_SYSTEM:
+        case VPU_CMD_COPY_LOCAL_TO_LOCAL: {
+            const auto *copy = getCommand<vpu_cmd_copy_buffer_t>(cmd);
+            if (copy == nullptr)
+                return VPU_JSM_STATUS_PARSING_ERR;
+
+            uint64_t descAddress = bb->descriptor_heap_base_address + copy->desc_start_offset;
+            const auto *desc = static_cast<const vpu_cmd_copy_descriptor_mtl_t *>(
+                translate(descAddress, copy->desc_count * sizeof(vpu_cmd_copy_descriptor_mtl_t)));
+            if (desc == nullptr) {
+                LOG_E("Invalid copy descriptor address %#lx", descAddress);
+                return VPU_JSM_STATUS_PROCESSING_ERR;
+            }
+
+            for (uint32_t i = 0; i < copy->desc_count; i++) {
+                void *src = translate(desc[i].src_address, desc[i].size);
+                void *dst = translate(desc[i].dst_address, desc[i].size);
+                if (src == nullptr || dst == nullptr) {
+                    LOG_E("Invalid copy addresses (src: %#lx, dst: %#lx, size: %#x)",
+                          desc[i].src_address,
+                          desc[i].dst_address,
+                          desc[i].size);
+                    return VPU_JSM_STATUS_PROCESSING_ERR;
+                }
+                memmove(dst, src, desc[i].size);
+                if (latency.copyBytesPerSec)
+                    delay(desc[i].size * 1'000'000'000ull / latency.copyBytesPerSec);
+            }
+            break;
+        }
+        case VPU_CMD_MEMORY_FILL: {
+            const auto *fill = getCommand<vpu_cmd_memory_fill_t>(cmd);
+            if (fill == nullptr)
+                return VPU_JSM_STATUS_PARSING_ERR;
+
+            auto *dst = static_cast<uint8_t *>(translate(fill->start_address, fill->size));
+            if (dst == nullptr) {
+                LOG_E("Invalid memory fill address %#lx", fill->start_address);
+                return VPU_JSM_STATUS_PROCESSING_ERR;
+            }
+
+            // Pattern is replicated to 32 bits, the tail gets its leading bytes
+            for (uint64_t i = 0; i < fill->size; i += sizeof(fill->fill_pattern))
+                memcpy(dst + i,
+                       &fill->fill_pattern,
+                       std::min<uint64_t>(sizeof(fill->fill_pattern), fill->size - i));
+            if (latency.copyBytesPerSec)
+                delay(fill->size * 1'000'000'000ull / latency.copyBytesPerSec);
+            break;
+        }
+        default:
+            LOG_E("Command %#x is not supported by emulated device", cmd->type);
+            return VPU_JSM_STATUS_PARSING_ERR;
+        }
+
+        cmdOffset += cmd->size;
+    }
+
+    return VPU_JSM_STATUS_SUCCESS;
+}
+
+uint32_t OsInterfaceEmulator::toJobStatus(uint32_t jsmStatus) {
+    // Like KMD, firmware errors are passed to user space as device specific job status
+    return jsmStatus == VPU_JSM_STATUS_SUCCESS ? DRM_IVPU_JOB_STATUS_SUCCESS : jsmStatus;
+}
+
+} // namespace VPU
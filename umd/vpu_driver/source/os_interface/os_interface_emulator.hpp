@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/os_interface/os_interface.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct drm_ivpu_submit;
+struct drm_ivpu_bo_wait;
+
+namespace VPU {
+
+/**
+ * Software emulation of KMD and firmware, used to run the whole submission pipeline on machines
+ * without VPU.
+ *
+ * Emulated device nodes serve buffer objects backed by anonymous host memory that is placed in
+ * an emulated VPU address space. Submitted command buffers are parsed and executed on the CPU
+ * by one worker thread per engine: copy, memory fill, timestamp, fence and barrier commands
+ * are executed, inference commands only take the time given by the latency model. Files and
+ * descriptors that are not emulated are forwarded to OsInterfaceImp.
+ */
+class OsInterfaceEmulator : public OsInterface {
+  public:
+    struct LatencyModel {
+        /* Time from job submission to the start of its execution */
+        uint64_t jobNs = 0;
+        /* Time taken by every inference command */
+        uint64_t inferenceNs = 0;
+        /* Throughput of copy and fill commands, 0 means no limit */
+        uint64_t copyBytesPerSec = 0;
+    };
+
+    static constexpr uint64_t lowRangeBase = 0x80000000;
+    static constexpr uint64_t lowRangeEnd = 0x180000000;
+    static constexpr uint64_t highRangeBase = 0x200000000;
+    static constexpr uint64_t highRangeEnd = 0x4000000000;
+    static constexpr uint32_t deviceId = 0x7D1D;
+
+    OsInterfaceEmulator() = default;
+    ~OsInterfaceEmulator() override;
+
+    OsInterfaceEmulator(const OsInterfaceEmulator &) = delete;
+    OsInterfaceEmulator &operator=(const OsInterfaceEmulator &) = delete;
+    OsInterfaceEmulator(OsInterfaceEmulator &&) = delete;
+    OsInterfaceEmulator &&operator=(OsInterfaceEmulator &&) = delete;
+
+    static OsInterfaceEmulator &getInstance();
+
+    void setLatencyModel(const LatencyModel &model);
+    LatencyModel getLatencyModel() const;
+
+    /**
+     * Returns number of buffer objects that still hold emulated memory.
+     */
+    size_t getBufferCount() const;
+
+    int osiOpen(const char *pathname, int flags, mode_t mode) override;
+    int osiClose(int fildes) override;
+    int osiFcntl(int fd, int cmd) override;
+    int osiIoctl(int fd, unsigned long request, void *arg) override;
+
+    void *osiAlloc(size_t size) override;
+    int osiFree(void *ptr) override;
+    size_t osiGetSystemPageSize() override;
+
+    void *osiMmap(void *addr, size_t size, int prot, int flags, int fd, off_t offset) override;
+    int osiMunmap(void *addr, size_t size) override;
+
+    bool fileExists(std::string &p) override;
+
+  private:
+    struct BufferObject {
+        int fd;
+        void *ptr;
+        size_t size;
+        uint64_t vpuAddr;
+        uint32_t flags;
+        /* Buffer memory is released once handle is closed, unmapped and not used by any job */
+        bool handleOpen;
+        uint32_t mappings;
+        uint32_t pendingJobs;
+        /* DRM job status of the last completed job that used the buffer */
+        uint32_t jobStatus;
+    };
+
+    struct Job {
+        std::vector<uint32_t> handles;
+        uint8_t *cmdBuffer;
+        size_t cmdBufferSize;
+        int64_t startNs;
+    };
+
+    struct Engine {
+        std::deque<Job> queue;
+        std::condition_variable cv;
+        std::thread thread;
+    };
+
+    static constexpr uint32_t engineCount = 2;
+
+    bool isEmulatedFd(int fd) const;
+    int createBuffer(int fd, void *arg);
+    int closeBuffer(void *arg);
+    int getBufferInfo(void *arg);
+    int getParam(void *arg);
+    int submit(drm_ivpu_submit *arg);
+    int wait(drm_ivpu_bo_wait *arg);
+
+    uint64_t allocateVpuAddress(size_t size, uint64_t rangeBase, uint64_t rangeEnd) const;
+    /* Following helpers require the lock to be held */
+    BufferObject *getBuffer(uint32_t handle);
+    void releaseBufferIfUnused(uint32_t handle);
+
+    void *translate(uint64_t vpuAddr, size_t size);
+    void engineThread(uint32_t engine);
+    /* Executes commands of the job as firmware does, returns VPU_JSM_STATUS_* code */
+    uint32_t executeJob(const Job &job, const LatencyModel &latency);
+    /* Converts firmware status to DRM job status reported by BO_WAIT */
+    static uint32_t toJobStatus(uint32_t jsmStatus);
+    void delay(uint64_t ns) const;
+
+    mutable std::mutex mtx;
+    std::condition_variable jobDoneCv;
+    std::atomic<bool> stop = false;
+
+    LatencyModel latencyModel;
+    std::set<int> emulatedFds;
+    uint32_t nextHandle = 1;
+    uint64_t nextInferenceId = 1;
+    std::map<uint32_t, BufferObject> buffers;
+    std::map<uint64_t, uint32_t> vpuAddressMap;
+    std::map<void *, uint32_t> cpuAddressMap;
+    Engine engines[engineCount];
+};
+
+} // namespace VPU
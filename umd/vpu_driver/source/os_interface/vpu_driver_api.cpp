@@ -7,6 +7,7 @@
 
 #include "vpu_driver/source/utilities/log.hpp"
 #include "vpu_driver/source/os_interface/vpu_driver_api.hpp"
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
 
 #include <cerrno>
 #include <cstring>
@@ -45,10 +46,17 @@ int VPUDriverApi::doIoctl(unsigned long request, void *arg) const {
     }
 
     LOG_V("Start IOCTL request %#lx", request);
-    int ret;
-    do {
+    auto start = std::chrono::steady_clock::now();
+    uint32_t retries = 0;
+    int ret = osInfc.osiIoctl(vpuFd, request, arg);
+    while (ret == -1 && (errno == EAGAIN || errno == EINTR)) {
+        retries++;
         ret = osInfc.osiIoctl(vpuFd, request, arg);
-    } while (ret == -1 && (errno == -EAGAIN || errno == -EINTR));
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count();
+    VPUIoctlStats::getInstance().record(request, static_cast<uint64_t>(ns), retries, ret != 0);
 
     LOG_V("End IOCTL request %#lx: ret=%d, ERRNO=%d, STRERROR=\"%s\"",
           request,
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <drm/drm.h>
+#include <uapi/drm/ivpu_accel.h>
+
+namespace VPU {
+
+VPUIoctlStats &VPUIoctlStats::getInstance() {
+    // Never destroyed, threads may record until the very end of the process
+    static VPUIoctlStats *instance = new VPUIoctlStats;
+    return *instance;
+}
+
+size_t VPUIoctlStats::getBucket(uint64_t ns) {
+    if (ns == 0)
+        return 0;
+    return std::min<size_t>(63 - __builtin_clzll(ns), histogramBuckets - 1);
+}
+
+const char *VPUIoctlStats::getRequestName(unsigned long request) {
+    switch (request) {
+    case DRM_IOCTL_VERSION:
+        return "VERSION";
+    case DRM_IOCTL_GEM_CLOSE:
+        return "GEM_CLOSE";
+    case DRM_IOCTL_IVPU_GET_PARAM:
+        return "GET_PARAM";
+    case DRM_IOCTL_IVPU_SET_PARAM:
+        return "SET_PARAM";
+    case DRM_IOCTL_IVPU_BO_CREATE:
+        return "BO_CREATE";
+    case DRM_IOCTL_IVPU_BO_INFO:
+        return "BO_INFO";
+    case DRM_IOCTL_IVPU_SUBMIT:
+        return "SUBMIT";
+    case DRM_IOCTL_IVPU_BO_WAIT:
+        return "BO_WAIT";
+    case DRM_IOCTL_IVPU_METRIC_STREAMER_START:
+        return "METRIC_STREAMER_START";
+    case DRM_IOCTL_IVPU_METRIC_STREAMER_STOP:
+        return "METRIC_STREAMER_STOP";
+    case DRM_IOCTL_IVPU_METRIC_STREAMER_GET_DATA:
+        return "METRIC_STREAMER_GET_DATA";
+    case DRM_IOCTL_IVPU_METRIC_STREAMER_GET_INFO:
+        return "METRIC_STREAMER_GET_INFO";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+VPUIoctlStats::ShardOwner::~ShardOwner() {
+    if (shard == nullptr)
+        return;
+
+    auto &stats = VPUIoctlStats::getInstance();
+    const std::lock_guard<std::mutex> lock(stats.mtx);
+    stats.freeShards.push_back(shard);
+}
+
+VPUIoctlStats::Shard *VPUIoctlStats::getThreadShard() {
+    static thread_local ShardOwner owner;
+    if (owner.shard != nullptr)
+        return owner.shard;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    if (!freeShards.empty()) {
+        owner.shard = freeShards.back();
+        freeShards.pop_back();
+    } else {
+        owner.shard = shards.emplace_back(std::make_unique<Shard>()).get();
+    }
+    return owner.shard;
+}
+
+void VPUIoctlStats::record(unsigned long request, uint64_t ns, uint32_t retries, bool failed) {
+    Shard *shard = getThreadShard();
+
+    // Only the owning thread claims slots of its shard
+    Slot *slot = nullptr;
+    for (auto &s : shard->slots) {
+        unsigned long slotRequest = s.request.load(std::memory_order_relaxed);
+        if (slotRequest == request) {
+            slot = &s;
+            break;
+        }
+        if (slotRequest == 0) {
+            s.request.store(request, std::memory_order_relaxed);
+            slot = &s;
+            break;
+        }
+    }
+    if (slot == nullptr)
+        return;
+
+    slot->calls.fetch_add(1, std::memory_order_relaxed);
+    slot->retries.fetch_add(retries, std::memory_order_relaxed);
+    if (failed)
+        slot->failures.fetch_add(1, std::memory_order_relaxed);
+    slot->totalNs.fetch_add(ns, std::memory_order_relaxed);
+    if (ns > slot->maxNs.load(std::memory_order_relaxed))
+        slot->maxNs.store(ns, std::memory_order_relaxed);
+    slot->histogram[getBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<VPUIoctlStats::Counters> VPUIoctlStats::getCounters() const {
+    std::vector<Counters> counters;
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (const auto &shard : shards) {
+        for (const auto &slot : shard->slots) {
+            unsigned long request = slot.request.load(std::memory_order_relaxed);
+            if (request == 0)
+                break;
+
+            auto it = std::find_if(counters.begin(), counters.end(), [request](const auto &c) {
+                return c.request == request;
+            });
+            if (it == counters.end()) {
+                counters.emplace_back();
+                it = std::prev(counters.end());
+                it->request = request;
+            }
+
+            it->calls += slot.calls.load(std::memory_order_relaxed);
+            it->retries += slot.retries.load(std::memory_order_relaxed);
+            it->failures += slot.failures.load(std::memory_order_relaxed);
+            it->totalNs += slot.totalNs.load(std::memory_order_relaxed);
+            it->maxNs = std::max(it->maxNs, slot.maxNs.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < histogramBuckets; i++)
+                it->histogram[i] += slot.histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Requests without calls since the last reset are skipped
+    counters.erase(std::remove_if(counters.begin(),
+                                  counters.end(),
+                                  [](const auto &c) { return c.calls == 0; }),
+                   counters.end());
+    std::sort(counters.begin(), counters.end(), [](const auto &a, const auto &b) {
+        return a.totalNs > b.totalNs;
+    });
+    return counters;
+}
+
+std::string VPUIoctlStats::getReport() const {
+    std::string report = "VPU ioctl statistics (times in us):\n";
+    char line[256];
+
+    snprintf(line,
+             sizeof(line),
+             "%-26s %10s %8s %8s %12s %10s %10s\n",
+             "request",
+             "calls",
+             "retries",
+             "failures",
+             "total",
+             "avg",
+             "max");
+    report += line;
+
+    for (const auto &c : getCounters()) {
+        snprintf(line,
+                 sizeof(line),
+                 "%-26s %10" PRIu64 " %8" PRIu64 " %8" PRIu64 " %12.1f %10.2f %10.1f\n",
+                 getRequestName(c.request),
+                 c.calls,
+                 c.retries,
+                 c.failures,
+                 static_cast<double>(c.totalNs) / 1000,
+                 c.calls ? static_cast<double>(c.totalNs) / 1000 / static_cast<double>(c.calls)
+                         : 0.0,
+                 static_cast<double>(c.maxNs) / 1000);
+        report += line;
+
+        report += "    latency histogram [ns >= 2^n]:";
+        for (size_t i = 0; i < histogramBuckets; i++) {
+            if (c.histogram[i] == 0)
+                continue;
+            snprintf(line, sizeof(line), " %zu:%" PRIu64, i, c.histogram[i]);
+            report += line;
+        }
+        report += "\n";
+    }
+
+    return report;
+}
+
+void VPUIoctlStats::reset() {
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (auto &shard : shards) {
+        for (auto &slot : shard->slots) {
+            slot.calls.store(0, std::memory_order_relaxed);
+            slot.retries.store(0, std::memory_order_relaxed);
+            slot.failures.store(0, std::memory_order_relaxed);
+            slot.totalNs.store(0, std::memory_order_relaxed);
+            slot.maxNs.store(0, std::memory_order_relaxed);
+            for (auto &bucket : slot.histogram)
+                bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void VPUIoctlStats::enableDumpAtExit() {
+    std::call_once(dumpAtExitOnce, [] {
+        std::atexit([] { fputs(VPUIoctlStats::getInstance().getReport().c_str(), stderr); });
+    });
+}
+
+} // namespace VPU
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VPU {
+
+/**
+ * Process wide statistics of ioctl requests sent to KMD.
+ *
+ * Every request code gets call, retry and failure counters and a latency histogram with power
+ * of two buckets. Each thread records into its own shard, so recording does not contend on
+ * shared cache lines. Shards of exited threads are reused by new threads and the counters are
+ * summed when read.
+ */
+class VPUIoctlStats {
+  public:
+    /* Bucket i counts latencies in range [2^i, 2^(i+1)) nanoseconds, the last one all above */
+    static constexpr size_t histogramBuckets = 40;
+
+    struct Counters {
+        unsigned long request = 0;
+        uint64_t calls = 0;
+        uint64_t retries = 0;
+        uint64_t failures = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        std::array<uint64_t, histogramBuckets> histogram = {};
+    };
+
+    VPUIoctlStats(const VPUIoctlStats &) = delete;
+    VPUIoctlStats &operator=(const VPUIoctlStats &) = delete;
+
+    static VPUIoctlStats &getInstance();
+    static size_t getBucket(uint64_t ns);
+    static const char *getRequestName(unsigned long request);
+
+    /**
+     * Record one ioctl call.
+     * @param request ioctl request code
+     * @param ns time spent in the call including retries
+     * @param retries number of repeated calls after EINTR or EAGAIN
+     * @param failed true if the call returned an error
+     */
+    void record(unsigned long request, uint64_t ns, uint32_t retries, bool failed);
+
+    /**
+     * Returns counters summed over all threads, one entry per request code that was recorded.
+     */
+    std::vector<Counters> getCounters() const;
+    std::string getReport() const;
+    void reset();
+
+    /**
+     * Print the report to stderr when the process exits.
+     */
+    void enableDumpAtExit();
+
+  private:
+    static constexpr size_t maxRequests = 32;
+
+    struct Slot {
+        std::atomic<unsigned long> request = 0;
+        std::atomic<uint64_t> calls = 0;
+        std::atomic<uint64_t> retries = 0;
+        std::atomic<uint64_t> failures = 0;
+        std::atomic<uint64_t> totalNs = 0;
+        std::atomic<uint64_t> maxNs = 0;
+        std::array<std::atomic<uint64_t>, histogramBuckets> histogram = {};
+    };
+
+    struct Shard {
+        std::array<Slot, maxRequests> slots;
+    };
+
+    /* Returns shard of the calling thread back to the pool when the thread exits */
+    struct ShardOwner {
+        Shard *shard = nullptr;
+        ~ShardOwner();
+    };
+
+    VPUIoctlStats() = default;
+
+    Shard *getThreadShard();
+
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<Shard *> freeShards;
+    std::once_flag dumpAtExitOnce;
+};
+
+} // namespace VPU
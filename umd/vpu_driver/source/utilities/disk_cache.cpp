@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/disk_cache.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace VPU {
+
+namespace fs = std::filesystem;
+
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+    /* Entry file can be renamed or copied, the key it was stored under is verified on load */
+    VPUSha256::Digest keyDigest;
+    VPUSha256::Digest dataDigest;
+};
+
+static constexpr uint32_t entryMagic = 0x43555056; // "VPUC"
+static constexpr uint32_t entryVersion = 2;
+static constexpr const char *entryExtension = ".blob";
+/* Writer keeps its temporary file fresh while it writes, older ones were left by a crash */
+static constexpr auto staleTmpFileAge = std::chrono::minutes(10);
+
+static bool isTmpFile(const fs::path &path) {
+    std::string name = path.filename().string();
+    return !name.empty() && name[0] == '.';
+}
+
+VPUDiskCache::Key &VPUDiskCache::Key::add(const void *data, size_t size) {
+    uint64_t size64 = size;
+    sha.update(&size64, sizeof(size64));
+    sha.update(data, size);
+    return *this;
+}
+
+VPUDiskCache::VPUDiskCache(std::string directory, size_t maxBytes)
+    : directory(std::move(directory))
+    , maxBytes(maxBytes) {}
+
+std::string VPUDiskCache::getPath(const std::string &key) const {
+    return directory + "/" + key + entryExtension;
+}
+
+bool VPUDiskCache::load(const std::string &key, std::vector<uint8_t> &data) {
+    std::string path = getPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    EntryHeader header = {};
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        header.magic != entryMagic || header.version != entryVersion ||
+        header.keyDigest != VPUSha256::hash(key.data(), key.size())) {
+        LOG_W("Invalid cache entry %s", path.c_str());
+        return false;
+    }
+
+    // Size is checked against the file before anything is allocated for the content
+    std::error_code ec;
+    uintmax_t fileSize = fs::file_size(path, ec);
+    if (ec || fileSize < sizeof(header) || fileSize - sizeof(header) != header.size) {
+        LOG_W("Truncated cache entry %s", path.c_str());
+        return false;
+    }
+
+    data.resize(header.size);
+    auto size = static_cast<std::streamsize>(data.size());
+    if (!file.read(reinterpret_cast<char *>(data.data()), size) ||
+        VPUSha256::hash(data.data(), data.size()) != header.dataDigest) {
+        LOG_W("Corrupted cache entry %s", path.c_str());
+        data.clear();
+        return false;
+    }
+
+    // Entry modification time is its last use time
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    LOG_I("Loaded %lu bytes from cache entry %s", data.size(), path.c_str());
+    return true;
+}
+
+bool VPUDiskCache::store(const std::string &key, const std::vector<uint8_t> &data) {
+    if (data.size() + sizeof(EntryHeader) > maxBytes) {
+        LOG_W("Blob of %lu bytes does not fit in the cache limit %lu", data.size(), maxBytes);
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec) {
+        LOG_W("Failed to create cache directory %s, error: %s",
+              directory.c_str(),
+              ec.message().c_str());
+        return false;
+    }
+
+    // Entry is written to unique temporary file first and renamed when complete
+    std::string tmpPath = directory + "/." + key + ".XXXXXX";
+    int fd = mkstemp(tmpPath.data());
+    if (fd < 0) {
+        LOG_W("Failed to create temporary cache file in %s", directory.c_str());
+        return false;
+    }
+
+    EntryHeader header = {entryMagic,
+                          entryVersion,
+                          data.size(),
+                          VPUSha256::hash(key.data(), key.size()),
+                          VPUSha256::hash(data.data(), data.size())};
+    bool written = write(fd, &header, sizeof(header)) == sizeof(header) &&
+                   write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    written = fsync(fd) == 0 && written;
+    close(fd);
+
+    if (!written || rename(tmpPath.c_str(), getPath(key).c_str()) != 0) {
+        LOG_W("Failed to store cache entry %s", getPath(key).c_str());
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    LOG_I("Stored %lu bytes in cache entry %s", data.size(), getPath(key).c_str());
+    trim(maxBytes);
+    return true;
+}
+
+size_t VPUDiskCache::trim(size_t targetBytes) {
+    const std::lock_guard<std::mutex> lock(mtx);
+
+    struct Entry {
+        fs::path path;
+        size_t size;
+        fs::file_time_type lastUse;
+    };
+    std::vector<Entry> entries;
+    size_t cachedBytes = 0;
+
+    auto staleTime = fs::file_time_type::clock::now() - staleTmpFileAge;
+    std::error_code ec;
+    for (const auto &it : fs::directory_iterator(directory, ec)) {
+        if (!it.is_regular_file(ec))
+            continue;
+
+        auto lastUse = it.last_write_time(ec);
+        if (ec)
+            continue;
+
+        if (isTmpFile(it.path())) {
+            if (lastUse < staleTime && fs::remove(it.path(), ec))
+                LOG_V("Removed stale temporary cache file %s", it.path().c_str());
+            continue;
+        }
+
+        if (it.path().extension() != entryExtension)
+            continue;
+
+        size_t size = it.file_size(ec);
+        if (ec)
+            continue;
+
+        cachedBytes += size;
+        entries.push_back({it.path(), size, lastUse});
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.lastUse < b.lastUse;
+    });
+
+    size_t removedBytes = 0;
+    for (const auto &entry : entries) {
+        if (cachedBytes - removedBytes <= targetBytes)
+            break;
+
+        // Entry might be already removed by other process
+        if (fs::remove(entry.path, ec) || !ec) {
+            LOG_V("Removed cache entry %s", entry.path.c_str());
+            removedBytes += entry.size;
+        }
+    }
+    return removedBytes;
+}
+
+size_t VPUDiskCache::getCachedBytes() const {
+    size_t cachedBytes = 0;
+    std::error_code ec;
+    for (const auto &it : fs::directory_iterator(directory, ec)) {
+        if (!it.is_regular_file(ec) || it.path().extension() != entryExtension)
+            continue;
+
+        size_t size = it.file_size(ec);
+        if (!ec)
+            cachedBytes += size;
+    }
+    return cachedBytes;
+}
+
+} // namespace VPU
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/utilities/sha256.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VPU {
+
+/**
+   Content addressed cache of binary blobs stored in a directory. Entries are published by
+   atomic rename, so concurrent writers from different processes never expose a partial file.
+   Every entry records digests of its key and content, an entry is loaded only when both match.
+   Directory is kept below the size limit by removing least recently used entries, the use time
+   is the modification time of the entry that is refreshed on each hit.
+ */
+class VPUDiskCache {
+  public:
+    /**
+       Builds cache key as SHA-256 of a sequence of byte ranges. Every part is prefixed by its
+       size, so different splits of the same bytes produce different keys.
+     */
+    class Key {
+      public:
+        Key &add(const void *data, size_t size);
+        Key &add(std::string_view str) { return add(str.data(), str.size()); }
+        Key &add(uint64_t value) { return add(&value, sizeof(value)); }
+
+        std::string str() const { return VPUSha256::toHex(sha.digest()); }
+
+      private:
+        VPUSha256 sha;
+    };
+
+    VPUDiskCache(std::string directory, size_t maxBytes);
+
+    VPUDiskCache(const VPUDiskCache &) = delete;
+    VPUDiskCache &operator=(const VPUDiskCache &) = delete;
+
+    /**
+       Load entry stored under the key and mark it as recently used.
+       @return false if entry does not exist, is corrupted or was stored under other key.
+     */
+    bool load(const std::string &key, std::vector<uint8_t> &data);
+
+    /**
+       Store entry under the key and remove least recently used entries above the size limit.
+     */
+    bool store(const std::string &key, const std::vector<uint8_t> &data);
+
+    /**
+       Remove least recently used entries until the cache is not bigger than targetBytes.
+       Temporary files of writers that did not finish within a few minutes are removed too.
+       @return number of removed entry bytes.
+     */
+    size_t trim(size_t targetBytes);
+
+    size_t getCachedBytes() const;
+    const std::string &getDirectory() const { return directory; }
+
+  private:
+    std::string getPath(const std::string &key) const;
+
+    std::string directory;
+    size_t maxBytes;
+    std::mutex mtx;
+};
+
+} // namespace VPU
@@ -7,9 +7,13 @@
 
 #include "vpu_driver/source/utilities/log.hpp"
 
+#include <algorithm>
+
 namespace VPU {
 
 static LogLevel curLogLevel = UMD_LOGLEVEL;
+static LogLevel curTraceLevel = QUIET;
+LogLevel logThreshold = UMD_LOGLEVEL;
 
 static inline const char *getBaseName(const char *filePath) {
     const char *lastDirPos = __builtin_strrchr(filePath, '/');
@@ -17,6 +21,58 @@ static inline const char *getBaseName(const char *filePath) {
     return fn;
 }
 
+static void updateLogThreshold() {
+    logThreshold = std::max(curLogLevel, curTraceLevel);
+}
+
+static bool parseLogLevel(std::string_view str, LogLevel &level) {
+    if (str == "QUIET") {
+        level = QUIET;
+    } else if (str == "ERROR") {
+        level = ERROR;
+    } else if (str == "WARNING") {
+        level = WARNING;
+    } else if (str == "INFO") {
+        level = INFO;
+    } else if (str == "VERBOSE") {
+        level = VERBOSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char *getLogLevelPrefix(LogLevel level) {
+    switch (level) {
+    case VERBOSE:
+        return "V";
+    case ERROR:
+        return "E";
+    case WARNING:
+        return "W";
+    case INFO:
+        return "I";
+    default:
+        return "?";
+    }
+}
+
+static void vprintLog(LogLevel debugLevel,
+                      const char *file,
+                      const char *function,
+                      const int line,
+                      const char *format,
+                      va_list args) {
+    fprintf(stderr,
+            "VPU_LOG:[%s] %s::%s():%d: ",
+            getLogLevelPrefix(debugLevel),
+            getBaseName(file),
+            function,
+            line);
+    vfprintf(stderr, format, args);
+    fprintf(stderr, "\n");
+}
+
 void printLog(LogLevel debugLevel,
               const char *file,
               const char *function,
@@ -24,33 +80,25 @@ void printLog(LogLevel debugLevel,
               const char *format,
               ...) {
     if (debugLevel <= getLogLevel()) {
-        const char *prefix;
-        switch (debugLevel) {
-        case VERBOSE:
-            prefix = "V";
-            break;
-        case ERROR:
-            prefix = "E";
-            break;
-        case WARNING:
-            prefix = "W";
-            break;
-        case INFO:
-            prefix = "I";
-            break;
-        default:
-            prefix = "?";
-            break;
-        }
-        fprintf(stderr, "VPU_LOG:[%s] %s::%s():%d: ", prefix, getBaseName(file), function, line);
         va_list args;
         va_start(args, format);
-        vfprintf(stderr, format, args);
+        vprintLog(debugLevel, file, function, line, format, args);
         va_end(args);
-        fprintf(stderr, "\n");
     }
 }
 
+void printLogCallsite(const LogCallsite *callsite, ...) {
+    va_list args;
+    va_start(args, callsite);
+    vprintLog(callsite->level,
+              callsite->file,
+              callsite->function,
+              callsite->line,
+              callsite->format,
+              args);
+    va_end(args);
+}
+
 LogLevel getLogLevel() {
     return curLogLevel;
 }
@@ -58,23 +106,35 @@ LogLevel getLogLevel() {
 void setLogLevel(LogLevel level) {
     if (level <= VERBOSE && level >= QUIET) {
         curLogLevel = level;
+        updateLogThreshold();
         return;
     }
     LOG_W("Invalid log level(%d) keeping current level(%d)\n", level, curLogLevel);
 }
 
 void setLogLevel(std::string_view &str) {
-    if (str == "QUIET") {
-        setLogLevel(QUIET);
-    } else if (str == "ERROR") {
-        setLogLevel(ERROR);
-    } else if (str == "WARNING") {
-        setLogLevel(WARNING);
-    } else if (str == "INFO") {
-        setLogLevel(INFO);
-    } else if (str == "VERBOSE") {
-        setLogLevel(VERBOSE);
+    LogLevel level;
+    if (parseLogLevel(str, level))
+        setLogLevel(level);
+}
+
+LogLevel getTraceLevel() {
+    return curTraceLevel;
+}
+
+void setTraceLevel(LogLevel level) {
+    if (level <= VERBOSE && level >= QUIET) {
+        curTraceLevel = level;
+        updateLogThreshold();
+        return;
     }
+    LOG_W("Invalid trace level(%d) keeping current level(%d)\n", level, curTraceLevel);
+}
+
+void setTraceLevel(std::string_view &str) {
+    LogLevel level;
+    if (parseLogLevel(str, level))
+        setTraceLevel(level);
 }
 
 } // namespace VPU
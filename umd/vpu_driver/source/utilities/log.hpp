@@ -9,7 +9,10 @@
 
 #include <cstdio>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <type_traits>
 
 enum LogLevel { QUIET = 0, ERROR, WARNING, INFO, VERBOSE };
 
@@ -19,6 +22,25 @@ namespace VPU {
 #define UMD_LOGLEVEL QUIET
 #endif
 
+/* Static description of one LOG_* call, its address identifies the callsite in trace records */
+struct LogCallsite {
+    LogLevel level;
+    const char *file;
+    const char *function;
+    int line;
+    const char *format;
+};
+
+/* Log argument captured by value, strings are copied when the record is written */
+struct TraceArg {
+    uint64_t value;
+    const char *str;
+    bool isString;
+};
+
+/* Highest of print and trace levels, the only value checked by LOG_* on the fast path */
+extern LogLevel logThreshold;
+
 void printLog(LogLevel debugLevel,
               const char *file,
               const char *function,
@@ -26,14 +48,77 @@ void printLog(LogLevel debugLevel,
               const char *format,
               ...) __attribute__((format(printf, 5, 6)));
 
+void printLogCallsite(const LogCallsite *callsite, ...);
+const char *getLogLevelPrefix(LogLevel level);
+void traceLog(const LogCallsite &callsite, const TraceArg *args, size_t count);
+
 void setLogLevel(LogLevel level);
 void setLogLevel(std::string_view &str);
 
 LogLevel getLogLevel();
 
+/**
+ * Messages up to the trace level are stored in the trace buffer instead of being formatted.
+ * QUIET disables tracing.
+ */
+void setTraceLevel(LogLevel level);
+void setTraceLevel(std::string_view &str);
+
+LogLevel getTraceLevel();
+
+template <typename T>
+inline TraceArg toTraceArg(T arg) {
+    if constexpr (std::is_same_v<T, const char *> || std::is_same_v<T, char *>) {
+        return {0, arg, true};
+    } else if constexpr (std::is_pointer_v<T>) {
+        return {reinterpret_cast<uintptr_t>(arg), nullptr, false};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        double d = static_cast<double>(arg);
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        return {bits, nullptr, false};
+    } else if constexpr (std::is_enum_v<T>) {
+        return {static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(arg)),
+                nullptr,
+                false};
+    } else {
+        return {static_cast<uint64_t>(arg), nullptr, false};
+    }
+}
+
+template <typename... Args>
+void logMessage(const LogCallsite &callsite, const char *format, Args... args) {
+    if (callsite.level <= getTraceLevel()) {
+        const TraceArg traceArgs[] = {toTraceArg(args)..., {0, nullptr, false}};
+        traceLog(callsite, traceArgs, sizeof...(args));
+    }
+    if (callsite.level <= getLogLevel())
+        printLogCallsite(&callsite, args...);
+}
+
+/* Never called, lets the compiler verify arguments against the format */
+inline void checkLogFormat(const char *format, ...) __attribute__((format(printf, 1, 2)));
+inline void checkLogFormat(const char *format, ...) {}
+
 } // namespace VPU
 
-#define LOG(LEVEL, ...) VPU::printLog(LEVEL, __FILE__, __func__, __LINE__, __VA_ARGS__)
+/* Expands to the format, the first argument of LOG_* */
+#define LOG_FORMAT(FORMAT, ...) FORMAT
+
+/*
+ * Disabled levels cost one compare with a global. Format and source location are kept in a
+ * static callsite, so the enabled path does not format anything unless the message is printed.
+ */
+#define LOG(LEVEL, ...)                                                                        \
+    do {                                                                                       \
+        if (__builtin_expect((LEVEL) <= VPU::logThreshold, 0)) {                               \
+            static const VPU::LogCallsite logCallsite =                                        \
+                {LEVEL, __FILE__, __func__, __LINE__, LOG_FORMAT(__VA_ARGS__, "")};            \
+            VPU::logMessage(logCallsite, __VA_ARGS__);                                         \
+        }                                                                                      \
+        if (false)                                                                             \
+            VPU::checkLogFormat(__VA_ARGS__);                                                  \
+    } while (0)
 
 #define LOG_V(...) LOG(VERBOSE, __VA_ARGS__)
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/mapped_file.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace VPU {
+
+VPUMappedFile::VPUMappedFile(void *ptr, size_t length)
+    : ptr(ptr)
+    , length(length) {}
+
+VPUMappedFile::~VPUMappedFile() {
+    if (munmap(ptr, length) != 0)
+        LOG_W("Failed to unmap file mapping %p, errno: %d", ptr, errno);
+}
+
+std::unique_ptr<VPUMappedFile> VPUMappedFile::open(const char *path) {
+    if (path == nullptr) {
+        LOG_E("File path is nullptr");
+        return nullptr;
+    }
+
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_E("Failed to open file %s, errno: %d", path, errno);
+        return nullptr;
+    }
+
+    auto file = map(fd);
+    close(fd);
+    return file;
+}
+
+std::unique_ptr<VPUMappedFile> VPUMappedFile::map(int fd) {
+    struct stat st = {};
+    if (fstat(fd, &st) != 0) {
+        LOG_E("Failed to get status of file descriptor %d, errno: %d", fd, errno);
+        return nullptr;
+    }
+
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+        LOG_E("File descriptor %d is not a non empty regular file", fd);
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(st.st_size);
+    void *ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+        LOG_E("Failed to map file descriptor %d, errno: %d", fd, errno);
+        return nullptr;
+    }
+
+    // File is parsed and copied to buffers from the beginning to the end
+    madvise(ptr, length, MADV_SEQUENTIAL);
+
+    LOG_V("Mapped %lu bytes of file descriptor %d at %p", length, fd, ptr);
+    return std::unique_ptr<VPUMappedFile>(new VPUMappedFile(ptr, length));
+}
+
+} // namespace VPU
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace VPU {
+
+/**
+   Read-only private mapping of a whole file. Pages are read on first access and can be dropped
+   by the kernel under memory pressure, so the file content is not duplicated in process memory.
+ */
+class VPUMappedFile {
+  public:
+    ~VPUMappedFile();
+
+    VPUMappedFile(const VPUMappedFile &) = delete;
+    VPUMappedFile &operator=(const VPUMappedFile &) = delete;
+
+    /**
+       Map file of given path.
+       @return mapping or nullptr on failure.
+     */
+    static std::unique_ptr<VPUMappedFile> open(const char *path);
+
+    /**
+       Map file of given descriptor. Descriptor is not owned and can be closed by the caller.
+       @return mapping or nullptr on failure.
+     */
+    static std::unique_ptr<VPUMappedFile> map(int fd);
+
+    const uint8_t *data() const { return static_cast<const uint8_t *>(ptr); }
+    size_t size() const { return length; }
+
+  private:
+    VPUMappedFile(void *ptr, size_t length);
+
+    void *ptr;
+    size_t length;
+};
+
+} // namespace VPU
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace VPU {
+
+/**
+   Incremental SHA-256 (FIPS 180-4). Used where content is identified by its digest, so
+   different content must not be mistaken for each other.
+ */
+class VPUSha256 {
+  public:
+    static constexpr size_t digestSize = 32;
+    using Digest = std::array<uint8_t, digestSize>;
+
+    VPUSha256 &update(const void *data, size_t size);
+
+    /**
+       Digest of all bytes passed so far, more bytes can be added afterwards.
+     */
+    Digest digest() const;
+
+    static Digest hash(const void *data, size_t size) {
+        return VPUSha256().update(data, size).digest();
+    }
+    static std::string toHex(const Digest &digest);
+
+  private:
+    void transform(const uint8_t *chunk);
+
+    uint32_t state[8] = {0x6a09e667,
+                         0xbb67ae85,
+                         0x3c6ef372,
+                         0xa54ff53a,
+                         0x510e527f,
+                         0x9b05688c,
+                         0x1f83d9ab,
+                         0x5be0cd19};
+    uint8_t block[64] = {};
+    size_t blockSize = 0;
+    uint64_t totalSize = 0;
+};
+
+} // namespace VPU
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/thread_pool.hpp"
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <algorithm>
+
+namespace VPU {
+
+VPUThreadPool::VPUThreadPool(size_t maxThreads)
+    : maxThreads(std::max<size_t>(maxThreads, 1)) {}
+
+VPUThreadPool::~VPUThreadPool() {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        stop = true;
+    }
+    cv.notify_all();
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+void VPUThreadPool::enqueue(std::function<void()> task) {
+    {
+        const std::lock_guard<std::mutex> lock(mtx);
+        tasks.push_back(std::move(task));
+        if (idleThreads < tasks.size() && threads.size() < maxThreads) {
+            LOG_V("Starting worker thread %lu", threads.size());
+            threads.emplace_back(&VPUThreadPool::worker, this);
+        }
+    }
+    cv.notify_one();
+}
+
+size_t VPUThreadPool::getThreadCount() const {
+    const std::lock_guard<std::mutex> lock(mtx);
+    return threads.size();
+}
+
+void VPUThreadPool::worker() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        idleThreads++;
+        cv.wait(lock, [this] { return stop || !tasks.empty(); });
+        idleThreads--;
+
+        if (tasks.empty())
+            break;
+
+        auto task = std::move(tasks.front());
+        tasks.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+} // namespace VPU
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VPU {
+
+/**
+   Pool of worker threads executing submitted tasks in submission order. Worker is started when
+   a task is queued and no worker is idle, up to the thread limit. Destructor completes queued
+   tasks before it joins the workers.
+ */
+class VPUThreadPool {
+  public:
+    explicit VPUThreadPool(size_t maxThreads = std::thread::hardware_concurrency());
+    ~VPUThreadPool();
+
+    VPUThreadPool(const VPUThreadPool &) = delete;
+    VPUThreadPool &operator=(const VPUThreadPool &) = delete;
+
+    /**
+       Queue task for execution.
+       @return future of the task result.
+     */
+    template <class F>
+    auto submit(F &&task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged] { (*packaged)(); });
+        return future;
+    }
+
+    size_t getThreadCount() const;
+
+  private:
+    void enqueue(std::function<void()> task);
+    void worker();
+
+    const size_t maxThreads;
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    size_t idleThreads = 0;
+    bool stop = false;
+};
+
+} // namespace VPU
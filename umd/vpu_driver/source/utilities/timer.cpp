@@ -13,88 +13,198 @@
 #include "vpu_driver/source/command/vpu_job.hpp"
 #include "vpu_driver/source/command/vpu_event_command.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <limits>
 #include <chrono>
 #include <thread>
+#include <time.h>
 #include <vector>
 #include <uapi/drm/ivpu_accel.h>
 
 namespace VPU {
 
+static WaitPolicy defaultWaitPolicy;
+
+const WaitPolicy &getDefaultWaitPolicy() {
+    return defaultWaitPolicy;
+}
+
+void setDefaultWaitPolicy(const WaitPolicy &policy) {
+    defaultWaitPolicy = policy;
+}
+
+void WaitStatistics::record(uint64_t cpuTime, uint64_t wallTime) {
+    waitCount++;
+    cpuTimeNs += cpuTime;
+    wallTimeNs += wallTime;
+}
+
+void WaitStatistics::reset() {
+    waitCount = 0;
+    cpuTimeNs = 0;
+    wallTimeNs = 0;
+}
+
+static uint64_t getThreadCpuTimeNanoseconds() {
+    struct timespec ts = {};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return boost::numeric_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ull +
+           boost::numeric_cast<uint64_t>(ts.tv_nsec);
+}
+
+int64_t getAbsoluteTimeoutNanoseconds(int64_t timeout) {
+    std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
+
+    int64_t timeout_abs_ns = std::chrono::nanoseconds::max().count();
+
+    if (!(timeout >= std::chrono::nanoseconds::max().count())) {
+        if (!(timeout + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            startTimePoint.time_since_epoch())
+                            .count() >=
+              std::chrono::nanoseconds::max().count())) {
+            timeout_abs_ns =
+                (startTimePoint + std::chrono::nanoseconds(timeout)).time_since_epoch().count();
+        }
+    }
+
+    return timeout_abs_ns;
+}
+
 template <typename F>
-static bool timeBoundSignalCheck(uint64_t timeout, F checkSignalFunc) {
+static bool timeBoundSignalCheck(uint64_t timeout,
+                                 F checkSignalFunc,
+                                 const WaitPolicy &policy,
+                                 WaitStatistics *stats,
+                                 const std::function<bool(int64_t)> &blockFunc) {
     LOG_V("Start signal observing checker for %ld nanoseconds.", timeout);
 
     bool enableTimeout = (timeout == std::numeric_limits<uint64_t>::max()) ? false : true;
     std::chrono::steady_clock::time_point timeStart, timeNow;
     auto chronoTimeout = std::chrono::nanoseconds(timeout);
     auto timeDiff = std::chrono::nanoseconds(0);
+    auto spinTime = std::chrono::nanoseconds(policy.spinTimeNs);
+    auto sleepTime = std::chrono::nanoseconds(std::max(policy.minSleepNs, 1ul));
+    auto maxSleepTime = std::chrono::nanoseconds(std::max(policy.maxSleepNs, policy.minSleepNs));
+    bool blockOnJob = policy.blockOnJob && blockFunc;
+    bool signaled = false;
 
     // Protection against overflow, nanoseconds is int64_t.
     if (timeout > boost::numeric_cast<uint64_t>(std::chrono::nanoseconds::max().count())) {
         chronoTimeout = std::chrono::nanoseconds::max();
     }
 
+    uint64_t cpuTimeStart = getThreadCpuTimeNanoseconds();
     timeStart = std::chrono::steady_clock::now();
     while (timeDiff <= chronoTimeout) {
         if (checkSignalFunc()) {
             LOG_V("Response address has been signaled.");
-            return true;
+            signaled = true;
+            break;
         }
 
-        std::this_thread::yield();
+        timeNow = std::chrono::steady_clock::now();
+        timeDiff = std::chrono::duration_cast<std::chrono::nanoseconds>(timeNow - timeStart);
+
+        if (timeDiff < spinTime) {
+            std::this_thread::yield();
+        } else {
+            if (blockOnJob) {
+                auto remaining = enableTimeout ? (chronoTimeout - timeDiff).count()
+                                               : std::chrono::nanoseconds::max().count();
+                // Fall back to sleeping once the block function returns without blocking
+                blockOnJob = blockFunc(getAbsoluteTimeoutNanoseconds(std::max(remaining, 0l)));
+            }
+
+            if (!blockOnJob) {
+                auto sleepFor = sleepTime;
+                if (enableTimeout)
+                    sleepFor = std::min(sleepFor, chronoTimeout - timeDiff);
+                std::this_thread::sleep_for(std::max(sleepFor, std::chrono::nanoseconds(0)));
+                sleepTime = std::min(sleepTime * 2, maxSleepTime);
+            }
+        }
 
         if (enableTimeout) {
             timeNow = std::chrono::steady_clock::now();
             timeDiff = std::chrono::duration_cast<std::chrono::nanoseconds>(timeNow - timeStart);
+        } else {
+            timeDiff = std::chrono::nanoseconds(0);
         }
     }
 
-    LOG_W("Response address has not been signalled until the timeout %ld", timeout);
-    return false;
+    uint64_t cpuTime = getThreadCpuTimeNanoseconds() - cpuTimeStart;
+    uint64_t wallTime = boost::numeric_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                             timeStart)
+            .count());
+    if (stats)
+        stats->record(cpuTime, wallTime);
+    LOG_V("Wait took %lu ns of CPU time and %lu ns of wall time", cpuTime, wallTime);
+
+    if (!signaled)
+        LOG_W("Response address has not been signalled until the timeout %ld", timeout);
+    return signaled;
 }
 
-bool waitForSignal(uint64_t timeout, std::function<bool()> check) {
-    return timeBoundSignalCheck(timeout, check);
-}
-
-static int64_t getAbsoluteTimeoutNanoseconds(int64_t timeout) {
-    std::chrono::steady_clock::time_point startTimePoint = std::chrono::steady_clock::now();
-
-    int64_t timeout_abs_ns = std::chrono::nanoseconds::max().count();
-
-    if (!(timeout >= std::chrono::nanoseconds::max().count())) {
-        if (!(timeout + std::chrono::duration_cast<std::chrono::nanoseconds>(
-                            startTimePoint.time_since_epoch())
-                            .count() >=
-              std::chrono::nanoseconds::max().count())) {
-            timeout_abs_ns =
-                (startTimePoint + std::chrono::nanoseconds(timeout)).time_since_epoch().count();
-        }
-    }
-
-    return timeout_abs_ns;
+bool waitForSignal(uint64_t timeout,
+                   std::function<bool()> check,
+                   const WaitPolicy &policy,
+                   WaitStatistics *stats,
+                   std::function<bool(int64_t)> block) {
+    return timeBoundSignalCheck(timeout, check, policy, stats, block);
 }
 
 bool waitForSignal(uint64_t timeout,
                    const std::vector<std::shared_ptr<VPUJob>> &jobs,
-                   VPUHwInfo devInfo) {
+                   VPUHwInfo devInfo,
+                   const WaitPolicy &policy,
+                   WaitStatistics *stats) {
     if (devInfo.deviceId == mtlHwInfo.deviceId && devInfo.platformType != 0) {
-        return timeBoundSignalCheck(timeout, [&jobs]() {
-            for (auto const &job : jobs)
-                if (!job->waitForCompletion(0))
-                    return false;
-            return true;
-        });
+        return timeBoundSignalCheck(
+            timeout,
+            [&jobs]() {
+                for (auto const &job : jobs)
+                    if (!job->waitForCompletion(0))
+                        return false;
+                return true;
+            },
+            policy,
+            stats,
+            [&jobs](int64_t timeout_abs_ns) {
+                // Completed jobs return immediately, report blocking only if a job was busy
+                bool blocked = false;
+                for (auto const &job : jobs) {
+                    if (job->waitForCompletion(0))
+                        continue;
+                    if (!job->waitForCompletion(timeout_abs_ns))
+                        return false;
+                    blocked = true;
+                }
+                return blocked;
+            });
     }
 
+    uint64_t cpuTimeStart = getThreadCpuTimeNanoseconds();
+    auto timeStart = std::chrono::steady_clock::now();
     int64_t t = getAbsoluteTimeoutNanoseconds(timeout > INT64_MAX ? INT64_MAX : timeout);
-    for (auto const &job : jobs)
-        if (!job->waitForCompletion(t))
-            return false;
-    return true;
+    bool signaled = true;
+    for (auto const &job : jobs) {
+        if (!job->waitForCompletion(t)) {
+            signaled = false;
+            break;
+        }
+    }
+
+    if (stats) {
+        auto wallTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - timeStart);
+        stats->record(getThreadCpuTimeNanoseconds() - cpuTimeStart,
+                      boost::numeric_cast<uint64_t>(wallTime.count()));
+    }
+    return signaled;
 }
 
 } // namespace VPU
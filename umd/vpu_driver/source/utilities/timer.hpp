@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <memory>
 #include <uapi/drm/ivpu_accel.h>
@@ -18,25 +20,80 @@
 
 namespace VPU {
 
+/**
+ * @brief Policy of waiting for a signal. The waiter polls the signal for spinTimeNs, then sleeps
+ * with exponential backoff from minSleepNs to maxSleepNs. If blockOnJob is set and the waiter
+ * knows the job that delivers the signal, it blocks in KMD on the job instead of sleeping.
+ */
+struct WaitPolicy {
+    uint64_t spinTimeNs = 20'000;
+    uint64_t minSleepNs = 1'000;
+    uint64_t maxSleepNs = 1'000'000;
+    bool blockOnJob = true;
+};
+
+/**
+ * @brief Policy used by waiters that do not set own policy
+ */
+const WaitPolicy &getDefaultWaitPolicy();
+void setDefaultWaitPolicy(const WaitPolicy &policy);
+
+/**
+ * @brief Accumulated statistics of waits, safe to be updated from multiple threads
+ */
+class WaitStatistics {
+  public:
+    void record(uint64_t cpuTimeNs, uint64_t wallTimeNs);
+    void reset();
+
+    uint64_t getWaitCount() const { return waitCount; }
+    uint64_t getCpuTimeNs() const { return cpuTimeNs; }
+    uint64_t getWallTimeNs() const { return wallTimeNs; }
+    uint64_t getCpuTimePerWaitNs() const { return waitCount ? cpuTimeNs / waitCount : 0; }
+
+  private:
+    std::atomic<uint64_t> waitCount = 0;
+    std::atomic<uint64_t> cpuTimeNs = 0;
+    std::atomic<uint64_t> wallTimeNs = 0;
+};
+
 /**
  * @brief Generic wait for given timeout until check function return true
 
  * @param timeout [in] A time out value in nano sec. Give max value for not time bound wait.
  * @param check [in] Function to verify the condition of success.
+ * @param policy [in] Spin, sleep and block policy of the wait.
+ * @param stats [out] Optional statistics updated with CPU and wall time of the wait.
+ * @param block [in] Optional function that blocks until the signal may have changed or given
+ *                   absolute timeout expires. Returns false if it returned without blocking,
+ *                   the wait then falls back to sleeping.
  * @return true The address has been signaled within given time.
  * @return false Otherwise.
  */
-bool waitForSignal(uint64_t timeout, std::function<bool()> check);
+bool waitForSignal(uint64_t timeout,
+                   std::function<bool()> check,
+                   const WaitPolicy &policy = getDefaultWaitPolicy(),
+                   WaitStatistics *stats = nullptr,
+                   std::function<bool(int64_t)> block = nullptr);
 
 /**
  * @brief Wait for given timeout until the jobs are all signalled by KMD.
  *
  * @param timeout [in] A time out value in nano sec. Give max value for not time bound wait.
  * @param jobs [in] Vector for submitted command buffers.
+ * @param policy [in] Spin, sleep and block policy of the wait.
+ * @param stats [out] Optional statistics updated with CPU and wall time of the wait.
  * @return true All command buffers have been signaled within given time.
  * @return false Otherwise.
  */
 bool waitForSignal(uint64_t timeout,
                    const std::vector<std::shared_ptr<VPUJob>> &jobs,
-                   VPUHwInfo devInfo);
+                   VPUHwInfo devInfo,
+                   const WaitPolicy &policy = getDefaultWaitPolicy(),
+                   WaitStatistics *stats = nullptr);
+
+/**
+ * @brief Convert relative timeout to absolute steady clock time used by KMD waits.
+ */
+int64_t getAbsoluteTimeoutNanoseconds(int64_t timeout);
 } // namespace VPU
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/trace_buffer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace VPU {
+
+static_assert(sizeof(TraceBuffer::Record) == 128, "Trace record should fill two cache lines");
+static_assert((TraceBuffer::ringCapacity & (TraceBuffer::ringCapacity - 1)) == 0,
+              "Ring capacity has to be power of two");
+
+void traceLog(const LogCallsite &callsite, const TraceArg *args, size_t count) {
+    TraceBuffer::getInstance().record(callsite, args, count);
+}
+
+TraceBuffer &TraceBuffer::getInstance() {
+    // Never destroyed, threads may log until the very end of the process
+    static TraceBuffer *instance = new TraceBuffer;
+    return *instance;
+}
+
+TraceBuffer::RingOwner::~RingOwner() {
+    if (ring == nullptr)
+        return;
+
+    auto &trace = TraceBuffer::getInstance();
+    const std::lock_guard<std::mutex> lock(trace.mtx);
+    trace.freeRings.push_back(ring);
+}
+
+TraceBuffer::RingOwner &TraceBuffer::getThreadRing() {
+    static thread_local RingOwner owner;
+    if (owner.ring != nullptr)
+        return owner;
+
+    owner.tid = static_cast<uint32_t>(syscall(SYS_gettid));
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    if (!freeRings.empty()) {
+        owner.ring = freeRings.back();
+        freeRings.pop_back();
+    } else {
+        owner.ring = rings.emplace_back(std::make_unique<Ring>()).get();
+    }
+    return owner;
+}
+
+void TraceBuffer::record(const LogCallsite &callsite, const TraceArg *args, size_t count) {
+    RingOwner &owner = getThreadRing();
+    Ring *ring = owner.ring;
+
+    uint64_t pos = ring->head.load(std::memory_order_relaxed);
+    Record &rec = ring->records[pos & (ringCapacity - 1)];
+
+    rec.timestampNs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    rec.callsite = &callsite;
+    rec.tid = owner.tid;
+    rec.argCount = static_cast<uint8_t>(std::min(count, maxArgs));
+    rec.stringMask = 0;
+    rec.stringBytes = 0;
+
+    for (size_t i = 0; i < rec.argCount; i++) {
+        if (!args[i].isString) {
+            rec.args[i] = args[i].value;
+            continue;
+        }
+
+        // Strings may not outlive the call, copy as much as fits in the pool
+        const char *str = args[i].str == nullptr ? "(null)" : args[i].str;
+        size_t room = stringPoolSize - rec.stringBytes;
+        rec.stringMask = static_cast<uint8_t>(rec.stringMask | (1u << i));
+        rec.args[i] = rec.stringBytes;
+        if (room == 0)
+            continue;
+
+        size_t len = strnlen(str, room - 1);
+        memcpy(&rec.strings[rec.stringBytes], str, len);
+        rec.strings[rec.stringBytes + len] = '\0';
+        rec.stringBytes = static_cast<uint16_t>(rec.stringBytes + len + 1);
+    }
+
+    ring->head.store(pos + 1, std::memory_order_release);
+}
+
+std::vector<TraceBuffer::Record> TraceBuffer::getRecords() const {
+    std::vector<Record> records;
+    uint64_t startNs = clearedNs.load(std::memory_order_relaxed);
+
+    const std::lock_guard<std::mutex> lock(mtx);
+    for (const auto &ring : rings) {
+        uint64_t end = ring->head.load(std::memory_order_acquire);
+        uint64_t begin = end > ringCapacity ? end - ringCapacity : 0;
+
+        std::vector<Record> copy;
+        copy.reserve(end - begin);
+        for (uint64_t pos = begin; pos < end; pos++)
+            copy.push_back(ring->records[pos & (ringCapacity - 1)]);
+
+        // Owner keeps writing while the ring is copied, drop records it could have overwritten
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t firstValid = head + 1 > ringCapacity ? head + 1 - ringCapacity : 0;
+
+        for (uint64_t pos = std::max(begin, firstValid); pos < end; pos++) {
+            const Record &rec = copy[pos - begin];
+            if (rec.timestampNs >= startNs)
+                records.push_back(rec);
+        }
+    }
+
+    std::stable_sort(records.begin(), records.end(), [](const auto &a, const auto &b) {
+        return a.timestampNs < b.timestampNs;
+    });
+    return records;
+}
+
+std::string TraceBuffer::formatMessage(const Record &record) {
+    std::string message;
+    size_t argIndex = 0;
+    char buffer[256];
+
+    auto nextArg = [&](uint64_t &value, bool &isString) {
+        if (argIndex >= record.argCount)
+            return false;
+        value = record.args[argIndex];
+        isString = (record.stringMask >> argIndex) & 1;
+        argIndex++;
+        return true;
+    };
+
+    const char *p = record.callsite->format;
+    while (*p != '\0') {
+        if (*p != '%') {
+            message += *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            message += '%';
+            p += 2;
+            continue;
+        }
+
+        // Rebuild the conversion with a fixed length modifier matching the stored value
+        std::string spec = "%";
+        p++;
+        while (*p != '\0' && strchr("-+ #0", *p) != nullptr)
+            spec += *p++;
+
+        auto appendWidth = [&]() {
+            if (*p == '*') {
+                uint64_t value;
+                bool isString;
+                if (nextArg(value, isString))
+                    spec += std::to_string(static_cast<int>(value));
+                p++;
+                return;
+            }
+            while (isdigit(static_cast<unsigned char>(*p)))
+                spec += *p++;
+        };
+        appendWidth();
+        if (*p == '.') {
+            spec += *p++;
+            appendWidth();
+        }
+
+        std::string length;
+        while (*p != '\0' && strchr("hlLqjzt", *p) != nullptr)
+            length += *p++;
+        char conversion = *p;
+        if (conversion != '\0')
+            p++;
+
+        uint64_t value;
+        bool isString;
+        if (!nextArg(value, isString)) {
+            message += "<?>";
+            continue;
+        }
+
+        switch (conversion) {
+        case 'd':
+        case 'i': {
+            long long v;
+            if (length == "hh")
+                v = static_cast<signed char>(value);
+            else if (length == "h")
+                v = static_cast<short>(value);
+            else if (length.empty())
+                v = static_cast<int>(value);
+            else
+                v = static_cast<long long>(value);
+            snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), v);
+            break;
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X': {
+            unsigned long long v;
+            if (length == "hh")
+                v = static_cast<unsigned char>(value);
+            else if (length == "h")
+                v = static_cast<unsigned short>(value);
+            else if (length.empty())
+                v = static_cast<unsigned>(value);
+            else
+                v = value;
+            snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(), v);
+            break;
+        }
+        case 'c':
+            snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(value));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            double v;
+            memcpy(&v, &value, sizeof(v));
+            snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), v);
+            break;
+        }
+        case 's': {
+            const char *str = "<?>";
+            if (isString)
+                str = value < record.stringBytes ? &record.strings[value] : "";
+            snprintf(buffer, sizeof(buffer), (spec + "s").c_str(), str);
+            break;
+        }
+        case 'p':
+            snprintf(buffer,
+                     sizeof(buffer),
+                     (spec + "p").c_str(),
+                     reinterpret_cast<void *>(static_cast<uintptr_t>(value)));
+            break;
+        default:
+            snprintf(buffer, sizeof(buffer), "<?>");
+            break;
+        }
+        message += buffer;
+    }
+
+    return message;
+}
+
+std::string TraceBuffer::format(const Record &record) {
+    const LogCallsite *callsite = record.callsite;
+    const char *file = strrchr(callsite->file, '/');
+    file = file == nullptr ? callsite->file : file + 1;
+
+    char header[256];
+    snprintf(header,
+             sizeof(header),
+             "VPU_TRACE:[%s] %" PRIu64 ".%09" PRIu64 " %u %s::%s():%d: ",
+             getLogLevelPrefix(callsite->level),
+             record.timestampNs / 1'000'000'000,
+             record.timestampNs % 1'000'000'000,
+             record.tid,
+             file,
+             callsite->function,
+             callsite->line);
+    return header + formatMessage(record);
+}
+
+void TraceBuffer::dump(FILE *stream) const {
+    for (const auto &record : getRecords()) {
+        fputs(format(record).c_str(), stream);
+        fputc('\n', stream);
+    }
+    fflush(stream);
+}
+
+void TraceBuffer::clear() {
+    clearedNs.store(static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count()),
+                    std::memory_order_relaxed);
+}
+
+void TraceBuffer::enableDumpAtExit(std::string_view path) {
+    std::call_once(dumpAtExitOnce, [this, path] {
+        dumpPath = path;
+        std::atexit([] {
+            auto &trace = TraceBuffer::getInstance();
+            FILE *stream = stderr;
+            if (!trace.dumpPath.empty()) {
+                stream = fopen(trace.dumpPath.c_str(), "w");
+                if (stream == nullptr) {
+                    LOG_E("Failed to open trace file %s", trace.dumpPath.c_str());
+                    return;
+                }
+            }
+            trace.dump(stream);
+            if (stream != stderr)
+                fclose(stream);
+        });
+    });
+}
+
+} // namespace VPU
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#pragma once
+
+#include "vpu_driver/source/utilities/log.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VPU {
+
+/**
+ * In-memory trace of LOG_* messages.
+ *
+ * A message is stored as a fixed size record with timestamp, callsite and raw argument values,
+ * the format is applied only when the trace is dumped. Each thread writes to its own ring
+ * without locks and the oldest records are overwritten when the ring is full. Rings of exited
+ * threads are reused by new threads.
+ */
+class TraceBuffer {
+  public:
+    static constexpr size_t maxArgs = 8;
+    static constexpr size_t stringPoolSize = 40;
+    static constexpr size_t ringCapacity = 4096;
+
+    struct Record {
+        uint64_t timestampNs;
+        const LogCallsite *callsite;
+        uint32_t tid;
+        /* Arguments above maxArgs are dropped */
+        uint8_t argCount;
+        /* Bit n is set if argument n is an offset of a string copied to the pool */
+        uint8_t stringMask;
+        uint16_t stringBytes;
+        uint64_t args[maxArgs];
+        char strings[stringPoolSize];
+    };
+
+    TraceBuffer(const TraceBuffer &) = delete;
+    TraceBuffer &operator=(const TraceBuffer &) = delete;
+
+    static TraceBuffer &getInstance();
+
+    void record(const LogCallsite &callsite, const TraceArg *args, size_t count);
+
+    /**
+     * Returns records of all threads written since the last clear, ordered by timestamp.
+     * The slot a thread may be writing is skipped, so up to ringCapacity - 1 records of each
+     * thread are returned.
+     */
+    std::vector<Record> getRecords() const;
+
+    /**
+     * Apply the callsite format to the recorded arguments.
+     */
+    static std::string formatMessage(const Record &record);
+    static std::string format(const Record &record);
+
+    void dump(FILE *stream) const;
+    void clear();
+
+    /**
+     * Dump the trace when the process exits.
+     * @param path output file, stderr is used if empty
+     */
+    void enableDumpAtExit(std::string_view path);
+
+  private:
+    struct Ring {
+        /* Number of records ever written, only the owning thread writes it */
+        std::atomic<uint64_t> head = 0;
+        std::array<Record, ringCapacity> records;
+    };
+
+    /* Returns ring of the calling thread back to the pool when the thread exits */
+    struct RingOwner {
+        Ring *ring = nullptr;
+        uint32_t tid = 0;
+        ~RingOwner();
+    };
+
+    TraceBuffer() = default;
+
+    RingOwner &getThreadRing();
+
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<Ring *> freeRings;
+    std::atomic<uint64_t> clearedNs = 0;
+    std::once_flag dumpAtExitOnce;
+    std::string dumpPath;
+};
+
+} // namespace VPU
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace VPU;
+
+static void printUsage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-q] CAPTURE...\n"
+            "Decode and validate command buffers captured with VPU_DRV_CMDBUF_CAPTURE_DIR\n"
+            "  -q  print only rule violations\n"
+            "Returns 0 if all captures are valid\n",
+            name);
+}
+
+int main(int argc, char **argv) {
+    bool quiet = false;
+    int first = 1;
+    if (first < argc && strcmp(argv[first], "-q") == 0) {
+        quiet = true;
+        first++;
+    }
+
+    if (first >= argc || argv[first][0] == '-') {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    int ret = 0;
+    for (int i = first; i < argc; i++) {
+        VPUCommandDecoder::Capture capture;
+        if (!VPUCommandDecoder::readCapture(argv[i], capture)) {
+            fprintf(stderr, "%s: failed to read capture\n", argv[i]);
+            ret = 1;
+            continue;
+        }
+
+        auto result = VPUCommandDecoder::decode(capture);
+        if (!quiet)
+            printf("%s:\n%s\n", argv[i], result.listing.c_str());
+        for (const auto &error : result.errors)
+            fprintf(stderr, "%s: %s\n", argv[i], error.c_str());
+        if (!result.isValid())
+            ret = 1;
+    }
+    return ret;
+}
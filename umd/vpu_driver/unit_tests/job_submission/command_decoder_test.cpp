@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_command_decoder.hpp"
+#include "vpu_driver/source/command/vpu_copy_command.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+#include "vpu_driver/source/device/vpu_device.hpp"
+#include "vpu_driver/source/device/vpu_device_context.hpp"
+#include "vpu_driver/source/os_interface/os_interface_emulator.hpp"
+#include "vpu_driver/source/os_interface/vpu_device_factory.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdlib.h>
+
+using namespace VPU;
+
+struct VPUCommandDecoderTest : public ::testing::Test {
+    void SetUp() override {
+        char tmpl[] = "/tmp/vpu_cmdbuf_capture_test.XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(tmpl));
+        directory = tmpl;
+
+        devices = DeviceFactory::createDevices(&emulator);
+        ASSERT_EQ(1u, devices.size());
+        deviceContext = devices[0]->createDeviceContext();
+        ASSERT_NE(nullptr, deviceContext);
+        ctx = deviceContext.get();
+    }
+
+    void TearDown() override {
+        VPUCommandDecoder::setCaptureDirectory("");
+        std::filesystem::remove_all(directory);
+    }
+
+    std::vector<VPUCommandDecoder::Capture> readCaptures() {
+        std::vector<std::string> paths;
+        for (const auto &entry : std::filesystem::directory_iterator(directory))
+            paths.push_back(entry.path());
+        std::sort(paths.begin(), paths.end());
+
+        std::vector<VPUCommandDecoder::Capture> captures;
+        for (const auto &path : paths)
+            EXPECT_TRUE(VPUCommandDecoder::readCapture(path, captures.emplace_back()));
+        return captures;
+    }
+
+    /* Command buffer with header of the driver and commands at 64 bytes offset */
+    static VPUCommandDecoder::Capture
+    makeCapture(uint32_t engine, const std::vector<std::vector<uint8_t>> &cmds) {
+        VPUCommandDecoder::Capture capture;
+        capture.engine = engine;
+        capture.cmdBuffer.vpuAddr = 0x80001000;
+        capture.cmdBuffer.data.resize(cmdOffset);
+        for (const auto &cmd : cmds)
+            capture.cmdBuffer.data.insert(capture.cmdBuffer.data.end(), cmd.begin(), cmd.end());
+
+        auto *header = reinterpret_cast<vpu_cmd_buffer_header_t *>(capture.cmdBuffer.data.data());
+        header->cmd_offset = cmdOffset;
+        header->cmd_buffer_size = static_cast<uint32_t>(capture.cmdBuffer.data.size());
+        header->kernel_heap_base_address = heapBase;
+        header->descriptor_heap_base_address = heapBase;
+        header->fence_heap_base_address = heapBase;
+        return capture;
+    }
+
+    template <class T>
+    static std::vector<uint8_t> toBytes(const T &cmd) {
+        auto *bytes = reinterpret_cast<const uint8_t *>(&cmd);
+        return std::vector<uint8_t>(bytes, bytes + sizeof(cmd));
+    }
+
+    static std::vector<uint8_t> makeCopy(uint64_t descOffset, uint32_t descCount) {
+        vpu_cmd_copy_buffer_t cmd = {};
+        cmd.header.type = VPU_CMD_COPY_SYSTEM_TO_SYSTEM;
+        cmd.header.size = sizeof(cmd);
+        cmd.desc_start_offset = descOffset;
+        cmd.desc_count = descCount;
+        return toBytes(cmd);
+    }
+
+    bool hasError(const VPUCommandDecoder::Result &result, const std::string &message) {
+        for (const auto &error : result.errors)
+            if (error.find(message) != std::string::npos)
+                return true;
+        return false;
+    }
+
+    static constexpr uint32_t cmdOffset = 64;
+    static constexpr uint64_t heapBase = 0x80000000;
+
+    std::string directory;
+    OsInterfaceEmulator emulator;
+    std::vector<std::unique_ptr<VPUDevice>> devices;
+    std::unique_ptr<VPUDeviceContext> deviceContext;
+    VPUDeviceContext *ctx = nullptr;
+
+    const int64_t timeoutNs = 5'000'000'000;
+    const size_t allocSize = 4 * 1024;
+};
+
+TEST_F(VPUCommandDecoderTest, nothingIsCapturedByDefault) {
+    EXPECT_FALSE(VPUCommandDecoder::isCaptureEnabled());
+
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, ts);
+
+    VPUJob job(ctx, false);
+    EXPECT_TRUE(job.appendCommand(VPUTimeStampCommand::create(ctx, ts)));
+    EXPECT_TRUE(job.closeCommands());
+    EXPECT_TRUE(ctx->submitJob(&job));
+    EXPECT_TRUE(job.waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+}
+
+TEST_F(VPUCommandDecoderTest, submittedCommandBuffersAreCapturedAndValid) {
+    VPUCommandDecoder::setCaptureDirectory(directory);
+    EXPECT_TRUE(VPUCommandDecoder::isCaptureEnabled());
+
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    void *hostMem = ctx->createHostMemAlloc(allocSize);
+    void *shareMem = ctx->createSharedMemAlloc(allocSize);
+    ASSERT_NE(nullptr, ts);
+    ASSERT_NE(nullptr, hostMem);
+    ASSERT_NE(nullptr, shareMem);
+
+    // Local to local copy runs on compute engine, copy from host on copy engine
+    VPUJob job(ctx, false);
+    EXPECT_TRUE(job.appendCommand(VPUTimeStampCommand::create(ctx, ts)));
+    EXPECT_TRUE(job.appendCommand(VPUCopyCommand::create(ctx, shareMem, shareMem, allocSize)));
+    EXPECT_TRUE(job.appendCommand(VPUCopyCommand::create(ctx, hostMem, shareMem, allocSize)));
+    EXPECT_TRUE(job.closeCommands());
+    EXPECT_TRUE(ctx->submitJob(&job));
+    EXPECT_TRUE(job.waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+
+    auto captures = readCaptures();
+    ASSERT_EQ(2u, captures.size());
+    EXPECT_EQ(static_cast<uint32_t>(DRM_IVPU_ENGINE_COMPUTE), captures[0].engine);
+    EXPECT_EQ(static_cast<uint32_t>(DRM_IVPU_ENGINE_COPY), captures[1].engine);
+
+    for (const auto &capture : captures) {
+        EXPECT_EQ(1u, capture.heaps.size());
+        auto result = VPUCommandDecoder::decode(capture);
+        EXPECT_TRUE(result.isValid()) << result.listing;
+        EXPECT_NE(std::string::npos, result.listing.find("size = 4096"));
+    }
+    EXPECT_NE(std::string::npos,
+              VPUCommandDecoder::decode(captures[0]).listing.find("COPY_LOCAL_TO_LOCAL"));
+    EXPECT_NE(std::string::npos,
+              VPUCommandDecoder::decode(captures[1]).listing.find("COPY_SYSTEM_TO_SYSTEM"));
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+    EXPECT_TRUE(ctx->freeMemAlloc(hostMem));
+    EXPECT_TRUE(ctx->freeMemAlloc(shareMem));
+}
+
+TEST_F(VPUCommandDecoderTest, batchCaptureIncludesDescriptorsOfBatchedJobs) {
+    void *hostMem = ctx->createHostMemAlloc(allocSize);
+    void *shareMem = ctx->createSharedMemAlloc(allocSize);
+    ASSERT_NE(nullptr, hostMem);
+    ASSERT_NE(nullptr, shareMem);
+
+    std::vector<std::shared_ptr<VPUJob>> jobs;
+    for (int i = 0; i < 2; i++) {
+        auto job = std::make_shared<VPUJob>(ctx, true);
+        EXPECT_TRUE(job->appendCommand(VPUCopyCommand::create(ctx, hostMem, shareMem, allocSize)));
+        EXPECT_TRUE(job->closeCommands());
+        jobs.push_back(std::move(job));
+    }
+    auto batch = VPUJob::createBatch(ctx, jobs);
+    ASSERT_NE(nullptr, batch);
+
+    VPUCommandDecoder::setCaptureDirectory(directory);
+    EXPECT_TRUE(ctx->submitJob(batch.get()));
+    EXPECT_TRUE(batch->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+
+    auto captures = readCaptures();
+    ASSERT_EQ(1u, captures.size());
+    EXPECT_EQ(3u, captures[0].heaps.size());
+    auto result = VPUCommandDecoder::decode(captures[0]);
+    EXPECT_TRUE(result.isValid()) << result.listing;
+
+    batch.reset();
+    jobs.clear();
+    EXPECT_TRUE(ctx->freeMemAlloc(hostMem));
+    EXPECT_TRUE(ctx->freeMemAlloc(shareMem));
+}
+
+TEST_F(VPUCommandDecoderTest, captureIsWrittenAndReadBack) {
+    auto capture = makeCapture(DRM_IVPU_ENGINE_COPY, {makeCopy(0x100, 1)});
+    capture.heaps.push_back({heapBase + 0x100, std::vector<uint8_t>(64, 0x5a)});
+
+    std::string path = directory + "/capture.bin";
+    ASSERT_TRUE(VPUCommandDecoder::writeCapture(path, capture));
+
+    VPUCommandDecoder::Capture loaded;
+    ASSERT_TRUE(VPUCommandDecoder::readCapture(path, loaded));
+    EXPECT_EQ(capture.engine, loaded.engine);
+    EXPECT_EQ(capture.cmdBuffer.vpuAddr, loaded.cmdBuffer.vpuAddr);
+    EXPECT_EQ(capture.cmdBuffer.data, loaded.cmdBuffer.data);
+    ASSERT_EQ(1u, loaded.heaps.size());
+    EXPECT_EQ(capture.heaps[0].vpuAddr, loaded.heaps[0].vpuAddr);
+    EXPECT_EQ(capture.heaps[0].data, loaded.heaps[0].data);
+
+    // Truncated capture is rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(VPUCommandDecoder::readCapture(path, loaded));
+
+    std::ofstream(path, std::ios::binary) << "not a capture";
+    EXPECT_FALSE(VPUCommandDecoder::readCapture(path, loaded));
+}
+
+TEST_F(VPUCommandDecoderTest, invalidCommandsAreReported) {
+    vpu_cmd_header_t unknown = {0x0abc, sizeof(vpu_cmd_header_t)};
+    vpu_cmd_timestamp_t ts = {};
+    ts.header = {VPU_CMD_TIMESTAMP, sizeof(vpu_cmd_timestamp_t) - 8};
+
+    auto result = VPUCommandDecoder::decode(
+        makeCapture(DRM_IVPU_ENGINE_COMPUTE, {makeCopy(0x100, 1), toBytes(unknown), toBytes(ts)}));
+    EXPECT_FALSE(result.isValid());
+    EXPECT_TRUE(hasError(result, "+0x0040 COPY_SYSTEM_TO_SYSTEM: command is not supported by "
+                                 "COMPUTE engine"));
+    EXPECT_TRUE(hasError(result, "are outside of captured heaps"));
+    EXPECT_TRUE(hasError(result, "unknown command type 0xabc"));
+    EXPECT_TRUE(hasError(result, "TIMESTAMP: command size 8 is smaller than 16"));
+}
+
+TEST_F(VPUCommandDecoderTest, commandsOutsideOfBufferAreReported) {
+    auto capture = makeCapture(DRM_IVPU_ENGINE_COPY, {makeCopy(0x100, 1)});
+    auto *header = reinterpret_cast<vpu_cmd_buffer_header_t *>(capture.cmdBuffer.data.data());
+    header->cmd_buffer_size += 16;
+
+    auto result = VPUCommandDecoder::decode(capture);
+    EXPECT_TRUE(hasError(result, "exceeds"));
+    EXPECT_TRUE(hasError(result, "+0x0040 COPY_SYSTEM_TO_SYSTEM: descriptors"));
+
+    header->cmd_offset = 8;
+    result = VPUCommandDecoder::decode(capture);
+    EXPECT_TRUE(hasError(result, "header: commands offset 0x8 is outside of command buffer"));
+
+    capture.cmdBuffer.data.resize(16);
+    result = VPUCommandDecoder::decode(capture);
+    EXPECT_TRUE(hasError(result, "smaller than its header"));
+}
+
+TEST_F(VPUCommandDecoderTest, copyDescriptorsAreValidated) {
+    auto capture = makeCapture(DRM_IVPU_ENGINE_COPY,
+                               {makeCopy(0x100, 2), makeCopy(0x120, 1), makeCopy(0x100, 0)});
+    capture.heaps.push_back({heapBase + 0x100, std::vector<uint8_t>(128, 0)});
+
+    auto *desc = reinterpret_cast<vpu_cmd_copy_descriptor_mtl_t *>(capture.heaps[0].data.data());
+    desc[0].src_address = 0x1000;
+    desc[0].dst_address = 0x2000;
+    desc[0].size = 0x100;
+
+    auto result = VPUCommandDecoder::decode(capture);
+    EXPECT_NE(std::string::npos,
+              result.listing.find("[0] src_address = 0x1000, dst_address = 0x2000, size = 256"));
+    EXPECT_TRUE(hasError(result, "+0x0040 COPY_SYSTEM_TO_SYSTEM: copy descriptor 1 is empty"));
+    EXPECT_TRUE(hasError(result, "+0x0058 COPY_SYSTEM_TO_SYSTEM: descriptors address 0x80000120 "
+                                 "is not aligned to 64 bytes"));
+    EXPECT_TRUE(hasError(result, "+0x0070 COPY_SYSTEM_TO_SYSTEM: descriptor count 0"));
+}
+
+TEST_F(VPUCommandDecoderTest, descriptorTablesOfBlobExecuteAreDecoded) {
+    vpu_cmd_ov_blob_execute_t exe = {};
+    exe.header = {VPU_CMD_OV_BLOB_EXECUTE, sizeof(exe)};
+    exe.desc_table_offset = 0x200;
+    exe.desc_table_size =
+        2 * sizeof(vpu_cmd_resource_descriptor_table_t) + sizeof(vpu_cmd_resource_descriptor_t);
+
+    auto capture = makeCapture(DRM_IVPU_ENGINE_COMPUTE, {toBytes(exe)});
+    capture.heaps.push_back({heapBase + 0x200, std::vector<uint8_t>(exe.desc_table_size, 0)});
+
+    uint8_t *tables = capture.heaps[0].data.data();
+    auto *input = reinterpret_cast<vpu_cmd_resource_descriptor_table_t *>(tables);
+    input->type = VPU_DESC_TABLE_ENTRY_TYPE_INPUT;
+    input->desc_count = 1;
+    auto *entry = reinterpret_cast<vpu_cmd_resource_descriptor_t *>(input + 1);
+    entry->address = 0x3000;
+    entry->width = 64;
+    auto *scratch = reinterpret_cast<vpu_cmd_resource_descriptor_table_t *>(entry + 1);
+    scratch->type = VPU_DESC_TABLE_ENTRY_TYPE_SCRATCH;
+
+    auto result = VPUCommandDecoder::decode(capture);
+    EXPECT_NE(std::string::npos, result.listing.find("table INPUT (0x200), desc_count = 1"));
+    EXPECT_NE(std::string::npos, result.listing.find("[0] address = 0x3000, width = 64"));
+    ASSERT_EQ(1u, result.errors.size());
+    EXPECT_TRUE(hasError(result, "descriptor table type 0x100 is not valid for the command"));
+
+    // Descriptors above table size
+    scratch->type = VPU_DESC_TABLE_ENTRY_TYPE_OUTPUT;
+    scratch->desc_count = 1;
+    result = VPUCommandDecoder::decode(capture);
+    ASSERT_EQ(1u, result.errors.size());
+    EXPECT_TRUE(hasError(result, "exceed table size"));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_completion_notifier.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace VPU;
+
+struct VPUCompletionNotifierTest : public ::testing::Test {
+    void TearDown() override { ASSERT_EQ(ctx->getBuffersCount(), 0u); }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::unique_ptr<VPUDeviceContext> deviceContext = vpuDevice->createDeviceContext();
+    VPUDeviceContext *ctx = deviceContext.get();
+
+    const int64_t waitTimeoutNs = 10'000'000'000;
+};
+
+TEST_F(VPUCompletionNotifierTest, waitTimesOutWithoutNotification) {
+    VPUCompletionNotifier notifier;
+
+    uint32_t seq = notifier.getSequence();
+    EXPECT_FALSE(notifier.wait(seq, getAbsoluteTimeoutNanoseconds(1'000'000)));
+    EXPECT_EQ(seq, notifier.getSequence());
+
+    // Sequence changed before the wait, waiter returns immediately
+    notifier.notify();
+    EXPECT_TRUE(notifier.wait(seq, getAbsoluteTimeoutNanoseconds(0)));
+}
+
+TEST_F(VPUCompletionNotifierTest, notifyFromOtherThreadWakesWaiter) {
+    VPUCompletionNotifier notifier;
+
+    uint32_t seq = notifier.getSequence();
+    std::thread signaller([&notifier] { notifier.notify(); });
+    EXPECT_TRUE(notifier.wait(seq, getAbsoluteTimeoutNanoseconds(waitTimeoutNs)));
+    signaller.join();
+    EXPECT_NE(seq, notifier.getSequence());
+}
+
+TEST_F(VPUCompletionNotifierTest, completedJobWakesWaiter) {
+    uint64_t *tsHeap = reinterpret_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, tsHeap);
+
+    auto job = std::make_shared<VPUJob>(ctx, false);
+    ASSERT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, tsHeap)));
+    ASSERT_TRUE(job->closeCommands());
+
+    {
+        VPUCompletionNotifier notifier;
+        notifier.trackJob(job);
+        EXPECT_EQ(1u, notifier.getTrackedJobCount());
+
+        uint32_t seq = notifier.getSequence();
+        EXPECT_TRUE(notifier.wait(seq, getAbsoluteTimeoutNanoseconds(waitTimeoutNs)));
+        EXPECT_NE(seq, notifier.getSequence());
+    }
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(tsHeap));
+}
+
+TEST_F(VPUCompletionNotifierTest, jobsAreTrackedOnceAndDroppedWhenCompleted) {
+    uint64_t *tsHeap = reinterpret_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, tsHeap);
+
+    std::vector<std::shared_ptr<VPUJob>> jobs;
+    for (size_t i = 0; i < 3; i++) {
+        auto job = std::make_shared<VPUJob>(ctx, false);
+        ASSERT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, tsHeap)));
+        ASSERT_TRUE(job->closeCommands());
+        jobs.push_back(std::move(job));
+    }
+
+    {
+        VPUCompletionNotifier notifier;
+
+        // Long-lived job of a command list is submitted on every execute
+        for (size_t i = 0; i < 10; i++) {
+            ASSERT_TRUE(jobs[0]->waitForCompletion(getAbsoluteTimeoutNanoseconds(waitTimeoutNs)));
+            notifier.trackJob(jobs[0]);
+            EXPECT_EQ(1u, notifier.getTrackedJobCount());
+        }
+
+        // Completed jobs are dropped when next job is tracked
+        uint32_t seq = notifier.getSequence();
+        notifier.trackJob(jobs[1]);
+        notifier.trackJob(jobs[2]);
+        EXPECT_EQ(1u, notifier.getTrackedJobCount());
+        EXPECT_NE(seq, notifier.getSequence());
+
+        jobs[2].reset();
+        notifier.trackJob(jobs[1]);
+        EXPECT_EQ(1u, notifier.getTrackedJobCount());
+    }
+
+    jobs.clear();
+    EXPECT_TRUE(ctx->freeMemAlloc(tsHeap));
+}
@@ -302,3 +302,116 @@ TEST_F(VPUJobTest, checkJobStatusWhenTwoEnginesAreUsed) {
     EXPECT_TRUE(ctx->freeMemAlloc(hostMem));
     EXPECT_TRUE(ctx->freeMemAlloc(devMem));
 }
+
+TEST_F(VPUJobTest, prepareSubmissionCreatesShadowInstanceWhenJobIsInFlight) {
+    uint64_t *tsHeap = reinterpret_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+
+    auto job = std::make_unique<VPUJob>(ctx, false);
+    EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, tsHeap)));
+    EXPECT_FALSE(job->prepareSubmission());
+    EXPECT_TRUE(job->closeCommands());
+
+    // Job is idle, original command buffers are reused
+    EXPECT_TRUE(job->prepareSubmission());
+    EXPECT_EQ(1u, job->getInstanceCount());
+    auto *firstBuffer = job->getCommandBuffers()[0].get();
+
+    // Job is in flight, shadow copy is used for next submission
+    osInfc.mockFailNextJobWait();
+    EXPECT_TRUE(job->prepareSubmission());
+    EXPECT_EQ(2u, job->getInstanceCount());
+    EXPECT_EQ(1u, job->getCommandBuffers().size());
+    EXPECT_NE(firstBuffer, job->getCommandBuffers()[0].get());
+    EXPECT_NE(firstBuffer->getBufferHandles()[0], job->getCommandBuffers()[0]->getBufferHandles()[0]);
+
+    // Oldest instance is idle, it is reused
+    EXPECT_TRUE(job->prepareSubmission());
+    EXPECT_EQ(2u, job->getInstanceCount());
+    EXPECT_EQ(firstBuffer, job->getCommandBuffers()[0].get());
+
+    EXPECT_TRUE(job->waitForCompletion(0));
+    EXPECT_TRUE(job->isSuccess());
+    EXPECT_TRUE(ctx->freeMemAlloc(tsHeap));
+}
+
+TEST_F(VPUJobTest, createBatchMergesJobsIntoSingleCommandBufferPerEngine) {
+    uint64_t *tsHeap = reinterpret_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    void *hostMem = ctx->createHostMemAlloc(allocSize);
+    void *shareMem = ctx->createSharedMemAlloc(allocSize);
+
+    std::vector<std::shared_ptr<VPUJob>> jobs;
+    for (int i = 0; i < 3; i++) {
+        auto job = std::make_shared<VPUJob>(ctx, false);
+        EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, tsHeap)));
+        // Local to local copy runs on compute engine, copy from host on copy engine
+        EXPECT_TRUE(job->appendCommand(VPUCopyCommand::create(ctx, shareMem, shareMem, allocSize)));
+        EXPECT_TRUE(job->appendCommand(VPUCopyCommand::create(ctx, hostMem, shareMem, allocSize)));
+        jobs.push_back(std::move(job));
+    }
+
+    // Jobs have to be closed
+    EXPECT_EQ(nullptr, VPUJob::createBatch(ctx, jobs));
+    for (const auto &job : jobs) {
+        EXPECT_TRUE(job->closeCommands());
+        EXPECT_EQ(2u, job->getCommandBuffers().size());
+    }
+
+    auto batch = VPUJob::createBatch(ctx, jobs);
+    ASSERT_NE(nullptr, batch);
+    EXPECT_TRUE(batch->isClosed());
+    ASSERT_EQ(2u, batch->getCommandBuffers().size());
+    for (const auto &cmdBuffer : batch->getCommandBuffers()) {
+        EXPECT_EQ(getExpBufferCount(cmdBuffer->getBufferHandles()),
+                  cmdBuffer->getBufferHandles().size());
+    }
+    EXPECT_EQ(boost::numeric_cast<uint32_t>(DRM_IVPU_ENGINE_COMPUTE),
+              batch->getCommandBuffers()[0]->getEngine());
+    EXPECT_EQ(boost::numeric_cast<uint32_t>(DRM_IVPU_ENGINE_COPY),
+              batch->getCommandBuffers()[1]->getEngine());
+
+    // Completion of batched job is reported through batch, first batch wait times out
+    osInfc.mockFailNextJobWait();
+    osInfc.mockSuccessNextJobWait();
+    osInfc.mockSuccessNextJobWait();
+    EXPECT_FALSE(jobs[0]->waitForCompletion(0));
+    EXPECT_TRUE(jobs[0]->waitForCompletion(0));
+    EXPECT_TRUE(jobs[0]->isSuccess());
+
+    batch.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(shareMem));
+    EXPECT_TRUE(ctx->freeMemAlloc(hostMem));
+    EXPECT_TRUE(ctx->freeMemAlloc(tsHeap));
+}
+
+TEST_F(VPUJobTest, closeCommandsTakesOverBuffersOfRecycledJob) {
+    void *destPtr = ctx->createSharedMemAlloc(allocSize);
+    void *srcPtr = ctx->createHostMemAlloc(allocSize);
+    std::vector<std::shared_ptr<VPUCommand>> cmds = {
+        VPUCopyCommand::create(ctx, srcPtr, destPtr, allocSize)};
+
+    auto recycled = std::make_unique<VPUJob>(ctx, true);
+    ASSERT_TRUE(recycled->closeCommands(cmds, VPUCommandBuffer::Target::COPY));
+    ASSERT_EQ(1u, recycled->getCommandBuffers().size());
+    uint32_t cmdBufferHandle = recycled->getCommandBuffers()[0]->getBufferHandles()[0];
+    std::vector<const VPUBufferObject *> recycledDescriptors;
+    recycled->getDescriptorBuffers(recycledDescriptors);
+    ASSERT_EQ(1u, recycledDescriptors.size());
+    size_t buffersCount = ctx->getBuffersCount();
+
+    auto job = std::make_unique<VPUJob>(ctx, true);
+    ASSERT_TRUE(job->closeCommands(cmds, VPUCommandBuffer::Target::COPY, recycled.get()));
+    EXPECT_EQ(buffersCount, ctx->getBuffersCount());
+    ASSERT_EQ(1u, job->getCommandBuffers().size());
+    EXPECT_EQ(cmdBufferHandle, job->getCommandBuffers()[0]->getBufferHandles()[0]);
+    std::vector<const VPUBufferObject *> descriptors;
+    job->getDescriptorBuffers(descriptors);
+    EXPECT_EQ(recycledDescriptors, descriptors);
+
+    // Buffers are released once, by the job that took them over
+    recycled.reset();
+    EXPECT_EQ(buffersCount, ctx->getBuffersCount());
+    job.reset();
+
+    EXPECT_TRUE(ctx->freeMemAlloc(srcPtr));
+    EXPECT_TRUE(ctx->freeMemAlloc(destPtr));
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_job_tracer.hpp"
+#include "vpu_driver/source/command/vpu_memory_fill_command.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+#include "vpu_driver/source/device/vpu_device.hpp"
+#include "vpu_driver/source/device/vpu_device_context.hpp"
+#include "vpu_driver/source/os_interface/os_interface_emulator.hpp"
+#include "vpu_driver/source/os_interface/vpu_device_factory.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace VPU;
+
+struct VPUJobTracerTest : public ::testing::Test {
+    void SetUp() override {
+        devices = DeviceFactory::createDevices(&emulator);
+        ASSERT_EQ(1u, devices.size());
+        deviceContext = devices[0]->createDeviceContext();
+        ASSERT_NE(nullptr, deviceContext);
+        ctx = deviceContext.get();
+
+        tracer.clear();
+        tracer.enable();
+    }
+
+    void TearDown() override {
+        tracer.disable();
+        tracer.clear();
+    }
+
+    /* Run job with a fill command between two timestamps */
+    void runTimestampedJob(uint64_t *ts, uint8_t *mem) {
+        uint8_t pattern = 0x5a;
+        auto job = std::make_unique<VPUJob>(ctx, false);
+        EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, &ts[0])));
+        EXPECT_TRUE(job->appendCommand(
+            VPUMemoryFillCommand::create(ctx, mem, &pattern, sizeof(pattern), allocSize)));
+        EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, &ts[1])));
+        EXPECT_TRUE(job->closeCommands());
+        EXPECT_TRUE(ctx->submitJob(job.get(), &queue));
+        EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    }
+
+    size_t countEvents(char phase, const std::string &name) {
+        auto events = tracer.getEvents();
+        return static_cast<size_t>(std::count_if(events.begin(), events.end(), [&](const auto &e) {
+            return e.phase == phase && e.name == name;
+        }));
+    }
+
+    OsInterfaceEmulator emulator;
+    std::vector<std::unique_ptr<VPUDevice>> devices;
+    std::unique_ptr<VPUDeviceContext> deviceContext;
+    VPUDeviceContext *ctx = nullptr;
+    VPUJobTracer &tracer = VPUJobTracer::getInstance();
+    int queue = 0;
+
+    const int64_t timeoutNs = 5'000'000'000;
+    const size_t allocSize = 4 * 1024;
+};
+
+TEST_F(VPUJobTracerTest, jobStagesAreRecordedOnThreadTrack) {
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(2 * sizeof(uint64_t)));
+    auto *mem = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    ASSERT_NE(nullptr, ts);
+    ASSERT_NE(nullptr, mem);
+
+    runTimestampedJob(ts, mem);
+
+    EXPECT_EQ(1u, countEvents('X', "closeCommands"));
+    EXPECT_EQ(1u, countEvents('X', "submitJob"));
+    EXPECT_EQ(1u, countEvents('X', "waitForCompletion"));
+    EXPECT_EQ(1u, countEvents('b', "Queue 0"));
+    EXPECT_EQ(1u, countEvents('e', "Queue 0"));
+
+    auto events = tracer.getEvents();
+    auto submit = std::find_if(events.begin(), events.end(), [](const auto &e) {
+        return e.phase == 'b';
+    });
+    auto complete = std::find_if(events.begin(), events.end(), [](const auto &e) {
+        return e.phase == 'e';
+    });
+    ASSERT_NE(events.end(), submit);
+    ASSERT_NE(events.end(), complete);
+    EXPECT_EQ(submit->id, complete->id);
+    EXPECT_LE(submit->tsNs, complete->tsNs);
+
+    // Further waits on completed job do not add events
+    size_t count = events.size();
+    ASSERT_TRUE(ctx->freeMemAlloc(ts));
+    ASSERT_TRUE(ctx->freeMemAlloc(mem));
+    EXPECT_EQ(count, tracer.getEvents().size());
+}
+
+TEST_F(VPUJobTracerTest, completionSeenByPollClosesInFlightSlice) {
+    auto *mem = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    ASSERT_NE(nullptr, mem);
+
+    uint8_t pattern = 0x5a;
+    auto job = std::make_unique<VPUJob>(ctx, false);
+    EXPECT_TRUE(job->appendCommand(
+        VPUMemoryFillCommand::create(ctx, mem, &pattern, sizeof(pattern), allocSize)));
+    EXPECT_TRUE(job->closeCommands());
+    EXPECT_TRUE(ctx->submitJob(job.get(), &queue));
+    EXPECT_TRUE(waitForSignal(static_cast<uint64_t>(timeoutNs),
+                              [&job]() { return job->waitForCompletion(0); }));
+
+    // Polls are not host stages, the in-flight slice is closed by the first completed one
+    EXPECT_EQ(0u, countEvents('X', "waitForCompletion"));
+    EXPECT_EQ(1u, countEvents('b', "Queue 0"));
+    EXPECT_EQ(1u, countEvents('e', "Queue 0"));
+
+    EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_EQ(1u, countEvents('e', "Queue 0"));
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(mem));
+}
+
+TEST_F(VPUJobTracerTest, deviceTimestampsAreRecordedOnEngineTrack) {
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(2 * sizeof(uint64_t)));
+    auto *mem = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    ASSERT_NE(nullptr, ts);
+    ASSERT_NE(nullptr, mem);
+
+    runTimestampedJob(ts, mem);
+
+    // Timestamps follow the fill command to the copy engine
+    auto events = tracer.getEvents();
+    uint64_t engineTrack =
+        VPUJobTracer::engineTrackBase + static_cast<uint64_t>(VPUCommandBuffer::Target::COPY);
+    size_t instants = 0;
+    for (const auto &event : events) {
+        if (event.phase == 'i') {
+            EXPECT_EQ(engineTrack, event.tid);
+            instants++;
+        }
+    }
+    EXPECT_EQ(2u, instants);
+
+    auto json = tracer.getJson();
+    EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("VPU COPY engine"));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"submitJob\""));
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+    EXPECT_TRUE(ctx->freeMemAlloc(mem));
+}
+
+TEST_F(VPUJobTracerTest, nothingIsRecordedWhenDisabled) {
+    tracer.disable();
+
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(2 * sizeof(uint64_t)));
+    auto *mem = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    ASSERT_NE(nullptr, ts);
+    ASSERT_NE(nullptr, mem);
+
+    runTimestampedJob(ts, mem);
+    EXPECT_TRUE(tracer.getEvents().empty());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+    EXPECT_TRUE(ctx->freeMemAlloc(mem));
+}
@@ -92,6 +92,77 @@ TEST_F(VPUCommandTest, copyCommandShouldReturnExpectedProperties) {
     EXPECT_TRUE(ctx->freeMemAlloc(dstPtr));
 }
 
+TEST_F(VPUCommandTest, regionCopyCommandUsesDescriptorPerRow) {
+    const size_t width = 16, height = 8, srcPitch = 64, dstPitch = 32;
+    void *srcPtr = ctx->createSharedMemAlloc(srcPitch * height);
+    void *dstPtr = ctx->createSharedMemAlloc(dstPitch * height);
+
+    VPUCopyCommand::Region srcRegion = {0, srcPitch, srcPitch * height};
+    VPUCopyCommand::Region dstRegion = {0, dstPitch, dstPitch * height};
+    auto cmds =
+        VPUCopyCommand::createRegion(ctx, srcPtr, srcRegion, dstPtr, dstRegion, width, height, 1);
+    ASSERT_EQ(cmds.size(), 1u);
+
+    auto *copyCmd = reinterpret_cast<const vpu_cmd_copy_buffer_t *>(cmds[0]->getCommitStream());
+    EXPECT_EQ(copyCmd->header.type, VPU_CMD_COPY_LOCAL_TO_LOCAL);
+    EXPECT_EQ(copyCmd->desc_count, height);
+    EXPECT_EQ(cmds[0]->getDescriptorSize(), height * sizeof(vpu_cmd_copy_descriptor_mtl_t));
+
+    EXPECT_TRUE(ctx->freeMemAlloc(srcPtr));
+    EXPECT_TRUE(ctx->freeMemAlloc(dstPtr));
+}
+
+TEST_F(VPUCommandTest, regionCopyCommandMergesContiguousRows) {
+    const size_t width = 32, height = 8, depth = 2;
+    void *srcPtr = ctx->createSharedMemAlloc(width * height * depth);
+    void *dstPtr = ctx->createSharedMemAlloc(width * height * depth);
+
+    VPUCopyCommand::Region region = {0, width, width * height};
+    auto cmds =
+        VPUCopyCommand::createRegion(ctx, srcPtr, region, dstPtr, region, width, height, depth);
+    ASSERT_EQ(cmds.size(), 1u);
+
+    auto *copyCmd = reinterpret_cast<const vpu_cmd_copy_buffer_t *>(cmds[0]->getCommitStream());
+    EXPECT_EQ(copyCmd->desc_count, 1u);
+
+    EXPECT_TRUE(ctx->freeMemAlloc(srcPtr));
+    EXPECT_TRUE(ctx->freeMemAlloc(dstPtr));
+}
+
+TEST_F(VPUCommandTest, regionCopyCommandIsSplitAboveDescriptorCountLimit) {
+    const size_t width = 1, height = VPU_CMD_COPY_DESC_COUNT_MAX + 1, pitch = 2;
+    void *srcPtr = ctx->createSharedMemAlloc(pitch * height);
+    void *dstPtr = ctx->createSharedMemAlloc(pitch * height);
+
+    VPUCopyCommand::Region region = {0, pitch, pitch * height};
+    auto cmds =
+        VPUCopyCommand::createRegion(ctx, srcPtr, region, dstPtr, region, width, height, 1);
+    ASSERT_EQ(cmds.size(), 2u);
+
+    auto *copyCmd = reinterpret_cast<const vpu_cmd_copy_buffer_t *>(cmds[0]->getCommitStream());
+    EXPECT_EQ(copyCmd->desc_count, static_cast<uint32_t>(VPU_CMD_COPY_DESC_COUNT_MAX));
+    copyCmd = reinterpret_cast<const vpu_cmd_copy_buffer_t *>(cmds[1]->getCommitStream());
+    EXPECT_EQ(copyCmd->desc_count, 1u);
+
+    EXPECT_TRUE(ctx->freeMemAlloc(srcPtr));
+    EXPECT_TRUE(ctx->freeMemAlloc(dstPtr));
+}
+
+TEST_F(VPUCommandTest, regionCopyCommandOutsideOfBufferIsRejected) {
+    const size_t width = 16, height = 8;
+    void *srcPtr = ctx->createSharedMemAlloc(width * height);
+    void *dstPtr = ctx->createSharedMemAlloc(width * height);
+
+    // Pitch moves last rows beyond the page backing the allocations
+    VPUCopyCommand::Region region = {0, 4096, 4096 * height};
+    EXPECT_TRUE(
+        VPUCopyCommand::createRegion(ctx, srcPtr, region, dstPtr, region, width, height, 1)
+            .empty());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(srcPtr));
+    EXPECT_TRUE(ctx->freeMemAlloc(dstPtr));
+}
+
 TEST_F(VPUCommandTest, graphInitCommandWithoutGraphShouldReturnExpectedProperties) {
     const size_t blobSize = 4 * 1024;
     uint8_t blobData[blobSize] = {};
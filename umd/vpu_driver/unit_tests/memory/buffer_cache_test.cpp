@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_buffer_cache.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+#include "gtest/gtest.h"
+
+using namespace VPU;
+
+struct VPUBufferCacheTest : public ::testing::Test {
+    void SetUp() {
+        VPUBufferCache::Limits limits;
+        limits.maxBytes = 4 * pageSize;
+        limits.maxBuffersPerSize = 2;
+        ctx->setBufferCacheLimits(limits);
+    }
+
+    void TearDown() { ASSERT_EQ(ctx->getBuffersCount(), 0u); }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::shared_ptr<VPUDeviceContext> ctx = vpuDevice->createDeviceContext();
+    const size_t pageSize = osInfc.osiGetSystemPageSize();
+};
+
+TEST_F(VPUBufferCacheTest, freedBufferIsReusedWithoutIoctl) {
+    void *ptr = ctx->createSharedMemAlloc(100);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(pageSize, ctx->findBuffer(ptr)->getAllocSize());
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+    EXPECT_EQ(1u, ctx->getBufferCache().getCachedCount());
+
+    osInfc.callCntIoctl = 0;
+    osInfc.callCntAlloc = 0;
+    osInfc.callCntFree = 0;
+
+    // Same type and page aligned size, different location
+    void *ptr2 = ctx->createDeviceMemAlloc(pageSize, VPUBufferObject::Type::CachedLow);
+    EXPECT_EQ(ptr, ptr2);
+    EXPECT_EQ(VPUBufferObject::Location::Device, ctx->findBuffer(ptr2)->getLocation());
+    EXPECT_EQ(0u, ctx->getBufferCache().getCachedCount());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr2));
+    EXPECT_EQ(0u, osInfc.callCntIoctl);
+    EXPECT_EQ(0u, osInfc.callCntAlloc);
+    EXPECT_EQ(0u, osInfc.callCntFree);
+}
+
+TEST_F(VPUBufferCacheTest, bufferOfDifferentTypeOrSizeIsNotReused) {
+    void *ptr = ctx->createSharedMemAlloc(pageSize);
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+
+    osInfc.callCntAlloc = 0;
+    void *ptr1 = ctx->createSharedMemAlloc(pageSize + 1);
+    void *ptr2 = ctx->createHostMemAlloc(pageSize);
+    EXPECT_EQ(2u, osInfc.callCntAlloc);
+    EXPECT_EQ(1u, ctx->getBufferCache().getCachedCount());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr1));
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr2));
+}
+
+TEST_F(VPUBufferCacheTest, cacheIsBoundedByLimits) {
+    std::vector<void *> ptrs;
+    for (int i = 0; i < 3; i++)
+        ptrs.push_back(ctx->createHostMemAlloc(pageSize));
+    ptrs.push_back(ctx->createHostMemAlloc(3 * pageSize));
+    ptrs.push_back(ctx->createHostMemAlloc(5 * pageSize));
+
+    osInfc.callCntFree = 0;
+    for (auto ptr : ptrs)
+        EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+
+    // Third page sized buffer exceeds per size limit, 5 page buffer exceeds the size limit,
+    // 3 page buffer pushes cache over the limit and evicts the oldest buffer
+    EXPECT_EQ(3u, osInfc.callCntFree);
+    EXPECT_EQ(2u, ctx->getBufferCache().getCachedCount());
+    EXPECT_EQ(4 * pageSize, ctx->getBufferCache().getCachedBytes());
+
+    EXPECT_EQ(4 * pageSize, ctx->trimBufferCache());
+    EXPECT_EQ(0u, ctx->getBufferCache().getCachedCount());
+    EXPECT_EQ(5u, osInfc.callCntFree);
+}
+
+TEST_F(VPUBufferCacheTest, cacheIsTrimmedOnAllocationFailure) {
+    void *ptr = ctx->createHostMemAlloc(pageSize);
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+    EXPECT_EQ(1u, ctx->getBufferCache().getCachedCount());
+
+    osInfc.mockFailNextAlloc();
+    ptr = ctx->createHostMemAlloc(2 * pageSize);
+    ASSERT_NE(nullptr, ptr);
+    EXPECT_EQ(0u, ctx->getBufferCache().getCachedCount());
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+}
+
+TEST_F(VPUBufferCacheTest, internalBuffersAreNotCached) {
+    auto bo = ctx->createInternalBufferObject(pageSize, VPUBufferObject::Type::CachedLow, false);
+    ASSERT_NE(nullptr, bo);
+    EXPECT_TRUE(ctx->freeMemAlloc(bo));
+    EXPECT_EQ(0u, ctx->getBufferCache().getCachedCount());
+}
+
+TEST_F(VPUBufferCacheTest, disabledCacheReleasesBuffers) {
+    ctx->setBufferCacheLimits({});
+    void *ptr = ctx->createHostMemAlloc(100);
+    EXPECT_EQ(100u, ctx->findBuffer(ptr)->getAllocSize());
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+    EXPECT_EQ(0u, ctx->getBufferCache().getCachedCount());
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_buffer_index.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace VPU;
+
+struct VPUBufferIndexTest : public ::testing::Test {
+    void TearDown() { ASSERT_EQ(ctx->getBuffersCount(), 0u); }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::shared_ptr<VPUDeviceContext> ctx = vpuDevice->createDeviceContext();
+};
+
+TEST_F(VPUBufferIndexTest, findReturnsOwnerOfWholePages) {
+    VPUBufferIndex index;
+    auto bo = VPUBufferObject::create(ctx->getDriverApi(),
+                                      VPUBufferObject::Location::Host,
+                                      VPUBufferObject::Type::CachedLow,
+                                      3 * 4096 + 100);
+    ASSERT_NE(nullptr, bo);
+    uint8_t *ptr = bo->getBasePointer();
+
+    EXPECT_EQ(nullptr, index.find(ptr));
+    EXPECT_TRUE(index.insert(bo.get()));
+    EXPECT_EQ(bo.get(), index.find(ptr));
+    EXPECT_EQ(bo.get(), index.find(ptr + 4096));
+    EXPECT_EQ(bo.get(), index.find(ptr + bo->getAllocSize() - 1));
+    EXPECT_EQ(nullptr, index.find(ptr - 1));
+    EXPECT_EQ(nullptr, index.find(ptr + 4 * 4096));
+
+    index.erase(bo.get());
+    EXPECT_EQ(nullptr, index.find(ptr));
+    EXPECT_EQ(nullptr, index.find(ptr + 4096));
+}
+
+TEST_F(VPUBufferIndexTest, subBuffersSharingPageAreDistinguished) {
+    VPUBufferIndex index;
+    auto parent = VPUBufferObject::create(ctx->getDriverApi(),
+                                          VPUBufferObject::Location::Internal,
+                                          VPUBufferObject::Type::CachedLow,
+                                          2 * 4096);
+    ASSERT_NE(nullptr, parent);
+    auto sub1 = VPUBufferObject::createSubBuffer(*parent, 0, 100);
+    auto sub2 = VPUBufferObject::createSubBuffer(*parent, 128, 64);
+    auto sub3 = VPUBufferObject::createSubBuffer(*parent, 4096, 4096);
+    EXPECT_TRUE(index.insert(sub1.get()));
+    EXPECT_TRUE(index.insert(sub2.get()));
+    EXPECT_TRUE(index.insert(sub3.get()));
+
+    uint8_t *ptr = parent->getBasePointer();
+    EXPECT_EQ(sub1.get(), index.find(ptr + 99));
+    EXPECT_EQ(sub2.get(), index.find(ptr + 128));
+    EXPECT_EQ(sub2.get(), index.find(ptr + 191));
+    EXPECT_EQ(nullptr, index.find(ptr + 192));
+    EXPECT_EQ(sub3.get(), index.find(ptr + 4096 + 4000));
+
+    index.erase(sub2.get());
+    EXPECT_EQ(nullptr, index.find(ptr + 128));
+    EXPECT_EQ(sub1.get(), index.find(ptr));
+
+    // Whole page buffer can reuse page split before into blocks
+    index.erase(sub1.get());
+    auto sub4 = VPUBufferObject::createSubBuffer(*parent, 0, 4096);
+    EXPECT_TRUE(index.insert(sub4.get()));
+    EXPECT_EQ(sub4.get(), index.find(ptr + 128));
+    EXPECT_EQ(sub4.get(), index.find(ptr + 4095));
+
+    index.erase(sub3.get());
+    index.erase(sub4.get());
+    EXPECT_EQ(nullptr, index.find(ptr));
+}
+
+TEST_F(VPUBufferIndexTest, DISABLED_lookupScalingBenchmark) {
+    const size_t allocCount = 10'000;
+    const size_t lookupCount = 1'000'000;
+
+    std::vector<uint8_t *> ptrs;
+    for (size_t i = 0; i < allocCount; i++) {
+        void *ptr = i % 2 ? ctx->createHostMemAlloc(4096)
+                          : ctx->createInternalBufferObject(256, VPUBufferObject::Type::CachedLow)
+                                ->getBasePointer();
+        ASSERT_NE(nullptr, ptr);
+        ptrs.push_back(static_cast<uint8_t *>(ptr));
+    }
+
+    for (size_t threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        std::atomic<size_t> found = 0;
+        std::vector<std::thread> threads;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threadCount; t++) {
+            threads.emplace_back([&, t] {
+                size_t localFound = 0;
+                for (size_t i = 0; i < lookupCount; i++) {
+                    const uint8_t *ptr = ptrs[(i * 7919 + t) % allocCount] + (i % 64);
+                    if (ctx->findBuffer(ptr) != nullptr)
+                        localFound++;
+                }
+                found += localFound;
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        auto end = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(threadCount * lookupCount, found.load());
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        printf("threads: %2zu, lookups: %9zu, time: %9.3f ms, throughput: %8.2f Mlookup/s\n",
+               threadCount,
+               threadCount * lookupCount,
+               static_cast<double>(ns) / 1e6,
+               static_cast<double>(threadCount * lookupCount) * 1e3 / static_cast<double>(ns));
+    }
+
+    for (auto ptr : ptrs)
+        EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+}
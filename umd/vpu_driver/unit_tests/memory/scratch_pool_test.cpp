@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_graph_init_command.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/memory/vpu_scratch_pool.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace VPU;
+
+struct VPUScratchPoolTest : public ::testing::Test {
+    void TearDown() {
+        // Idle regions are kept by the pool until the limit is lowered
+        ctx->setScratchPoolRegions(0);
+        ASSERT_EQ(ctx->getScratchRegionCount(), 0u);
+        ASSERT_EQ(ctx->getBuffersCount(), 0u);
+    }
+
+    std::shared_ptr<VPUGraphInitCommand> createGraph(size_t scratchSize) {
+        return VPUGraphInitCommand::create(ctx.get(),
+                                           nextBlobId++,
+                                           blob.data(),
+                                           blob.size(),
+                                           scratchSize,
+                                           pageSize);
+    }
+
+    /* Scratch heap follows the kernel heap in the associated buffer objects */
+    VPUBufferObject *getScratchHeap(const std::shared_ptr<VPUGraphInitCommand> &cmd) {
+        return cmd->getAssociateBufferObjects().at(1);
+    }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::shared_ptr<VPUDeviceContext> ctx = vpuDevice->createDeviceContext();
+    const size_t pageSize = osInfc.osiGetSystemPageSize();
+    std::vector<uint8_t> blob = std::vector<uint8_t>(pageSize, 0x5a);
+    uint64_t nextBlobId = 1;
+};
+
+TEST_F(VPUScratchPoolTest, poolIsDisabledByDefault) {
+    VPUScratchPool::Region region;
+    EXPECT_FALSE(ctx->acquireScratchRegion(pageSize, pageSize, region));
+
+    auto cmd1 = createGraph(pageSize);
+    auto cmd2 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    ASSERT_NE(cmd2, nullptr);
+    EXPECT_NE(getScratchHeap(cmd1), getScratchHeap(cmd2));
+    EXPECT_EQ(ctx->getScratchRegionCount(), 0u);
+}
+
+TEST_F(VPUScratchPoolTest, regionIsSharedByLiveGraphsAtLimit) {
+    ctx->setScratchPoolRegions(1);
+
+    auto cmd1 = createGraph(pageSize);
+    auto cmd2 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    ASSERT_NE(cmd2, nullptr);
+    EXPECT_EQ(getScratchHeap(cmd1), getScratchHeap(cmd2));
+    EXPECT_EQ(ctx->getScratchRegionCount(), 1u);
+}
+
+TEST_F(VPUScratchPoolTest, graphsAreSpreadOverRegions) {
+    ctx->setScratchPoolRegions(2);
+
+    auto cmd1 = createGraph(pageSize);
+    auto cmd2 = createGraph(pageSize);
+    auto cmd3 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    ASSERT_NE(cmd2, nullptr);
+    ASSERT_NE(cmd3, nullptr);
+    EXPECT_EQ(ctx->getScratchRegionCount(), 2u);
+    EXPECT_NE(getScratchHeap(cmd1), getScratchHeap(cmd2));
+    EXPECT_EQ(getScratchHeap(cmd1), getScratchHeap(cmd3));
+
+    VPUBufferObject *scratch = getScratchHeap(cmd2);
+    cmd2.reset();
+    EXPECT_EQ(ctx->getScratchRegionCount(), 2u);
+    EXPECT_EQ(scratch, ctx->findBuffer(scratch->getBasePointer()));
+
+    // Region without graphs is preferred
+    auto cmd4 = createGraph(pageSize);
+    ASSERT_NE(cmd4, nullptr);
+    EXPECT_EQ(scratch, getScratchHeap(cmd4));
+    EXPECT_EQ(ctx->getScratchRegionCount(), 2u);
+}
+
+TEST_F(VPUScratchPoolTest, buffersAreReleasedWhenGraphInitFails) {
+    ctx->setScratchPoolRegions(1);
+
+    auto cmd1 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    size_t bufferCount = ctx->getBuffersCount();
+
+    // Kernel heap and region are shared with the first graph, kernel data fails to allocate
+    std::vector<uint8_t> kernelData(pageSize, 0xa5);
+    osInfc.mockFailNextAlloc();
+    auto cmd2 = VPUGraphInitCommand::create(ctx.get(),
+                                            nextBlobId++,
+                                            blob.data(),
+                                            blob.size(),
+                                            pageSize,
+                                            pageSize,
+                                            kernelData.data(),
+                                            kernelData.size());
+    EXPECT_EQ(cmd2, nullptr);
+    EXPECT_EQ(ctx->getBuffersCount(), bufferCount);
+    EXPECT_EQ(ctx->getSharedBufferCount(), 1u);
+
+    // Kernel heap reference is dropped when private heaps fail to allocate
+    ctx->setScratchPoolRegions(0);
+    osInfc.mockFailNextAlloc();
+    EXPECT_EQ(createGraph(pageSize), nullptr);
+    EXPECT_EQ(ctx->getBuffersCount(), bufferCount);
+
+    cmd1.reset();
+    EXPECT_EQ(ctx->getSharedBufferCount(), 0u);
+}
+
+TEST_F(VPUScratchPoolTest, regionIsLeasedByOneJobUntilItCompletes) {
+    VPUScratchPool::Region region;
+    ctx->setScratchPoolRegions(1);
+    ASSERT_TRUE(ctx->acquireScratchRegion(pageSize, pageSize, region));
+
+    VPUScratchPool pool;
+    pool.setMaxRegions(1);
+    auto create = [&region](size_t, size_t, VPUScratchPool::Region &newRegion) {
+        newRegion = region;
+        return true;
+    };
+    VPUScratchPool::Region leasedRegion;
+    ASSERT_TRUE(pool.acquire(pageSize, pageSize, leasedRegion, create));
+
+    int job1 = 0, job2 = 0;
+    bool job1Completed = false;
+    auto isCompleted = [&](void *holder) {
+        EXPECT_EQ(holder, &job1);
+        return job1Completed;
+    };
+
+    std::vector<uint32_t> handles = {region.scratch->getHandle()};
+    EXPECT_TRUE(pool.lease(handles, &job1, isCompleted));
+    // Job is submitted again while it is in flight
+    EXPECT_TRUE(pool.lease(handles, &job1, isCompleted));
+    EXPECT_FALSE(pool.lease(handles, &job2, isCompleted));
+    EXPECT_TRUE(pool.lease({}, &job2, isCompleted));
+
+    job1Completed = true;
+    EXPECT_TRUE(pool.lease(handles, &job2, isCompleted));
+
+    // Lease of destroyed job ends without completion check
+    job1Completed = false;
+    pool.endLeases(&job2);
+    EXPECT_TRUE(pool.lease(handles, &job1, isCompleted));
+
+    bool removed = false;
+    EXPECT_TRUE(pool.release(leasedRegion, removed));
+    EXPECT_FALSE(removed);
+    EXPECT_TRUE(ctx->releaseScratchRegion(region));
+}
+
+TEST_F(VPUScratchPoolTest, graphNotFittingIdleRegionGetsPrivateHeaps) {
+    ctx->setScratchPoolRegions(1);
+
+    auto cmd1 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    VPUBufferObject *scratch = getScratchHeap(cmd1);
+    cmd1.reset();
+
+    auto cmd2 = createGraph(4 * pageSize);
+    auto cmd3 = createGraph(pageSize / 2);
+    ASSERT_NE(cmd2, nullptr);
+    ASSERT_NE(cmd3, nullptr);
+    EXPECT_EQ(ctx->getScratchRegionCount(), 1u);
+    EXPECT_NE(scratch, getScratchHeap(cmd2));
+    EXPECT_EQ(scratch, getScratchHeap(cmd3));
+}
+
+TEST_F(VPUScratchPoolTest, loweringLimitFreesIdleRegions) {
+    ctx->setScratchPoolRegions(2);
+
+    auto cmd1 = createGraph(pageSize);
+    auto cmd2 = createGraph(pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    ASSERT_NE(cmd2, nullptr);
+    cmd1.reset();
+    EXPECT_EQ(ctx->getScratchRegionCount(), 2u);
+
+    ctx->setScratchPoolRegions(0);
+    EXPECT_EQ(ctx->getScratchRegionCount(), 1u);
+    cmd2.reset();
+    EXPECT_EQ(ctx->getScratchRegionCount(), 0u);
+}
+
+TEST_F(VPUScratchPoolTest, jobWaitsForJobOfOtherGraphSharingRegion) {
+    ctx->setScratchPoolRegions(1);
+
+    std::vector<std::shared_ptr<VPUJob>> jobs;
+    for (int i = 0; i < 2; i++) {
+        auto job = std::make_shared<VPUJob>(ctx.get(), false);
+        ASSERT_TRUE(job->appendCommand(createGraph(pageSize)));
+        ASSERT_TRUE(job->closeCommands());
+        jobs.push_back(std::move(job));
+    }
+
+    ASSERT_TRUE(ctx->submitJob(jobs[0].get()));
+    // First job is reported in flight once, second one is submitted after it completes
+    osInfc.mockFailNextJobWait();
+    EXPECT_TRUE(ctx->submitJob(jobs[1].get()));
+    EXPECT_TRUE(jobs[0]->waitForCompletion(0));
+    EXPECT_TRUE(jobs[1]->waitForCompletion(0));
+}
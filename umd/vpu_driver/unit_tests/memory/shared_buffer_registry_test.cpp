@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_graph_init_command.hpp"
+#include "vpu_driver/source/memory/vpu_shared_buffer_registry.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace VPU;
+
+struct VPUSharedBufferRegistryTest : public ::testing::Test {
+    void TearDown() {
+        ASSERT_EQ(ctx->getSharedBufferCount(), 0u);
+        ASSERT_EQ(ctx->getBuffersCount(), 0u);
+    }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::shared_ptr<VPUDeviceContext> ctx = vpuDevice->createDeviceContext();
+    const size_t pageSize = osInfc.osiGetSystemPageSize();
+    const VPUBufferObject::Type highType = VPUBufferObject::Type::CachedHigh;
+    const VPUBufferObject::Type lowType = VPUBufferObject::Type::CachedLow;
+};
+
+TEST_F(VPUSharedBufferRegistryTest, sameContentIsSharedUntilLastRelease) {
+    std::vector<uint8_t> data(2 * pageSize, 0xab);
+    std::vector<uint8_t> copy = data;
+
+    auto *bo1 = ctx->acquireSharedBufferObject(data.data(), data.size(), highType);
+    ASSERT_NE(bo1, nullptr);
+    EXPECT_EQ(memcmp(bo1->getBasePointer(), data.data(), data.size()), 0);
+
+    osInfc.callCntAlloc = 0;
+    auto *bo2 = ctx->acquireSharedBufferObject(copy.data(), copy.size(), highType);
+    EXPECT_EQ(bo1, bo2);
+    EXPECT_EQ(0u, osInfc.callCntAlloc);
+    EXPECT_EQ(1u, ctx->getSharedBufferCount());
+
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo1));
+    EXPECT_EQ(bo2, ctx->findBuffer(bo2->getBasePointer()));
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo2));
+    EXPECT_FALSE(ctx->releaseSharedBufferObject(bo2));
+}
+
+TEST_F(VPUSharedBufferRegistryTest, differentContentOrTypeIsNotShared) {
+    std::vector<uint8_t> data1(pageSize, 1);
+    std::vector<uint8_t> data2(pageSize, 2);
+
+    auto *bo1 = ctx->acquireSharedBufferObject(data1.data(), data1.size(), highType);
+    auto *bo2 = ctx->acquireSharedBufferObject(data2.data(), data2.size(), highType);
+    auto *bo3 = ctx->acquireSharedBufferObject(data1.data(), data1.size(), lowType);
+    ASSERT_NE(bo1, nullptr);
+    ASSERT_NE(bo2, nullptr);
+    ASSERT_NE(bo3, nullptr);
+    EXPECT_NE(bo1, bo2);
+    EXPECT_NE(bo1, bo3);
+    EXPECT_EQ(3u, ctx->getSharedBufferCount());
+
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo1));
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo2));
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo3));
+}
+
+TEST_F(VPUSharedBufferRegistryTest, contentDifferingInLastByteIsNotShared) {
+    std::vector<uint8_t> data1(pageSize, 0xab);
+    std::vector<uint8_t> data2 = data1;
+    data2.back() = 0xac;
+
+    auto *bo1 = ctx->acquireSharedBufferObject(data1.data(), data1.size(), highType);
+    auto *bo2 = ctx->acquireSharedBufferObject(data2.data(), data2.size(), highType);
+    auto *bo3 = ctx->acquireSharedBufferObject(data2.data(), data2.size(), highType);
+    ASSERT_NE(bo1, nullptr);
+    ASSERT_NE(bo2, nullptr);
+    EXPECT_NE(bo1, bo2);
+    EXPECT_EQ(bo2, bo3);
+    EXPECT_EQ(memcmp(bo2->getBasePointer(), data2.data(), data2.size()), 0);
+    EXPECT_EQ(2u, ctx->getSharedBufferCount());
+
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo1));
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo2));
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo3));
+}
+
+TEST_F(VPUSharedBufferRegistryTest, notSharedBufferIsNotReleased) {
+    auto *bo = ctx->createInternalBufferObject(pageSize, highType);
+    ASSERT_NE(bo, nullptr);
+    EXPECT_FALSE(ctx->releaseSharedBufferObject(bo));
+    EXPECT_TRUE(ctx->freeMemAlloc(bo));
+}
+
+TEST_F(VPUSharedBufferRegistryTest, graphInitCommandsOfSameBlobShareKernelHeap) {
+    std::vector<uint8_t> blob(pageSize, 0x5a);
+
+    auto cmd1 =
+        VPUGraphInitCommand::create(ctx.get(), 1, blob.data(), blob.size(), pageSize, pageSize);
+    auto cmd2 =
+        VPUGraphInitCommand::create(ctx.get(), 2, blob.data(), blob.size(), pageSize, pageSize);
+    ASSERT_NE(cmd1, nullptr);
+    ASSERT_NE(cmd2, nullptr);
+    EXPECT_EQ(1u, ctx->getSharedBufferCount());
+
+    using InitCommand = vpu_cmd_ov_blob_initialize_t;
+    auto *initCmd1 = reinterpret_cast<const InitCommand *>(cmd1->getCommitStream());
+    auto *initCmd2 = reinterpret_cast<const InitCommand *>(cmd2->getCommitStream());
+    EXPECT_EQ(initCmd1->kernel_offset, initCmd2->kernel_offset);
+
+    cmd1.reset();
+    EXPECT_EQ(1u, ctx->getSharedBufferCount());
+    cmd2.reset();
+}
+
+TEST_F(VPUSharedBufferRegistryTest, concurrentRequestsOfSameContentCreateOneBuffer) {
+    std::vector<uint8_t> data(pageSize, 0xcd);
+    VPUSharedBufferRegistry registry;
+    std::atomic<int> createCount = 0;
+    std::atomic<bool> creating = false;
+
+    // Creation is slow, other requests come while the placeholder is registered
+    auto create = [&]() -> VPUBufferObject * {
+        createCount++;
+        creating = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto *bo = ctx->createInternalBufferObject(data.size(), highType);
+        EXPECT_TRUE(bo && bo->copyToBuffer(data.data(), data.size(), 0));
+        return bo;
+    };
+    auto acquire = [&]() {
+        return registry.acquire(data.data(), data.size(), highType, true, create);
+    };
+
+    VPUBufferObject *bo = nullptr;
+    std::thread creator([&] { bo = acquire(); });
+    while (!creating)
+        std::this_thread::yield();
+
+    std::vector<VPUBufferObject *> bos(4, nullptr);
+    std::vector<std::thread> threads;
+    for (auto &result : bos)
+        threads.emplace_back([&result, &acquire] { result = acquire(); });
+    for (auto &thread : threads)
+        thread.join();
+    creator.join();
+
+    ASSERT_NE(bo, nullptr);
+    EXPECT_EQ(1, createCount);
+    EXPECT_EQ(1u, registry.getCount());
+    for (auto *result : bos)
+        EXPECT_EQ(bo, result);
+
+    bool lastReference = false;
+    for (size_t i = 0; i < bos.size() + 1; i++)
+        EXPECT_TRUE(registry.release(bo, lastReference));
+    EXPECT_TRUE(lastReference);
+    EXPECT_TRUE(ctx->freeMemAlloc(bo));
+}
+
+TEST_F(VPUSharedBufferRegistryTest, failedCreationIsRetriedByNextRequest) {
+    std::vector<uint8_t> data(pageSize, 0xef);
+
+    osInfc.mockFailNextAlloc();
+    EXPECT_EQ(ctx->acquireSharedBufferObject(data.data(), data.size(), highType), nullptr);
+    EXPECT_EQ(0u, ctx->getSharedBufferCount());
+
+    auto *bo = ctx->acquireSharedBufferObject(data.data(), data.size(), highType);
+    ASSERT_NE(bo, nullptr);
+    EXPECT_EQ(1u, ctx->getSharedBufferCount());
+    EXPECT_TRUE(ctx->releaseSharedBufferObject(bo));
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/memory/vpu_slab_allocator.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
+#include "vpu_driver/unit_tests/mocks/mock_vpu_device.hpp"
+#include "gtest/gtest.h"
+
+using namespace VPU;
+
+struct VPUSlabAllocatorTest : public ::testing::Test {
+    void TearDown() { ASSERT_EQ(ctx->getBuffersCount(), 0u); }
+
+    MockOsInterfaceImp osInfc;
+    std::unique_ptr<MockVPUDevice> vpuDevice = MockVPUDevice::createWithDefaultHardwareInfo(osInfc);
+    std::shared_ptr<VPUDeviceContext> ctx = vpuDevice->createDeviceContext();
+};
+
+TEST_F(VPUSlabAllocatorTest, internalBuffersShareSlabHandle) {
+    osInfc.callCntIoctl = 0;
+
+    auto bo1 = ctx->createInternalBufferObject(100, VPUBufferObject::Type::CachedLow);
+    ASSERT_NE(nullptr, bo1);
+    // BO_CREATE and BO_INFO for slab
+    EXPECT_EQ(2u, osInfc.callCntIoctl);
+
+    auto bo2 = ctx->createInternalBufferObject(4000, VPUBufferObject::Type::CachedLow);
+    ASSERT_NE(nullptr, bo2);
+    EXPECT_EQ(2u, osInfc.callCntIoctl);
+    EXPECT_EQ(1u, ctx->getSlabCount());
+    EXPECT_EQ(2u, ctx->getBuffersCount());
+
+    EXPECT_NE(nullptr, bo1->getParent());
+    EXPECT_EQ(bo1->getParent(), bo2->getParent());
+    EXPECT_EQ(bo1->getHandle(), bo2->getHandle());
+    EXPECT_EQ(0u, bo1->getVPUAddr() % 64);
+    EXPECT_EQ(0u, bo2->getVPUAddr() % 64);
+    EXPECT_FALSE(bo1->isInRange(bo2->getBasePointer()));
+
+    EXPECT_EQ(bo2, ctx->findBuffer(bo2->getBasePointer() + 10));
+    EXPECT_EQ(bo2->getVPUAddr() + 10, ctx->getBufferVPUAddress(bo2->getBasePointer() + 10));
+
+    EXPECT_TRUE(ctx->freeMemAlloc(bo1));
+    EXPECT_TRUE(ctx->freeMemAlloc(bo2));
+    EXPECT_EQ(2u, osInfc.callCntIoctl);
+}
+
+TEST_F(VPUSlabAllocatorTest, slabIsCreatedPerBufferType) {
+    auto bo1 = ctx->createInternalBufferObject(64, VPUBufferObject::Type::CachedLow);
+    auto bo2 = ctx->createInternalBufferObject(64, VPUBufferObject::Type::WriteCombineHigh);
+    ASSERT_NE(nullptr, bo1);
+    ASSERT_NE(nullptr, bo2);
+    EXPECT_EQ(2u, ctx->getSlabCount());
+    EXPECT_NE(bo1->getParent(), bo2->getParent());
+    EXPECT_EQ(VPUBufferObject::Type::WriteCombineHigh, bo2->getType());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(bo1));
+    EXPECT_TRUE(ctx->freeMemAlloc(bo2));
+}
+
+TEST_F(VPUSlabAllocatorTest, freedBlockIsReusedAndZeroed) {
+    auto bo = ctx->createInternalBufferObject(256, VPUBufferObject::Type::CachedLow);
+    ASSERT_NE(nullptr, bo);
+    uint8_t *ptr = bo->getBasePointer();
+    memset(ptr, 0xde, 256);
+    EXPECT_TRUE(ctx->freeMemAlloc(ptr));
+
+    bo = ctx->createInternalBufferObject(256, VPUBufferObject::Type::CachedLow);
+    ASSERT_NE(nullptr, bo);
+    EXPECT_EQ(ptr, bo->getBasePointer());
+    for (size_t i = 0; i < 256; i++)
+        ASSERT_EQ(0u, ptr[i]);
+
+    EXPECT_TRUE(ctx->freeMemAlloc(bo));
+}
+
+TEST_F(VPUSlabAllocatorTest, fullSlabCausesNewSlabThatIsReleasedWhenEmpty) {
+    std::vector<VPUBufferObject *> bos;
+    size_t count = VPUSlabAllocator::slabSize / VPUSlabAllocator::maxBlockSize;
+    for (size_t i = 0; i < count; i++) {
+        bos.push_back(ctx->createInternalBufferObject(VPUSlabAllocator::maxBlockSize,
+                                                      VPUBufferObject::Type::CachedLow));
+        ASSERT_NE(nullptr, bos.back());
+    }
+    EXPECT_EQ(1u, ctx->getSlabCount());
+
+    auto extra = ctx->createInternalBufferObject(64, VPUBufferObject::Type::CachedLow);
+    ASSERT_NE(nullptr, extra);
+    EXPECT_EQ(2u, ctx->getSlabCount());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(extra));
+    EXPECT_EQ(1u, ctx->getSlabCount());
+
+    for (auto bo : bos)
+        EXPECT_TRUE(ctx->freeMemAlloc(bo));
+    EXPECT_EQ(1u, ctx->getSlabCount());
+}
+
+TEST_F(VPUSlabAllocatorTest, largeOrDedicatedBuffersAreNotSuballocated) {
+    auto bo1 = ctx->createInternalBufferObject(VPUSlabAllocator::maxBlockSize + 1,
+                                               VPUBufferObject::Type::CachedLow);
+    auto bo2 = ctx->createInternalBufferObject(64, VPUBufferObject::Type::CachedLow, false);
+    ASSERT_NE(nullptr, bo1);
+    ASSERT_NE(nullptr, bo2);
+    EXPECT_EQ(nullptr, bo1->getParent());
+    EXPECT_EQ(nullptr, bo2->getParent());
+    EXPECT_EQ(0u, ctx->getSlabCount());
+
+    EXPECT_TRUE(ctx->freeMemAlloc(bo1));
+    EXPECT_TRUE(ctx->freeMemAlloc(bo2));
+}
@@ -97,6 +97,7 @@ int MockOsInterfaceImp::osiIoctl(int fd, unsigned long request, void *data) {
         }
 
         auto *args = static_cast<struct drm_ivpu_bo_create *>(data);
+        args->handle = nextBufferHandle++;
         args->vpu_addr = deviceAddress;
         deviceAddress += ALIGN(args->size, osiGetSystemPageSize());
     } else if (request == DRM_IOCTL_IVPU_BO_INFO) {
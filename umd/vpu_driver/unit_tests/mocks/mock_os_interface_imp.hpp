@@ -39,6 +39,7 @@ class MockOsInterfaceImp : public OsInterface {
     const uint64_t deviceLowBaseAddress = 0xc000'0000;
     uint64_t deviceAddress = deviceLowBaseAddress;
     uint64_t unique_id = 0;
+    uint32_t nextBufferHandle = 1;
 
     int32_t kmdApiVersionMajor = DRM_IVPU_DRIVER_MAJOR;
     int32_t kmdApiVersionMinor = DRM_IVPU_DRIVER_MINOR;
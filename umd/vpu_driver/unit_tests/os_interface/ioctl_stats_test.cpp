@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <uapi/drm/ivpu_accel.h>
+
+using namespace VPU;
+
+struct VPUIoctlStatsTest : public ::testing::Test {
+    void SetUp() override { stats.reset(); }
+    void TearDown() override { stats.reset(); }
+
+    const VPUIoctlStats::Counters *find(const std::vector<VPUIoctlStats::Counters> &counters,
+                                        unsigned long request) {
+        for (const auto &c : counters) {
+            if (c.request == request)
+                return &c;
+        }
+        return nullptr;
+    }
+
+    VPUIoctlStats &stats = VPUIoctlStats::getInstance();
+};
+
+TEST_F(VPUIoctlStatsTest, latencyIsBucketedByPowerOfTwo) {
+    EXPECT_EQ(0u, VPUIoctlStats::getBucket(0));
+    EXPECT_EQ(0u, VPUIoctlStats::getBucket(1));
+    EXPECT_EQ(1u, VPUIoctlStats::getBucket(3));
+    EXPECT_EQ(10u, VPUIoctlStats::getBucket(1024));
+    EXPECT_EQ(10u, VPUIoctlStats::getBucket(2047));
+    EXPECT_EQ(VPUIoctlStats::histogramBuckets - 1, VPUIoctlStats::getBucket(UINT64_MAX));
+}
+
+TEST_F(VPUIoctlStatsTest, countersAreSummedOverThreads) {
+    auto recordSubmits = [this] {
+        for (int i = 0; i < 100; i++)
+            stats.record(DRM_IOCTL_IVPU_SUBMIT, 1000, i == 0 ? 2 : 0, i % 10 == 0);
+    };
+    std::thread t1(recordSubmits);
+    std::thread t2(recordSubmits);
+    t1.join();
+    t2.join();
+    stats.record(DRM_IOCTL_IVPU_BO_WAIT, 5000, 0, false);
+
+    auto counters = stats.getCounters();
+    ASSERT_EQ(2u, counters.size());
+
+    auto *submit = find(counters, DRM_IOCTL_IVPU_SUBMIT);
+    ASSERT_NE(nullptr, submit);
+    EXPECT_EQ(200u, submit->calls);
+    EXPECT_EQ(4u, submit->retries);
+    EXPECT_EQ(20u, submit->failures);
+    EXPECT_EQ(200'000u, submit->totalNs);
+    EXPECT_EQ(1000u, submit->maxNs);
+    EXPECT_EQ(200u, submit->histogram[VPUIoctlStats::getBucket(1000)]);
+
+    auto *wait = find(counters, DRM_IOCTL_IVPU_BO_WAIT);
+    ASSERT_NE(nullptr, wait);
+    EXPECT_EQ(1u, wait->calls);
+    EXPECT_EQ(5000u, wait->maxNs);
+}
+
+TEST_F(VPUIoctlStatsTest, resetClearsCountersAndReportNamesRequests) {
+    stats.record(DRM_IOCTL_IVPU_BO_CREATE, 100, 0, false);
+
+    std::string report = stats.getReport();
+    EXPECT_NE(std::string::npos, report.find("BO_CREATE"));
+
+    stats.reset();
+    EXPECT_TRUE(stats.getCounters().empty());
+    EXPECT_EQ(std::string::npos, stats.getReport().find("BO_CREATE"));
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/command/vpu_copy_command.hpp"
+#include "vpu_driver/source/command/vpu_event_command.hpp"
+#include "vpu_driver/source/command/vpu_job.hpp"
+#include "vpu_driver/source/command/vpu_memory_fill_command.hpp"
+#include "vpu_driver/source/command/vpu_ts_command.hpp"
+#include "vpu_driver/source/device/vpu_device.hpp"
+#include "vpu_driver/source/os_interface/os_interface_emulator.hpp"
+#include "vpu_driver/source/os_interface/vpu_device_factory.hpp"
+#include "vpu_driver/source/utilities/timer.hpp"
+
+#include <api/vpu_jsm_api.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace VPU;
+
+struct OsInterfaceEmulatorTest : public ::testing::Test {
+    void SetUp() override {
+        devices = DeviceFactory::createDevices(&emulator);
+        ASSERT_EQ(1u, devices.size());
+        deviceContext = devices[0]->createDeviceContext();
+        ASSERT_NE(nullptr, deviceContext);
+        ctx = deviceContext.get();
+    }
+
+    OsInterfaceEmulator emulator;
+    std::vector<std::unique_ptr<VPUDevice>> devices;
+    std::unique_ptr<VPUDeviceContext> deviceContext;
+    VPUDeviceContext *ctx = nullptr;
+
+    const int64_t timeoutNs = 5'000'000'000;
+    const size_t allocSize = 16 * 1024;
+};
+
+TEST_F(OsInterfaceEmulatorTest, emulatedDeviceReportsHardwareInfo) {
+    EXPECT_EQ(OsInterfaceEmulator::deviceId, devices[0]->getHwInfo().deviceId);
+    EXPECT_EQ(OsInterfaceEmulator::lowRangeBase, ctx->getVPULowBaseAddress());
+    EXPECT_EQ(0u, devices[0]->getCapMetricStreamer());
+}
+
+TEST_F(OsInterfaceEmulatorTest, fillCopyAndTimestampAreExecutedOnBothEngines) {
+    auto *src = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    auto *dst = static_cast<uint8_t *>(ctx->createSharedMemAlloc(allocSize));
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, src);
+    ASSERT_NE(nullptr, dst);
+    ASSERT_NE(nullptr, ts);
+
+    uint8_t pattern = 0xab;
+    auto job = std::make_unique<VPUJob>(ctx, false);
+    EXPECT_TRUE(job->appendCommand(
+        VPUMemoryFillCommand::create(ctx, src, &pattern, sizeof(pattern), allocSize)));
+    EXPECT_TRUE(job->appendCommand(VPUCopyCommand::create(ctx, src, dst, allocSize)));
+    EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, ts)));
+    EXPECT_TRUE(job->closeCommands());
+
+    EXPECT_TRUE(ctx->submitJob(job.get()));
+    EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_TRUE(job->isSuccess());
+
+    for (size_t i = 0; i < allocSize; i++)
+        ASSERT_EQ(pattern, dst[i]);
+    EXPECT_NE(0u, *ts);
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(src));
+    EXPECT_TRUE(ctx->freeMemAlloc(dst));
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+}
+
+TEST_F(OsInterfaceEmulatorTest, fenceWaitBlocksJobUntilHostSignal) {
+    auto *event =
+        static_cast<VPUEventCommand::KMDEventDataType *>(ctx->createSharedMemAlloc(allocSize));
+    ASSERT_NE(nullptr, event);
+    event[0] = VPUEventCommand::STATE_HOST_RESET;
+    event[1] = VPUEventCommand::STATE_EVENT_INITIAL;
+
+    auto job = std::make_unique<VPUJob>(ctx, false);
+    EXPECT_TRUE(job->appendCommand(VPUEventWaitCommand::create(ctx, &event[0])));
+    EXPECT_TRUE(job->appendCommand(VPUEventSignalCommand::create(ctx, &event[1])));
+    EXPECT_TRUE(job->closeCommands());
+    EXPECT_TRUE(ctx->submitJob(job.get()));
+
+    EXPECT_FALSE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(10'000'000)));
+    EXPECT_EQ(VPUEventCommand::STATE_EVENT_INITIAL, event[1]);
+
+    __atomic_store_n(&event[0], VPUEventCommand::STATE_HOST_SIGNAL, __ATOMIC_RELEASE);
+    EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_TRUE(job->isSuccess());
+    EXPECT_EQ(VPUEventCommand::STATE_DEVICE_SIGNAL, event[1]);
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(event));
+}
+
+TEST_F(OsInterfaceEmulatorTest, jobLatencyDelaysCompletion) {
+    OsInterfaceEmulator::LatencyModel latency;
+    latency.jobNs = 20'000'000;
+    emulator.setLatencyModel(latency);
+
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, ts);
+
+    auto job = std::make_unique<VPUJob>(ctx, true);
+    EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, ts)));
+    EXPECT_TRUE(job->closeCommands());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(ctx->submitJob(job.get()));
+    EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(latency.jobNs));
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+}
+
+TEST_F(OsInterfaceEmulatorTest, jobIsResubmittedFromManyThreadsWhileItIsWaitedFor) {
+    OsInterfaceEmulator::LatencyModel latency;
+    latency.jobNs = 2'000'000;
+    emulator.setLatencyModel(latency);
+
+    auto *ts = static_cast<uint64_t *>(ctx->createSharedMemAlloc(sizeof(uint64_t)));
+    ASSERT_NE(nullptr, ts);
+
+    auto job = std::make_unique<VPUJob>(ctx, true);
+    EXPECT_TRUE(job->appendCommand(VPUTimeStampCommand::create(ctx, ts)));
+    EXPECT_TRUE(job->closeCommands());
+
+    // Shadow instances are created while the waiter walks the instances of the job
+    std::atomic<bool> submitting = true;
+    std::thread waiter([&] {
+        while (submitting) {
+            job->waitForCompletion(0);
+            job->isSuccess();
+        }
+    });
+
+    std::vector<std::thread> submitters;
+    for (int i = 0; i < 2; i++) {
+        submitters.emplace_back([&] {
+            for (int j = 0; j < 10; j++) {
+                const std::lock_guard<std::mutex> lock(job->getSubmissionMutex());
+                ASSERT_TRUE(job->prepareSubmission());
+                ASSERT_TRUE(ctx->submitJob(job.get()));
+            }
+        });
+    }
+    for (auto &submitter : submitters)
+        submitter.join();
+    submitting = false;
+    waiter.join();
+
+    EXPECT_LT(1u, job->getInstanceCount());
+    EXPECT_GE(VPUJob::maxInstances, job->getInstanceCount());
+    EXPECT_TRUE(job->waitForCompletion(getAbsoluteTimeoutNanoseconds(timeoutNs)));
+    EXPECT_TRUE(job->isSuccess());
+
+    job.reset();
+    EXPECT_TRUE(ctx->freeMemAlloc(ts));
+}
+
+TEST_F(OsInterfaceEmulatorTest, failedJobStatusIsReportedForEveryBufferOfJob) {
+    void *cmd = ctx->createSharedMemAlloc(allocSize);
+    void *data = ctx->createSharedMemAlloc(allocSize);
+    ASSERT_NE(nullptr, cmd);
+    ASSERT_NE(nullptr, data);
+
+    // Single command of unknown type is rejected by emulated firmware
+    auto *bb = static_cast<vpu_cmd_buffer_header_t *>(cmd);
+    bb->cmd_offset = sizeof(vpu_cmd_buffer_header_t);
+    bb->cmd_buffer_size = bb->cmd_offset + sizeof(uint64_t);
+    auto *header =
+        reinterpret_cast<vpu_cmd_header_t *>(static_cast<uint8_t *>(cmd) + bb->cmd_offset);
+    header->type = 0xffff;
+    header->size = sizeof(uint64_t);
+
+    uint32_t handles[] = {ctx->findBuffer(cmd)->getHandle(), ctx->findBuffer(data)->getHandle()};
+    drm_ivpu_submit submit = {};
+    submit.buffers_ptr = reinterpret_cast<uint64_t>(handles);
+    submit.buffer_count = 2;
+    ASSERT_EQ(0, ctx->getDriverApi().submitCommandBuffer(&submit));
+
+    for (auto handle : handles) {
+        drm_ivpu_bo_wait wait = {};
+        wait.handle = handle;
+        wait.timeout_ns = getAbsoluteTimeoutNanoseconds(timeoutNs);
+        ASSERT_EQ(0, ctx->getDriverApi().wait(&wait));
+        EXPECT_EQ(VPU_JSM_STATUS_PARSING_ERR, wait.job_status);
+    }
+
+    EXPECT_TRUE(ctx->freeMemAlloc(cmd));
+    EXPECT_TRUE(ctx->freeMemAlloc(data));
+}
+
+TEST_F(OsInterfaceEmulatorTest, buffersAreReleasedWithDeviceContext) {
+    void *mem = ctx->createSharedMemAlloc(allocSize);
+    ASSERT_NE(nullptr, mem);
+    EXPECT_LT(0u, emulator.getBufferCount());
+
+    deviceContext.reset();
+    EXPECT_EQ(0u, emulator.getBufferCount());
+}
@@ -6,6 +6,7 @@
  */
 
 #include "vpu_driver/source/os_interface/vpu_driver_api.hpp"
+#include "vpu_driver/source/os_interface/vpu_ioctl_stats.hpp"
 #include "vpu_driver/unit_tests/mocks/mock_os_interface_imp.hpp"
 
 #include <memory>
@@ -87,3 +88,21 @@ TEST_F(VPUDriverApiIoctlTest, ioctlError) {
     struct drm_ivpu_bo_wait args = {};
     EXPECT_EQ(-1, driverApi->wait(&args));
 }
+
+TEST_F(VPUDriverApiIoctlTest, ioctlCallsAndFailuresAreRecordedInStats) {
+    auto &stats = VPUIoctlStats::getInstance();
+    stats.reset();
+
+    struct drm_ivpu_submit exec = {};
+    EXPECT_EQ(0, driverApi->submitCommandBuffer(&exec));
+    mockOsInfc.kmdIoctlRetCode = EINVAL;
+    EXPECT_EQ(-1, driverApi->submitCommandBuffer(&exec));
+
+    auto counters = stats.getCounters();
+    ASSERT_EQ(1u, counters.size());
+    EXPECT_EQ(DRM_IOCTL_IVPU_SUBMIT, counters[0].request);
+    EXPECT_EQ(2u, counters[0].calls);
+    EXPECT_EQ(1u, counters[0].failures);
+    EXPECT_EQ(0u, counters[0].retries);
+    stats.reset();
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/disk_cache.hpp"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdlib.h>
+
+using namespace VPU;
+
+struct VPUDiskCacheTest : public ::testing::Test {
+    void SetUp() override {
+        char tmpl[] = "/tmp/vpu_disk_cache_test.XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(tmpl));
+        directory = tmpl;
+    }
+
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    std::string directory;
+    std::vector<uint8_t> blob = std::vector<uint8_t>(1000, 0xab);
+};
+
+TEST_F(VPUDiskCacheTest, keyDependsOnEveryPart) {
+    std::string key = VPUDiskCache::Key().add("ab").add("c").str();
+    EXPECT_EQ(64u, key.size());
+    EXPECT_EQ(key, VPUDiskCache::Key().add("ab").add("c").str());
+    EXPECT_NE(key, VPUDiskCache::Key().add("a").add("bc").str());
+    EXPECT_NE(key, VPUDiskCache::Key().add("ab").add("c").add(uint64_t(1)).str());
+}
+
+TEST_F(VPUDiskCacheTest, storedBlobIsLoadedByNewInstance) {
+    std::string key = VPUDiskCache::Key().add(blob.data(), blob.size()).str();
+    std::vector<uint8_t> loaded;
+
+    VPUDiskCache cache(directory, 1 << 20);
+    EXPECT_FALSE(cache.load(key, loaded));
+    EXPECT_TRUE(cache.store(key, blob));
+
+    VPUDiskCache restarted(directory, 1 << 20);
+    EXPECT_TRUE(restarted.load(key, loaded));
+    EXPECT_EQ(blob, loaded);
+}
+
+TEST_F(VPUDiskCacheTest, corruptedEntryIsNotLoaded) {
+    VPUDiskCache cache(directory, 1 << 20);
+    EXPECT_TRUE(cache.store("entry", blob));
+
+    std::fstream file(directory + "/entry.blob", std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-1, std::ios::end);
+    file.put(0);
+    file.close();
+
+    std::vector<uint8_t> loaded;
+    EXPECT_FALSE(cache.load("entry", loaded));
+}
+
+TEST_F(VPUDiskCacheTest, leastRecentlyUsedEntryIsRemovedAboveLimit) {
+    VPUDiskCache cache(directory, 2 * blob.size() + 200);
+    EXPECT_TRUE(cache.store("first", blob));
+    EXPECT_TRUE(cache.store("second", blob));
+
+    // Make the first entry the oldest one, then use it
+    auto old = std::filesystem::file_time_type::clock::now() - std::chrono::hours(2);
+    std::filesystem::last_write_time(directory + "/first.blob", old);
+    std::filesystem::last_write_time(directory + "/second.blob", old + std::chrono::hours(1));
+    std::vector<uint8_t> loaded;
+    EXPECT_TRUE(cache.load("first", loaded));
+
+    EXPECT_TRUE(cache.store("third", blob));
+    EXPECT_LE(cache.getCachedBytes(), 2 * blob.size() + 200);
+    EXPECT_TRUE(cache.load("first", loaded));
+    EXPECT_FALSE(cache.load("second", loaded));
+    EXPECT_TRUE(cache.load("third", loaded));
+}
+
+TEST_F(VPUDiskCacheTest, blobAboveLimitIsNotStored) {
+    VPUDiskCache cache(directory, blob.size());
+    EXPECT_FALSE(cache.store("entry", blob));
+    EXPECT_EQ(0u, cache.getCachedBytes());
+}
+
+TEST_F(VPUDiskCacheTest, entryStoredUnderOtherKeyIsNotLoaded) {
+    VPUDiskCache cache(directory, 1 << 20);
+    EXPECT_TRUE(cache.store("first", blob));
+    std::filesystem::rename(directory + "/first.blob", directory + "/second.blob");
+
+    std::vector<uint8_t> loaded;
+    EXPECT_FALSE(cache.load("second", loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(VPUDiskCacheTest, entrySizeIsCheckedAgainstFileSize) {
+    VPUDiskCache cache(directory, 1 << 20);
+    EXPECT_TRUE(cache.store("entry", blob));
+
+    // Size field follows magic and version in the header
+    uint64_t hugeSize = 1ull << 60;
+    std::fstream file(directory + "/entry.blob", std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(2 * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char *>(&hugeSize), sizeof(hugeSize));
+    file.close();
+
+    std::vector<uint8_t> loaded;
+    EXPECT_FALSE(cache.load("entry", loaded));
+    EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(VPUDiskCacheTest, staleTemporaryFilesAreRemovedOnTrim) {
+    VPUDiskCache cache(directory, 1 << 20);
+    EXPECT_TRUE(cache.store("entry", blob));
+
+    std::string stale = directory + "/.crashed.AbCdEf";
+    std::string fresh = directory + "/.writing.AbCdEf";
+    std::ofstream(stale) << "partial";
+    std::ofstream(fresh) << "partial";
+    auto old = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+    std::filesystem::last_write_time(stale, old);
+
+    EXPECT_EQ(0u, cache.trim(1 << 20));
+    EXPECT_FALSE(std::filesystem::exists(stale));
+    EXPECT_TRUE(std::filesystem::exists(fresh));
+    EXPECT_TRUE(std::filesystem::exists(directory + "/entry.blob"));
+}
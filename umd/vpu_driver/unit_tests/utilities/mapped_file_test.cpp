@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/mapped_file.hpp"
+#include "gtest/gtest.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+using namespace VPU;
+
+struct VPUMappedFileTest : public ::testing::Test {
+    void SetUp() override {
+        char tmpl[] = "/tmp/vpu_mapped_file_test.XXXXXX";
+        fd = mkstemp(tmpl);
+        ASSERT_GE(fd, 0);
+        path = tmpl;
+        ASSERT_EQ(static_cast<ssize_t>(sizeof(content)), write(fd, content, sizeof(content)));
+    }
+
+    void TearDown() override {
+        close(fd);
+        unlink(path.c_str());
+    }
+
+    int fd = -1;
+    std::string path;
+    const char content[16] = "graph blob data";
+};
+
+TEST_F(VPUMappedFileTest, fileIsMappedByPathAndDescriptor) {
+    auto file = VPUMappedFile::open(path.c_str());
+    ASSERT_NE(nullptr, file);
+    EXPECT_EQ(sizeof(content), file->size());
+    EXPECT_EQ(0, memcmp(content, file->data(), sizeof(content)));
+
+    file = VPUMappedFile::map(fd);
+    ASSERT_NE(nullptr, file);
+
+    // Mapping outlives the descriptor
+    close(fd);
+    fd = -1;
+    EXPECT_EQ(0, memcmp(content, file->data(), sizeof(content)));
+}
+
+TEST_F(VPUMappedFileTest, invalidFileIsNotMapped) {
+    EXPECT_EQ(nullptr, VPUMappedFile::open(nullptr));
+    EXPECT_EQ(nullptr, VPUMappedFile::open("/nonexistent/graph.blob"));
+    EXPECT_EQ(nullptr, VPUMappedFile::map(-1));
+    EXPECT_EQ(nullptr, VPUMappedFile::open("/tmp"));
+
+    ASSERT_EQ(0, ftruncate(fd, 0));
+    EXPECT_EQ(nullptr, VPUMappedFile::map(fd));
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/sha256.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace VPU;
+
+static std::string sha256Hex(const std::string &message) {
+    return VPUSha256::toHex(VPUSha256::hash(message.data(), message.size()));
+}
+
+TEST(VPUSha256Test, digestMatchesKnownVectors) {
+    EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", sha256Hex(""));
+    EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+              sha256Hex("abc"));
+    EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+              sha256Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+}
+
+TEST(VPUSha256Test, incrementalUpdateMatchesSingleUpdate) {
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<uint8_t>(i * 7);
+
+    VPUSha256 sha;
+    for (size_t offset = 0; offset < data.size(); offset += 37)
+        sha.update(data.data() + offset, std::min<size_t>(37, data.size() - offset));
+    EXPECT_EQ(VPUSha256::hash(data.data(), data.size()), sha.digest());
+
+    // Digest does not finish the hash, more data can follow
+    sha.update("x", 1);
+    EXPECT_NE(VPUSha256::hash(data.data(), data.size()), sha.digest());
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/thread_pool.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+using namespace VPU;
+
+TEST(VPUThreadPoolTest, taskResultIsReturnedByFuture) {
+    VPUThreadPool pool(2);
+    EXPECT_EQ(0u, pool.getThreadCount());
+
+    auto future = pool.submit([] { return 42; });
+    EXPECT_EQ(42, future.get());
+    EXPECT_EQ(1u, pool.getThreadCount());
+}
+
+TEST(VPUThreadPoolTest, tasksAreExecutedInParallelUpToThreadLimit) {
+    VPUThreadPool pool(2);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> started = 0;
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 3; i++) {
+        futures.push_back(pool.submit([&, released] {
+            started++;
+            released.wait();
+        }));
+    }
+
+    while (started < 2)
+        std::this_thread::yield();
+    EXPECT_EQ(2u, pool.getThreadCount());
+    EXPECT_EQ(std::future_status::timeout, futures[2].wait_for(std::chrono::milliseconds(10)));
+
+    release.set_value();
+    for (auto &future : futures)
+        future.wait();
+    EXPECT_EQ(3, started);
+}
+
+TEST(VPUThreadPoolTest, queuedTasksAreCompletedOnDestruction) {
+    std::atomic<int> completed = 0;
+    {
+        VPUThreadPool pool(1);
+        for (int i = 0; i < 8; i++)
+            pool.submit([&] { completed++; });
+    }
+    EXPECT_EQ(8, completed);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/timer.hpp"
+#include "gtest/gtest.h"
+
+using namespace VPU;
+
+TEST(WaitForSignalTest, blockFunctionIsUsedWhileItBlocks) {
+    WaitPolicy policy;
+    policy.spinTimeNs = 0;
+
+    size_t blockCalls = 0;
+    EXPECT_TRUE(waitForSignal(
+        std::numeric_limits<uint64_t>::max(),
+        [&blockCalls]() { return blockCalls == 3; },
+        policy,
+        nullptr,
+        [&blockCalls](int64_t) {
+            blockCalls++;
+            return true;
+        }));
+    EXPECT_EQ(3u, blockCalls);
+}
+
+TEST(WaitForSignalTest, waitSleepsWhenBlockFunctionDoesNotBlock) {
+    WaitPolicy policy;
+    policy.spinTimeNs = 0;
+    policy.minSleepNs = 1'000'000;
+    policy.maxSleepNs = 1'000'000;
+
+    size_t blockCalls = 0;
+    WaitStatistics stats;
+    EXPECT_FALSE(waitForSignal(
+        20'000'000,
+        []() { return false; },
+        policy,
+        &stats,
+        [&blockCalls](int64_t) {
+            blockCalls++;
+            return false;
+        }));
+
+    // Block function is not polled again, remaining time is spent sleeping
+    EXPECT_EQ(1u, blockCalls);
+    EXPECT_EQ(1u, stats.getWaitCount());
+    EXPECT_LT(stats.getCpuTimeNs(), stats.getWallTimeNs() / 2);
+}
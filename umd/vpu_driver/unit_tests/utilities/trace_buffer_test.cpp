@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ */
+
+#include "vpu_driver/source/utilities/log.hpp"
+#include "vpu_driver/source/utilities/trace_buffer.hpp"
+#include "gtest/gtest.h"
+
+#include <thread>
+
+using namespace VPU;
+
+struct TraceBufferTest : public ::testing::Test {
+    void SetUp() override {
+        logLevel = getLogLevel();
+        setLogLevel(QUIET);
+        setTraceLevel(INFO);
+        trace.clear();
+    }
+
+    void TearDown() override {
+        setTraceLevel(QUIET);
+        setLogLevel(logLevel);
+    }
+
+    TraceBuffer &trace = TraceBuffer::getInstance();
+    LogLevel logLevel = QUIET;
+};
+
+TEST_F(TraceBufferTest, messagesAboveTraceLevelAreNotRecorded) {
+    LOG_V("verbose %d", 1);
+    LOG_I("info %d", 2);
+    setTraceLevel(QUIET);
+    LOG_E("error %d", 3);
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ(INFO, records[0].callsite->level);
+    EXPECT_EQ("info 2", TraceBuffer::formatMessage(records[0]));
+}
+
+TEST_F(TraceBufferTest, argumentsAreFormattedWhenDumped) {
+    int value = -5;
+    void *ptr = reinterpret_cast<void *>(0x1000);
+    LOG_I("%d %u %#lx %zu %p %s %.2f %5.3s|%%",
+          value,
+          7u,
+          0xabcdUL,
+          sizeof(uint64_t),
+          ptr,
+          "name",
+          1.5,
+          "abcdef");
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ("-5 7 0xabcd 8 0x1000 name 1.50   abc|%",
+              TraceBuffer::formatMessage(records[0]));
+    EXPECT_NE(std::string::npos, TraceBuffer::format(records[0]).find("trace_buffer_test.cpp"));
+}
+
+TEST_F(TraceBufferTest, stringsAreCopiedAndTruncated) {
+    char name[] = "first";
+    std::string longName(TraceBuffer::stringPoolSize * 2, 'a');
+    LOG_I("%s %s %s", name, longName.c_str(), "last");
+    name[0] = 'F';
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(1u, records.size());
+    std::string expected =
+        "first " + std::string(TraceBuffer::stringPoolSize - sizeof("first") - 1, 'a') + " ";
+    EXPECT_EQ(expected, TraceBuffer::formatMessage(records[0]));
+}
+
+TEST_F(TraceBufferTest, oldestRecordsAreOverwrittenWhenRingIsFull) {
+    // Run on a new thread to get a ring without records of other tests
+    std::thread([] {
+        for (size_t i = 0; i < TraceBuffer::ringCapacity + 10; i++)
+            LOG_I("record %zu", i);
+    }).join();
+
+    auto records = trace.getRecords();
+    // Slot that could be in use by the writer is never returned
+    ASSERT_EQ(TraceBuffer::ringCapacity - 1, records.size());
+    EXPECT_EQ("record 11", TraceBuffer::formatMessage(records.front()));
+    EXPECT_EQ("record " + std::to_string(TraceBuffer::ringCapacity + 9),
+              TraceBuffer::formatMessage(records.back()));
+}
+
+TEST_F(TraceBufferTest, argumentsAboveLimitAreNotFormatted) {
+    LOG_I("%d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9);
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ("1 2 3 4 5 6 7 8 <?>", TraceBuffer::formatMessage(records[0]));
+}
+
+TEST_F(TraceBufferTest, recordsOfAllThreadsAreOrderedByTime) {
+    LOG_I("main %d", 0);
+    std::thread([] { LOG_I("worker %d", 1); }).join();
+    LOG_I("main %d", 2);
+
+    auto records = trace.getRecords();
+    ASSERT_EQ(3u, records.size());
+    EXPECT_EQ("main 0", TraceBuffer::formatMessage(records[0]));
+    EXPECT_EQ("worker 1", TraceBuffer::formatMessage(records[1]));
+    EXPECT_EQ("main 2", TraceBuffer::formatMessage(records[2]));
+    EXPECT_NE(records[0].tid, records[1].tid);
+    EXPECT_EQ(records[0].tid, records[2].tid);
+}